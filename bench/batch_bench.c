@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Benchmark: batch execution of a codeblock over many input records
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/utils.h"
+#include "../src/codeblock.h"
+#include "../src/program.h"
+#include "../src/worker_pool.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+static const char* const BENCH_SOURCE =
+    "|price, quantity| price * quantity > 100 and quantity < 50,";
+
+static const size_t BENCH_RECORD_COUNT = 1000000;
+
+/* records per batch, if the records are split into many small batches */
+static const size_t BENCH_SMALL_BATCH_SIZE = 1000;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Execute the program for all records using a specific number of threads,
+ * either in a single batch or in many small batches.
+ */
+static void batch_bench_run(CbCodeblockEngine engine,
+                            const char* engine_name,
+                            size_t thread_count,
+                            size_t batch_size,
+                            const CbVariant* inputs,
+                            CbVariant* results);
+
+
+/* -------------------------------------------------------------------------- */
+
+void batch_bench()
+{
+    const size_t THREAD_COUNTS[] = { 1, 2, 4, 8, 0 };
+    const size_t* threads;
+    size_t i;
+    CbVariant* inputs  = memalloc(2 * BENCH_RECORD_COUNT * sizeof(CbVariant));
+    CbVariant* results = memalloc(BENCH_RECORD_COUNT * sizeof(CbVariant));
+    
+    for (i = 0; i < BENCH_RECORD_COUNT; i++)
+    {
+        inputs[i * 2]     = cb_integer_make(i % 1000); /* price    */
+        inputs[i * 2 + 1] = cb_integer_make(i % 100);  /* quantity */
+    }
+    
+    for (threads = THREAD_COUNTS; *threads > 0; threads++)
+    {
+        batch_bench_run(CB_CODEBLOCK_ENGINE_AST, "ast", *threads,
+                        BENCH_RECORD_COUNT, inputs, results);
+        batch_bench_run(CB_CODEBLOCK_ENGINE_VM, "vm", *threads,
+                        BENCH_RECORD_COUNT, inputs, results);
+    }
+    
+    for (threads = THREAD_COUNTS; *threads > 0; threads++)
+        batch_bench_run(CB_CODEBLOCK_ENGINE_VM, "vm", *threads,
+                        BENCH_SMALL_BATCH_SIZE, inputs, results);
+    
+    memfree(inputs);
+    memfree(results);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void batch_bench_run(CbCodeblockEngine engine,
+                            const char* engine_name,
+                            size_t thread_count,
+                            size_t batch_size,
+                            const CbVariant* inputs,
+                            CbVariant* results)
+{
+    const char* const INPUT_NAMES[] = { "price", "quantity" };
+    char name[64];
+    size_t i;
+    size_t slots[2];
+    double start;
+    CbProgram* program;
+    CbWorkerPool* workers = NULL;
+    CbCodeblock* cb       = cb_codeblock_create();
+    
+    cb_codeblock_set_engine(cb, engine);
+    if (!cb_codeblock_parse_string(cb, BENCH_SOURCE))
+        exit(EXIT_FAILURE);
+    
+    program = cb_codeblock_compile(cb);
+    if (program == NULL ||
+        !cb_program_lookup_variable(program, INPUT_NAMES[0], &slots[0]) ||
+        !cb_program_lookup_variable(program, INPUT_NAMES[1], &slots[1]))
+        exit(EXIT_FAILURE);
+    
+    /* the threads are started once for all batches */
+    if (thread_count > 1)
+        workers = cb_worker_pool_create(thread_count);
+    
+    start = bench_now();
+    for (i = 0; i < BENCH_RECORD_COUNT; i += batch_size)
+    {
+        if (!cb_program_execute_batch(program, slots, 2, &inputs[i * 2],
+                                      batch_size, &results[i], workers))
+            exit(EXIT_FAILURE);
+    }
+    
+    sprintf(name, "batch (%s, %lu threads, %lu records)", engine_name,
+            (unsigned long) thread_count, (unsigned long) batch_size);
+    bench_report(name, BENCH_RECORD_COUNT, bench_now() - start);
+    
+    for (i = 0; i < BENCH_RECORD_COUNT; i++)
+        cb_variant_release(&results[i]);
+    
+    if (workers != NULL)
+        cb_worker_pool_destroy(workers);
+    cb_program_destroy(program);
+    cb_codeblock_destroy(cb);
+}
@@ -0,0 +1,72 @@
+/* clock_gettime() is POSIX */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/error_handling.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+typedef struct Benchmark
+{
+    const char* name;
+    void (*run)();
+} Benchmark;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Usage: cbc_bench [name]
+ * Runs all benchmarks or only the benchmark with the given name.
+ */
+int main(int argc, char* argv[])
+{
+    const Benchmark benchmarks[] = {
+        { "program",    program_bench    },
+        { "batch",      batch_bench      },
+        { "columnar",   columnar_bench   },
+        { "hash_table", hash_table_bench },
+        { "logical",    logical_bench    },
+        { "string",     string_bench     },
+        { "mempool",    mempool_bench    },
+        { "vector",     vector_bench     },
+        { "scope",      scope_bench      },
+        { NULL,         NULL             }
+    };
+    const Benchmark* benchmark;
+    
+    cb_error_initialize(stderr);
+    
+    for (benchmark = benchmarks; benchmark->name != NULL; benchmark++)
+    {
+        if (argc > 1 && strcmp(argv[1], benchmark->name) != 0)
+            continue;
+        
+        printf("[%s]\n", benchmark->name);
+        benchmark->run();
+    }
+    
+    cb_error_finalize();
+    
+    return 0;
+}
+
+double bench_now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+
+void bench_report(const char* name, size_t iterations, double seconds)
+{
+    printf("  %-40s %12.1f ns/op %14.0f op/s\n",
+           name,
+           seconds * 1e9 / (double) iterations,
+           (double) iterations / seconds);
+}
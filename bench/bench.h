@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * Micro benchmarks for cbc
+ ******************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Get a monotonic timestamp in seconds.
+ */
+double bench_now();
+
+/*
+ * Print the result of a benchmark (time per iteration and iterations per
+ * second).
+ */
+void bench_report(const char* name, size_t iterations, double seconds);
+
+
+/* -------------------------------------------------------------------------- */
+
+void program_bench();
+void batch_bench();
+void columnar_bench();
+void hash_table_bench();
+void logical_bench();
+void string_bench();
+void mempool_bench();
+void vector_bench();
+void scope_bench();
+
+
+#endif /* BENCH_H */
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Benchmark: columnar evaluation compared to the row by row evaluation
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/utils.h"
+#include "../src/codeblock.h"
+#include "../src/program.h"
+#include "../src/columnar.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+static const char* const BENCH_SOURCE =
+    "|price, quantity| price * quantity > 100 and quantity < 50,";
+
+static const size_t BENCH_ROW_COUNT = 1000000;
+
+
+/* -------------------------------------------------------------------------- */
+
+void columnar_bench()
+{
+    const char* const INPUT_NAMES[] = { "price", "quantity" };
+    size_t i;
+    size_t slots[2];
+    double start;
+    CbColumn columns[2];
+    CbProgram* program;
+    CbColumnarProgram* columnar;
+    CbCodeblock* cb = cb_codeblock_create();
+    CbIntegerDataType* price    = memalloc(BENCH_ROW_COUNT *
+                                           sizeof(CbIntegerDataType));
+    CbIntegerDataType* quantity = memalloc(BENCH_ROW_COUNT *
+                                           sizeof(CbIntegerDataType));
+    CbVariant* inputs  = memalloc(2 * BENCH_ROW_COUNT * sizeof(CbVariant));
+    CbVariant* results = memalloc(BENCH_ROW_COUNT * sizeof(CbVariant));
+    
+    for (i = 0; i < BENCH_ROW_COUNT; i++)
+    {
+        price[i]          = i % 1000;
+        quantity[i]       = i % 100;
+        inputs[i * 2]     = cb_integer_make(price[i]);
+        inputs[i * 2 + 1] = cb_integer_make(quantity[i]);
+    }
+    columns[0] = cb_integer_column(price);
+    columns[1] = cb_integer_column(quantity);
+    
+    cb_codeblock_set_engine(cb, CB_CODEBLOCK_ENGINE_VM);
+    if (!cb_codeblock_parse_string(cb, BENCH_SOURCE))
+        exit(EXIT_FAILURE);
+    
+    program = cb_codeblock_compile(cb);
+    if (program == NULL ||
+        !cb_program_lookup_variable(program, INPUT_NAMES[0], &slots[0]) ||
+        !cb_program_lookup_variable(program, INPUT_NAMES[1], &slots[1]))
+        exit(EXIT_FAILURE);
+    
+    /* row by row (fastest engine, single thread) */
+    start = bench_now();
+    if (!cb_program_execute_batch(program, slots, 2, inputs, BENCH_ROW_COUNT,
+                                  results, NULL))
+        exit(EXIT_FAILURE);
+    bench_report("rows (vm)", BENCH_ROW_COUNT, bench_now() - start);
+    
+    for (i = 0; i < BENCH_ROW_COUNT; i++)
+        cb_variant_release(&results[i]);
+    
+    /* column by column */
+    columnar = cb_columnar_program_create(program);
+    if (columnar == NULL)
+        exit(EXIT_FAILURE);
+    
+    start = bench_now();
+    if (!cb_columnar_program_execute(columnar, slots, columns, 2,
+                                     BENCH_ROW_COUNT, results))
+        exit(EXIT_FAILURE);
+    bench_report("columnar", BENCH_ROW_COUNT, bench_now() - start);
+    
+    for (i = 0; i < BENCH_ROW_COUNT; i++)
+        cb_variant_release(&results[i]);
+    
+    cb_columnar_program_destroy(columnar);
+    cb_program_destroy(program);
+    cb_codeblock_destroy(cb);
+    memfree(price);
+    memfree(quantity);
+    memfree(inputs);
+    memfree(results);
+}
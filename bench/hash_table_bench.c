@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Benchmark: insertion and lookup of CbHashTable
+ ******************************************************************************/
+
+#include <stdio.h>
+
+#include "../src/utils.h"
+#include "../src/hash_table.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+static const size_t BENCH_KEY_COUNT     = 100000;
+static const size_t BENCH_LOOKUP_ROUNDS = 10;
+
+#define BENCH_KEY_LENGTH 16
+
+
+/* -------------------------------------------------------------------------- */
+
+void hash_table_bench()
+{
+    size_t i;
+    size_t k;
+    size_t found = 0;
+    double start;
+    CbHashTable* ht;
+    char (*keys)[BENCH_KEY_LENGTH]   = memalloc(BENCH_KEY_COUNT *
+                                                BENCH_KEY_LENGTH);
+    char (*misses)[BENCH_KEY_LENGTH] = memalloc(BENCH_KEY_COUNT *
+                                                BENCH_KEY_LENGTH);
+    
+    /* identifier like keys, many of them are anagrams of each other */
+    for (i = 0; i < BENCH_KEY_COUNT; i++)
+    {
+        sprintf(keys[i], "var_%lu", (unsigned long) i);
+        sprintf(misses[i], "tmp_%lu", (unsigned long) i);
+    }
+    
+    /* insert (starting with the default scope size) */
+    ht    = cb_hash_table_create(16, NULL, NULL);
+    start = bench_now();
+    for (i = 0; i < BENCH_KEY_COUNT; i++)
+        cb_hash_table_insert(ht, keys[i], keys[i]);
+    bench_report("insert", BENCH_KEY_COUNT, bench_now() - start);
+    
+    /* successful lookup */
+    start = bench_now();
+    for (k = 0; k < BENCH_LOOKUP_ROUNDS; k++)
+    {
+        for (i = 0; i < BENCH_KEY_COUNT; i++)
+            found += cb_hash_table_get(ht, keys[i]) != NULL;
+    }
+    bench_report("lookup (hit)", BENCH_KEY_COUNT * BENCH_LOOKUP_ROUNDS,
+                 bench_now() - start);
+    
+    /* unsuccessful lookup */
+    start = bench_now();
+    for (k = 0; k < BENCH_LOOKUP_ROUNDS; k++)
+    {
+        for (i = 0; i < BENCH_KEY_COUNT; i++)
+            found += cb_hash_table_get(ht, misses[i]) != NULL;
+    }
+    bench_report("lookup (miss)", BENCH_KEY_COUNT * BENCH_LOOKUP_ROUNDS,
+                 bench_now() - start);
+    
+    /* remove */
+    start = bench_now();
+    for (i = 0; i < BENCH_KEY_COUNT; i++)
+        cb_hash_table_remove(ht, keys[i]);
+    bench_report("remove", BENCH_KEY_COUNT, bench_now() - start);
+    
+    if (found != BENCH_KEY_COUNT * BENCH_LOOKUP_ROUNDS)
+        printf("  unexpected number of hits: %lu\n", (unsigned long) found);
+    
+    cb_hash_table_destroy(ht);
+    memfree(keys);
+    memfree(misses);
+}
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Benchmark: short-circuit evaluation of guard-heavy rules
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/codeblock.h"
+#include "../src/program.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Each rule consists of a cheap guard, that rarely holds, and an expensive
+ * condition, that only needs to be evaluated if the guard holds.
+ */
+static const char* const BENCH_SOURCE =
+    "|i, hits| i := 0, hits := 0, "
+    "while i < 1000 do "
+        "if i > 990 and (i * i + 3 * i) / 7 - (i * 5) / 3 > 100 then "
+            "hits := hits + 1, "
+        "endif, "
+        "if i = 500 or ((i * 7 + 3) / 2 - (i * 5) / 3) * 2 > 1000000 then "
+            "hits := hits + 1, "
+        "endif, "
+        "if i < 10 and (i * i * i) / 11 + (i * i) / 13 > 2 then "
+            "hits := hits + 1, "
+        "endif, "
+        "i := i + 1, "
+    "end, "
+    "hits,";
+
+static const size_t BENCH_ITERATIONS = 200;
+
+/* iterations of the while loop in BENCH_SOURCE */
+static const size_t BENCH_LOOP_ITERATIONS = 1000;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Compile the rules once and execute them in each iteration. The time is
+ * reported per loop iteration, i.e. per evaluation of the three rules.
+ */
+static void logical_bench_rules(CbCodeblockEngine engine, const char* name);
+
+
+/* -------------------------------------------------------------------------- */
+
+void logical_bench()
+{
+    logical_bench_rules(CB_CODEBLOCK_ENGINE_AST, "guarded rules (ast)");
+    logical_bench_rules(CB_CODEBLOCK_ENGINE_VM, "guarded rules (vm)");
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void logical_bench_rules(CbCodeblockEngine engine, const char* name)
+{
+    size_t i;
+    double start;
+    CbProgram* program;
+    CbEnvironment* environment;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    cb_codeblock_set_engine(cb, engine);
+    if (!cb_codeblock_parse_string(cb, BENCH_SOURCE))
+        exit(EXIT_FAILURE);
+    
+    program = cb_codeblock_compile(cb);
+    if (program == NULL)
+        exit(EXIT_FAILURE);
+    environment = cb_environment_create(program);
+    
+    start = bench_now();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        if (!cb_program_execute(program, environment))
+            exit(EXIT_FAILURE);
+    }
+    bench_report(name, BENCH_ITERATIONS * BENCH_LOOP_ITERATIONS,
+                 bench_now() - start);
+    
+    cb_environment_destroy(environment);
+    cb_program_destroy(program);
+    cb_codeblock_destroy(cb);
+}
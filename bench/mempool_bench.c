@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Benchmark: fixed size allocations of the interpreter (pool allocator)
+ ******************************************************************************/
+
+#include <stdio.h>
+
+#include "../src/utils.h"
+#include "../src/variant.h"
+#include "../src/intern.h"
+#include "../src/symbol_variable.h"
+#include "../src/symbol_table.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+static const size_t BENCH_ITERATIONS = 1000000;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Each iteration sets up and tears down the objects of a short codeblock
+ * execution: A symbol table with a nested scope, a variable and a boxed result.
+ */
+void mempool_bench()
+{
+    size_t i;
+    double start;
+    MemPoolStats before;
+    MemPoolStats after;
+    CbSymbolTable* symbols;
+    CbVariant* result;
+    const char* x = cb_intern("x");
+    
+    before = mempool_get_stats();
+    start  = bench_now();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        symbols = cb_symbol_table_create();
+        cb_symbol_table_enter_scope(symbols);
+        cb_symbol_table_insert(
+            symbols, (CbSymbol*) cb_symbol_variable_create(x)
+        );
+        result = cb_integer_create((CbIntegerDataType) i);
+        cb_variant_destroy(result);
+        cb_symbol_table_leave_scope(symbols);
+        cb_symbol_table_destroy(symbols);
+    }
+    bench_report("scope and variant setup", BENCH_ITERATIONS,
+                 bench_now() - start);
+    after = mempool_get_stats();
+    
+    printf("  %-40s %12.2f pool allocations/op\n", "",
+           (double) (after.allocations - before.allocations) /
+           (double) BENCH_ITERATIONS);
+    printf("  %-40s %12.2f system allocations/op\n", "",
+           (double) (after.system_allocations - before.system_allocations) /
+           (double) BENCH_ITERATIONS);
+}
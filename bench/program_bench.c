@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * Benchmark: parse and execute vs. compile once and execute many times
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/codeblock.h"
+#include "../src/program.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+static const char* const BENCH_SOURCE =
+    "|a, b| a := 3, b := 0, "
+    "while a > 0 do b := b + a, a := a - 1, end, "
+    "b * 2 + 1 > 10,";
+
+static const size_t BENCH_ITERATIONS = 100000;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Parse and execute the codeblock in each iteration.
+ */
+static void program_bench_parse_execute(CbCodeblockEngine engine,
+                                        const char* name);
+
+/*
+ * Compile the codeblock once and execute it in each iteration.
+ */
+static void program_bench_compiled(CbCodeblockEngine engine, const char* name);
+
+
+/* -------------------------------------------------------------------------- */
+
+void program_bench()
+{
+    program_bench_parse_execute(CB_CODEBLOCK_ENGINE_AST, "parse+execute (ast)");
+    program_bench_parse_execute(CB_CODEBLOCK_ENGINE_VM, "parse+execute (vm)");
+    program_bench_compiled(CB_CODEBLOCK_ENGINE_AST, "compiled program (ast)");
+    program_bench_compiled(CB_CODEBLOCK_ENGINE_VM, "compiled program (vm)");
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void program_bench_parse_execute(CbCodeblockEngine engine,
+                                        const char* name)
+{
+    size_t i;
+    double start;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    cb_codeblock_set_engine(cb, engine);
+    
+    start = bench_now();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        if (!cb_codeblock_parse_string(cb, BENCH_SOURCE) ||
+            !cb_codeblock_execute(cb))
+            exit(EXIT_FAILURE);
+    }
+    bench_report(name, BENCH_ITERATIONS, bench_now() - start);
+    
+    cb_codeblock_destroy(cb);
+}
+
+static void program_bench_compiled(CbCodeblockEngine engine, const char* name)
+{
+    size_t i;
+    double start;
+    CbProgram* program;
+    CbEnvironment* environment;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    cb_codeblock_set_engine(cb, engine);
+    if (!cb_codeblock_parse_string(cb, BENCH_SOURCE))
+        exit(EXIT_FAILURE);
+    
+    program = cb_codeblock_compile(cb);
+    if (program == NULL)
+        exit(EXIT_FAILURE);
+    environment = cb_environment_create(program);
+    
+    start = bench_now();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        if (!cb_program_execute(program, environment))
+            exit(EXIT_FAILURE);
+    }
+    bench_report(name, BENCH_ITERATIONS, bench_now() - start);
+    
+    cb_environment_destroy(environment);
+    cb_program_destroy(program);
+    cb_codeblock_destroy(cb);
+}
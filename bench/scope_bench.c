@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Benchmark: entering and leaving scopes of CbSymbolTable
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/intern.h"
+#include "../src/symbol_variable.h"
+#include "../src/symbol_table.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+static const size_t BENCH_ITERATIONS = 1000000;
+static const size_t BENCH_DEPTH      = 32;
+
+
+/* -------------------------------------------------------------------------- */
+
+void scope_bench()
+{
+    size_t i;
+    double start;
+    const char* global     = cb_intern("global");
+    const char* a          = cb_intern("a");
+    const char* b          = cb_intern("b");
+    CbSymbolTable* symbols = cb_symbol_table_create();
+    
+    cb_symbol_table_insert(symbols,
+                           (CbSymbol*) cb_symbol_variable_create(global));
+    
+    /* empty scopes */
+    start = bench_now();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        cb_symbol_table_enter_scope(symbols);
+        cb_symbol_table_leave_scope(symbols);
+    }
+    bench_report("enter/leave empty scope", BENCH_ITERATIONS,
+                 bench_now() - start);
+    
+    /* scopes declaring two variables, that are looked up with the global one */
+    start = bench_now();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        cb_symbol_table_enter_scope(symbols);
+        cb_symbol_table_insert(symbols,
+                               (CbSymbol*) cb_symbol_variable_create(a));
+        cb_symbol_table_insert(symbols,
+                               (CbSymbol*) cb_symbol_variable_create(b));
+        if (cb_symbol_table_lookup(symbols, "a") == NULL ||
+            cb_symbol_table_lookup(symbols, "global") == NULL)
+            exit(EXIT_FAILURE);
+        cb_symbol_table_leave_scope(symbols);
+    }
+    bench_report("enter/declare 2/leave scope", BENCH_ITERATIONS,
+                 bench_now() - start);
+    
+    /* global variable resolved from deeply nested scopes */
+    for (i = 0; i < BENCH_DEPTH; i++)
+    {
+        cb_symbol_table_enter_scope(symbols);
+        cb_symbol_table_insert(symbols,
+                               (CbSymbol*) cb_symbol_variable_create(a));
+    }
+    start = bench_now();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        if (cb_symbol_table_lookup(symbols, "global") == NULL)
+            exit(EXIT_FAILURE);
+    }
+    bench_report("lookup global at depth 32", BENCH_ITERATIONS,
+                 bench_now() - start);
+    for (i = 0; i < BENCH_DEPTH; i++)
+        cb_symbol_table_leave_scope(symbols);
+    
+    cb_symbol_table_destroy(symbols);
+}
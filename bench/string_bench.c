@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Benchmark: building and copying large strings
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/codeblock.h"
+#include "../src/program.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Append a chunk of 100 characters 100000 times (i.e. build a 10 MB string)
+ */
+static const char* const BENCH_SOURCE_CONCAT =
+    "|s, chunk, i| s := '', i := 0, "
+    "chunk := '0123456789012345678901234567890123456789012345678901234567890"
+             "123456789012345678901234567890123456789', "
+    "while i < 100000 do "
+        "s := s + chunk, "
+        "i := i + 1, "
+    "end, "
+    "s = '0123',";
+
+/*
+ * Build a 1 MB string and read the variable 100000 times
+ */
+static const char* const BENCH_SOURCE_READ =
+    "|s, t, chunk, i| s := '', i := 0, "
+    "chunk := '0123456789012345678901234567890123456789012345678901234567890"
+             "123456789012345678901234567890123456789', "
+    "while i < 10000 do "
+        "s := s + chunk, "
+        "i := i + 1, "
+    "end, "
+    "i := 0, "
+    "while i < 100000 do "
+        "t := s, "
+        "i := i + 1, "
+    "end, "
+    "t = '0123',";
+
+static const size_t BENCH_ITERATIONS = 5;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Compile the codeblock once and execute it in each iteration.
+ */
+static void string_bench_run(const char* source,
+                             CbCodeblockEngine engine,
+                             const char* name);
+
+
+/* -------------------------------------------------------------------------- */
+
+void string_bench()
+{
+    string_bench_run(BENCH_SOURCE_CONCAT, CB_CODEBLOCK_ENGINE_AST,
+                     "build 10 MB string (ast)");
+    string_bench_run(BENCH_SOURCE_CONCAT, CB_CODEBLOCK_ENGINE_VM,
+                     "build 10 MB string (vm)");
+    string_bench_run(BENCH_SOURCE_READ, CB_CODEBLOCK_ENGINE_AST,
+                     "read 1 MB string (ast)");
+    string_bench_run(BENCH_SOURCE_READ, CB_CODEBLOCK_ENGINE_VM,
+                     "read 1 MB string (vm)");
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void string_bench_run(const char* source,
+                             CbCodeblockEngine engine,
+                             const char* name)
+{
+    size_t i;
+    double start;
+    CbProgram* program;
+    CbEnvironment* environment;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    cb_codeblock_set_engine(cb, engine);
+    if (!cb_codeblock_parse_string(cb, source))
+        exit(EXIT_FAILURE);
+    
+    program = cb_codeblock_compile(cb);
+    if (program == NULL)
+        exit(EXIT_FAILURE);
+    environment = cb_environment_create(program);
+    
+    start = bench_now();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        if (!cb_program_execute(program, environment))
+            exit(EXIT_FAILURE);
+    }
+    bench_report(name, BENCH_ITERATIONS, bench_now() - start);
+    
+    cb_environment_destroy(environment);
+    cb_program_destroy(program);
+    cb_codeblock_destroy(cb);
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Benchmark: Vector growth and removal compared to the former block strategy
+ ******************************************************************************/
+
+#include <stdio.h>
+
+#include "../src/utils.h"
+#include "../src/vector.h"
+#include "bench.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+static const size_t BENCH_ITEM_COUNT  = 1000000;
+static const size_t BENCH_REMOVALS    = 20000;
+static const size_t BENCH_BLOCK_ITEMS = 16;
+
+#define BENCH_VECTOR_COUNT 8
+
+/*
+ * Vector, that grows by a fixed block of items (former growth strategy)
+ */
+typedef struct BlockVector
+{
+    size_t count;
+    size_t capacity;
+    VectorItem* elements;
+} BlockVector;
+
+
+/* -------------------------------------------------------------------------- */
+
+static void block_vector_append(BlockVector* self, VectorItem item);
+
+
+/* -------------------------------------------------------------------------- */
+
+void vector_bench()
+{
+    size_t i;
+    double start;
+    Vector* v;
+    Vector* vectors[BENCH_VECTOR_COUNT];
+    BlockVector block = { 0, 0, NULL };
+    BlockVector blocks[BENCH_VECTOR_COUNT];
+    VectorItem* items = memalloc(BENCH_ITEM_COUNT * sizeof(VectorItem));
+    
+    for (i = 0; i < BENCH_ITEM_COUNT; i++)
+        items[i] = items + i;
+    
+    /* append */
+    start = bench_now();
+    for (i = 0; i < BENCH_ITEM_COUNT; i++)
+        block_vector_append(&block, items[i]);
+    bench_report("append (fixed blocks)", BENCH_ITEM_COUNT,
+                 bench_now() - start);
+    memfree(block.elements);
+    
+    v     = vector_create();
+    start = bench_now();
+    for (i = 0; i < BENCH_ITEM_COUNT; i++)
+        vector_append(v, items[i]);
+    bench_report("append (geometric)", BENCH_ITEM_COUNT, bench_now() - start);
+    vector_destroy(v);
+    
+    /*
+     * Append to several vectors in turn: The buffers can not be grown in place
+     * by the system allocator then.
+     */
+    memclr(blocks, sizeof(blocks));
+    start = bench_now();
+    for (i = 0; i < BENCH_ITEM_COUNT; i++)
+        block_vector_append(&blocks[i % BENCH_VECTOR_COUNT], items[i]);
+    bench_report("append interleaved (fixed blocks)", BENCH_ITEM_COUNT,
+                 bench_now() - start);
+    for (i = 0; i < BENCH_VECTOR_COUNT; i++)
+        memfree(blocks[i].elements);
+    
+    for (i = 0; i < BENCH_VECTOR_COUNT; i++)
+        vectors[i] = vector_create();
+    start = bench_now();
+    for (i = 0; i < BENCH_ITEM_COUNT; i++)
+        vector_append(vectors[i % BENCH_VECTOR_COUNT], items[i]);
+    bench_report("append interleaved (geometric)", BENCH_ITEM_COUNT,
+                 bench_now() - start);
+    for (i = 0; i < BENCH_VECTOR_COUNT; i++)
+        vector_destroy(vectors[i]);
+    
+    v     = vector_create();
+    start = bench_now();
+    vector_reserve(v, BENCH_ITEM_COUNT);
+    for (i = 0; i < BENCH_ITEM_COUNT; i++)
+        vector_append(v, items[i]);
+    bench_report("append (reserved)", BENCH_ITEM_COUNT, bench_now() - start);
+    vector_destroy(v);
+    
+    v     = vector_create();
+    start = bench_now();
+    vector_extend(v, items, BENCH_ITEM_COUNT);
+    bench_report("extend", BENCH_ITEM_COUNT, bench_now() - start);
+    
+    /* remove from the front */
+    start = bench_now();
+    for (i = 0; i < BENCH_REMOVALS; i++)
+        vector_remove(v, 0);
+    bench_report("remove (ordered)", BENCH_REMOVALS, bench_now() - start);
+    
+    start = bench_now();
+    for (i = 0; i < BENCH_REMOVALS; i++)
+        vector_swap_remove(v, 0);
+    bench_report("remove (swap)", BENCH_REMOVALS, bench_now() - start);
+    vector_destroy(v);
+    
+    memfree(items);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void block_vector_append(BlockVector* self, VectorItem item)
+{
+    if (self->count == self->capacity)
+    {
+        self->capacity += BENCH_BLOCK_ITEMS;
+        self->elements  = memrealloc(self->elements,
+                                     self->capacity * sizeof(VectorItem));
+    }
+    
+    self->elements[self->count++] = item;
+}
@@ -0,0 +1,137 @@
+#include <string.h>
+
+#include "utils.h"
+#include "arena.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+typedef struct CbArenaChunk CbArenaChunk;
+struct CbArenaChunk
+{
+    CbArenaChunk* prior;
+    size_t capacity; /* usable bytes following the chunk header */
+};
+
+struct CbArena
+{
+    CbArenaChunk* chunk; /* current chunk */
+    char* next;          /* next free byte of the current chunk */
+    char* end;           /* end of the current chunk            */
+    size_t size;         /* allocated bytes                     */
+};
+
+/*
+ * Alignment of allocated blocks (suitable for pointers, integers and doubles)
+ */
+typedef union CbArenaAlignment
+{
+    void* pointer;
+    long int integer;
+    double decimal;
+} CbArenaAlignment;
+
+static const size_t CB_ARENA_ALIGNMENT      = sizeof(CbArenaAlignment);
+static const size_t CB_ARENA_MIN_CHUNK_SIZE = 4096;
+static const size_t CB_ARENA_MAX_CHUNK_SIZE = 65536;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Add a new chunk to the arena, that provides at least size bytes.
+ */
+static void cb_arena_grow(CbArena* self, size_t size);
+
+
+/* -------------------------------------------------------------------------- */
+
+CbArena* cb_arena_create()
+{
+    CbArena* self = memalloc(sizeof(CbArena));
+    self->chunk   = NULL;
+    self->next    = NULL;
+    self->end     = NULL;
+    self->size    = 0;
+    
+    return self;
+}
+
+void cb_arena_destroy(CbArena* self)
+{
+    CbArenaChunk* chunk = self->chunk;
+    CbArenaChunk* prior;
+    
+    while (chunk != NULL)
+    {
+        prior = chunk->prior;
+        memfree(chunk);
+        chunk = prior;
+    }
+    
+    memfree(self);
+}
+
+void* cb_arena_alloc(CbArena* self, size_t size)
+{
+    void* result;
+    
+    /* round up to the alignment, so the next block is aligned as well */
+    size = (size + CB_ARENA_ALIGNMENT - 1) / CB_ARENA_ALIGNMENT *
+           CB_ARENA_ALIGNMENT;
+    
+    if (self->next == NULL || (size_t) (self->end - self->next) < size)
+        cb_arena_grow(self, size);
+    
+    result      = self->next;
+    self->next += size;
+    self->size += size;
+    
+    return result;
+}
+
+char* cb_arena_strdup(CbArena* self, const char* string)
+{
+    size_t size  = strlen(string) + 1;
+    char* result = cb_arena_alloc(self, size);
+    
+    memcpy(result, string, size);
+    
+    return result;
+}
+
+size_t cb_arena_get_size(const CbArena* self)
+{
+    return self->size;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void cb_arena_grow(CbArena* self, size_t size)
+{
+    CbArenaChunk* chunk;
+    /* the header is padded, so the first block is aligned */
+    size_t header   = (sizeof(CbArenaChunk) + CB_ARENA_ALIGNMENT - 1) /
+                      CB_ARENA_ALIGNMENT * CB_ARENA_ALIGNMENT;
+    size_t capacity = CB_ARENA_MIN_CHUNK_SIZE;
+    
+    /* double the chunk size with each chunk up to a maximum */
+    if (self->chunk != NULL)
+    {
+        capacity = self->chunk->capacity * 2;
+        if (capacity > CB_ARENA_MAX_CHUNK_SIZE)
+            capacity = CB_ARENA_MAX_CHUNK_SIZE;
+    }
+    
+    if (capacity < size)
+        capacity = size;
+    
+    chunk           = memalloc(header + capacity);
+    chunk->prior    = self->chunk;
+    chunk->capacity = capacity;
+    
+    self->chunk = chunk;
+    self->next  = (char*) chunk + header;
+    self->end   = self->next + capacity;
+}
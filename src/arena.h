@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * @file  arena.h
+ * @brief Contains the CbArena structure
+ * 
+ * Implementation of a simple region based allocator: Memory is handed out
+ * sequentially from large chunks and can not be freed individually. Instead
+ * all memory of an arena is released at once, when the arena is destroyed.
+ * 
+ * The AST of a codeblock (nodes and literal values) is allocated
+ * in a single arena, so the nodes are laid out contiguously in parse order and
+ * the whole tree is released without walking it.
+ ******************************************************************************/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+
+/**
+ * @struct CbArena
+ * @brief  Region based allocator
+ */
+typedef struct CbArena CbArena;
+
+
+/**
+ * @memberof CbArena
+ * @brief    Constructor
+ */
+CbArena* cb_arena_create();
+
+/**
+ * @memberof CbArena
+ * @brief    Destructor: Releases all memory allocated by the arena
+ * 
+ * @param self The arena instance to destroy
+ */
+void cb_arena_destroy(CbArena* self);
+
+/**
+ * @memberof CbArena
+ * @brief    Allocate a block of memory
+ * 
+ * The block is suitably aligned for any kind of object.
+ * NOTE: The arena aborts the program, if the system is out of memory.
+ * 
+ * @param self The arena instance
+ * @param size Size of the block in bytes
+ */
+void* cb_arena_alloc(CbArena* self, size_t size);
+
+/**
+ * @memberof CbArena
+ * @brief    Copy a string into the arena
+ * 
+ * @param self   The arena instance
+ * @param string The string to copy
+ */
+char* cb_arena_strdup(CbArena* self, const char* string);
+
+/**
+ * @memberof CbArena
+ * @brief    Get the number of bytes allocated from the arena
+ * 
+ * @param self The arena instance
+ */
+size_t cb_arena_get_size(const CbArena* self);
+
+
+#endif /* ARENA_H */
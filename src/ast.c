@@ -6,8 +6,12 @@
 #include "ast_internal.h"
 #include "ast_value.h"
 #include "ast_binary.h"
+#include "ast_logical.h"
 #include "ast_unary.h"
 #include "ast_variable.h"
+#include "ast_assignment.h"
+#include "ast_statement_list.h"
+#include "ast_control_flow.h"
 
 
 /* -------------------------------------------------------------------------- */
@@ -16,7 +20,6 @@ void cb_ast_node_init(CbAstNode* self,
                       CbAstType type,
                       CbAstNode* left_node,
                       CbAstNode* right_node,
-                      CbAstNodeDestructorFunc destructor,
                       CbAstNodeEvalFunc eval,
                       CbAstNodeSemanticFunc semantic_check)
 {
@@ -26,19 +29,18 @@ void cb_ast_node_init(CbAstNode* self,
     self->line          = -1;
     self->error_context = CB_ERROR_UNKNOWN;
     
-    self->destructor     = destructor;
     self->eval           = eval;
     self->semantic_check = semantic_check;
 }
 
-void cb_ast_node_destroy(CbAstNode* self)
+void cb_ast_node_set_line(CbAstNode* self, int line)
 {
-    self->destructor(self);
+    self->line = line;
 }
 
-void cb_ast_node_set_line(CbAstNode* self, int line)
+int cb_ast_node_get_line(const CbAstNode* self)
 {
-    self->line = line;
+    return self->line;
 }
 
 CbAstType cb_ast_node_get_type(const CbAstNode* self)
@@ -46,13 +48,118 @@ CbAstType cb_ast_node_get_type(const CbAstNode* self)
     return self->type;
 }
 
-CbVariant* cb_ast_node_eval(CbAstNode* self, const CbSymbolTable* symbols)
+const CbAstNode* cb_ast_node_get_left(const CbAstNode* self)
+{
+    return self->left;
+}
+
+const CbAstNode* cb_ast_node_get_right(const CbAstNode* self)
+{
+    return self->right;
+}
+
+void cb_ast_node_set_left(CbAstNode* self, CbAstNode* left)
+{
+    self->left = left;
+}
+
+void cb_ast_node_set_right(CbAstNode* self, CbAstNode* right)
+{
+    self->right = right;
+}
+
+bool cb_ast_node_eval_value(const CbAstNode* self,
+                            const CbSymbolTable* symbols,
+                            CbVariant* result)
+{
+    /*
+     * NOTE: The node must not be modified during the evaluation, so that a
+     *       checked AST can be evaluated by several threads at the same time.
+     *       Runtime errors are always reported as CB_ERROR_RUNTIME.
+     */
+    return self->eval(self, symbols, result);
+}
+
+bool cb_ast_node_has_assignment(const CbAstNode* self)
+{
+    size_t i;
+    const CbAstStatementListNode* list;
+    
+    if (self == NULL)
+        return false;
+    else if (self->type == CB_AST_TYPE_ASSIGNMENT)
+        return true;
+    else if (self->type == CB_AST_TYPE_STATEMENT_LIST)
+    {
+        list = (const CbAstStatementListNode*) self;
+        for (i = 0; i < cb_ast_statement_list_node_get_count(list); i++)
+        {
+            if (cb_ast_node_has_assignment(
+                    cb_ast_statement_list_node_get(list, i)))
+                return true;
+        }
+        return false;
+    }
+    else if (self->type == CB_AST_TYPE_CONTROL_FLOW &&
+             cb_ast_node_has_assignment(cb_ast_control_flow_node_get_condition(
+                 (const CbAstControlFlowNode*) self
+             )))
+        return true;
+    else
+        return cb_ast_node_has_assignment(self->left) ||
+               cb_ast_node_has_assignment(self->right);
+}
+
+bool cb_ast_node_exec(const CbAstNode* self, const CbSymbolTable* symbols)
+{
+    bool success;
+    CbVariant value;
+    
+    /*
+     * NOTE: Assignments are performed without their eval function, unless it
+     *       was replaced by a profiler (see ast_profiler.h).
+     */
+    if (self->type == CB_AST_TYPE_ASSIGNMENT &&
+        self->eval == (CbAstNodeEvalFunc) cb_ast_assignment_node_eval)
+        success = cb_ast_assignment_node_perform(
+            (const CbAstAssignmentNode*) self, symbols
+        ) != NULL;
+    else
+    {
+        success = cb_ast_node_eval_value(self, symbols, &value);
+        cb_variant_release(&value);
+    }
+    
+    return success;
+}
+
+bool cb_ast_node_safe_eval_value(const CbAstNode* self,
+                                 const CbSymbolTable* symbols,
+                                 CbVariant* result)
+{
+    if (self == NULL)
+    {
+        *result = cb_variant_make();
+        return true;
+    }
+    else
+        return cb_ast_node_eval_value(self, symbols, result);
+}
+
+CbVariant* cb_ast_node_eval(const CbAstNode* self, const CbSymbolTable* symbols)
 {
-    self->error_context = CB_ERROR_RUNTIME;
-    return self->eval(self, symbols);
+    CbVariant value;
+    
+    if (cb_ast_node_eval_value(self, symbols, &value))
+        return cb_variant_box(value);
+    else
+    {
+        cb_variant_release(&value);
+        return NULL;
+    }
 }
 
-CbVariant* cb_ast_node_safe_eval(CbAstNode* self, const CbSymbolTable* symbols)
+CbVariant* cb_ast_node_safe_eval(const CbAstNode* self, const CbSymbolTable* symbols)
 {
     if (self == NULL)
         return cb_variant_create();
@@ -88,6 +195,11 @@ CbVariantType cb_ast_node_get_expression_type(const CbAstNode* self)
             result = cb_ast_binary_node_get_expression_type((const CbAstBinaryNode*) self);
             break;
         
+        /* logical operations always yield a boolean value */
+        case CB_AST_TYPE_LOGICAL:
+            result = CB_VARIANT_TYPE_BOOLEAN;
+            break;
+        
         case CB_AST_TYPE_UNARY:
             result = cb_ast_node_get_expression_type(self->left);
             break;
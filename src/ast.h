@@ -18,6 +18,12 @@
  *                      .---------------.
  *                      |      ...      |
  * 
+ * NOTE: All nodes of an AST are allocated in a single arena (see arena.h),
+ *       which is passed to the node constructors. There is no destructor for
+ *       individual nodes: The whole AST (including literal values) is
+ *       released at once by destroying the arena. Identifiers are interned
+ *       (see intern.h).
+ * 
  ******************************************************************************/
 
 #ifndef AST_H
@@ -42,38 +48,95 @@ typedef enum CbAstType
     CB_AST_TYPE_DECLARATION_BLOCK,
     CB_AST_TYPE_STATEMENT_LIST,
     CB_AST_TYPE_CONTROL_FLOW,
-    CB_AST_TYPE_COMPARISON
+    CB_AST_TYPE_COMPARISON,
+    CB_AST_TYPE_LOGICAL
 } CbAstType;
 
 
 /* -------------------------------------------------------------------------- */
 
 /*
- * Destructor
+ * Line number (Setter)
  */
-void cb_ast_node_destroy(CbAstNode* self);
+void cb_ast_node_set_line(CbAstNode* self, int line);
 
 /*
- * Line number (Setter)
+ * Line number (Getter)
  */
-void cb_ast_node_set_line(CbAstNode* self, int line);
+int cb_ast_node_get_line(const CbAstNode* self);
 
 /*
  * Node type (Getter)
  */
 CbAstType cb_ast_node_get_type(const CbAstNode* self);
 
+/*
+ * Left child node (Getter)
+ */
+const CbAstNode* cb_ast_node_get_left(const CbAstNode* self);
+
+/*
+ * Right child node (Getter)
+ */
+const CbAstNode* cb_ast_node_get_right(const CbAstNode* self);
+
+/*
+ * Left child node (Setter)
+ * NOTE: Only used to rewrite a checked AST (see optimizer.h).
+ */
+void cb_ast_node_set_left(CbAstNode* self, CbAstNode* left);
+
+/*
+ * Right child node (Setter)
+ * NOTE: Only used to rewrite a checked AST (see optimizer.h).
+ */
+void cb_ast_node_set_right(CbAstNode* self, CbAstNode* right);
+
+/*
+ * Evaluate AST node
+ * The result is stored (by value) in the variant pointed to by result and must
+ * be released by the caller (see cb_variant_release()). Returns false, if a
+ * runtime error occurred.
+ */
+bool cb_ast_node_eval_value(const CbAstNode* self,
+                            const CbSymbolTable* symbols,
+                            CbVariant* result);
+
+/*
+ * Check if an AST node or any of its child nodes is an assignment (i.e. if
+ * evaluating the node might change the value of a variable)
+ */
+bool cb_ast_node_has_assignment(const CbAstNode* self);
+
+/*
+ * Evaluate AST node, whose value is not used (e.g. a statement, that is
+ * followed by other statements). The value of an assignment is not copied in
+ * this case. Returns false, if a runtime error occurred.
+ */
+bool cb_ast_node_exec(const CbAstNode* self, const CbSymbolTable* symbols);
+
+/*
+ * Make sure the node is valid (i.e. not NULL) and call
+ * cb_ast_node_eval_value().
+ * Otherwise store an undefined value and return true.
+ */
+bool cb_ast_node_safe_eval_value(const CbAstNode* self,
+                                 const CbSymbolTable* symbols,
+                                 CbVariant* result);
+
 /*
  * Evaluate AST node
+ * NOTE: Compatibility wrapper for cb_ast_node_eval_value(), that returns a heap
+ *       allocated result or NULL, if a runtime error occurred.
  */
-CbVariant* cb_ast_node_eval(CbAstNode* self, const CbSymbolTable* symbols);
+CbVariant* cb_ast_node_eval(const CbAstNode* self, const CbSymbolTable* symbols);
 
 /*
  * Make sure the node is valid (i.e. not NULL) and evaluate it and return its
  * result.
  * Otherwise return an empty (undefined) variant object.
  */
-CbVariant* cb_ast_node_safe_eval(CbAstNode* self, const CbSymbolTable* symbols);
+CbVariant* cb_ast_node_safe_eval(const CbAstNode* self, const CbSymbolTable* symbols);
 
 /*
  * Check AST node semantics
@@ -1,8 +1,10 @@
 #include "utils.h"
 #include "cb_utils.h"
 #include "error_handling.h"
+#include "operation.h"
 #include "ast_internal.h"
 #include "ast_variable.h"
+#include "ast_binary.h"
 
 #include "ast_assignment.h"
 
@@ -12,56 +14,87 @@
 struct CbAstAssignmentNode
 {
     CbAstNode base;
+    bool append;    /* append to the variable in place (see set_append()) */
 };
 
+/*
+ * Perform the assignment "variable := variable + x" in place
+ */
+static const CbVariant* cb_ast_assignment_node_append(const CbAstAssignmentNode* self,
+                                                      const CbSymbolTable* symbols);
+
 
 /* -------------------------------------------------------------------------- */
 
-CbAstAssignmentNode* cb_ast_assignment_node_create(CbAstNode* left,
+CbAstAssignmentNode* cb_ast_assignment_node_create(CbArena* arena,
+                                                   CbAstNode* left,
                                                    CbAstNode* right)
 {
-    CbAstAssignmentNode* self = (CbAstAssignmentNode*) memalloc(sizeof(CbAstAssignmentNode));
+    CbAstAssignmentNode* self = cb_arena_alloc(arena, sizeof(CbAstAssignmentNode));
     cb_ast_node_init(
         &self->base, CB_AST_TYPE_ASSIGNMENT, left, right,
-        (CbAstNodeDestructorFunc) cb_ast_assignment_node_destroy,
         (CbAstNodeEvalFunc)       cb_ast_assignment_node_eval,
         (CbAstNodeSemanticFunc)   cb_ast_assignment_node_check_semantic
     );
+    self->append = false;
     
     return self;
 }
 
-void cb_ast_assignment_node_destroy(CbAstAssignmentNode* self)
+bool cb_ast_assignment_node_eval(const CbAstAssignmentNode* self,
+                                 const CbSymbolTable* symbols,
+                                 CbVariant* result)
 {
-    /* destroy both child nodes */
-    cb_ast_node_destroy(self->base.left);
-    cb_ast_node_destroy(self->base.right);
+    const CbVariant* value = cb_ast_assignment_node_perform(self, symbols);
+    
+    if (value != NULL)
+        *result = cb_variant_clone(value);
+    else
+        *result = cb_variant_make();
     
-    memfree(self);
+    return value != NULL;
 }
 
-CbVariant* cb_ast_assignment_node_eval(const CbAstAssignmentNode* self,
-                                       const CbSymbolTable* symbols)
+const CbVariant* cb_ast_assignment_node_perform(const CbAstAssignmentNode* self,
+                                                const CbSymbolTable* symbols)
 {
-    CbVariant* result = NULL;
-    CbAstVariableNode* node;
-    CbVariant* value;
+    CbVariant value;
+    const CbVariant* result = NULL;
     
     cb_assert(self->base.left->type == CB_AST_TYPE_VARIABLE);
     
-    node  = (CbAstVariableNode*) self->base.left;
-    value = cb_ast_node_eval(self->base.right, symbols);
-    if (value != NULL)
-    {
-        result = cb_variant_copy(cb_ast_variable_node_assign(
-            node, symbols, value
-        ));
-        cb_variant_destroy(value);
-    }
+    if (self->append)
+        return cb_ast_assignment_node_append(self, symbols);
+    
+    /* the evaluated value is moved into the variable (no copy) */
+    if (cb_ast_node_eval_value(self->base.right, symbols, &value))
+        result = cb_ast_variable_node_assign(
+            (const CbAstVariableNode*) self->base.left, symbols, &value
+        );
+    
+    cb_variant_release(&value);
     
     return result;
 }
 
+void cb_ast_assignment_node_set_append(CbAstAssignmentNode* self)
+{
+    const CbAstNode* operation = self->base.right;
+    
+    cb_assert(operation->type == CB_AST_TYPE_BINARY);
+    cb_assert(cb_ast_binary_node_get_operator_type(
+        (const CbAstBinaryNode*) operation
+    ) == CB_BINARY_OPERATOR_TYPE_ADD);
+    cb_assert(operation->left->type == CB_AST_TYPE_VARIABLE);
+    cb_assert(cb_ast_variable_node_is_same(
+        (const CbAstVariableNode*) self->base.left,
+        (const CbAstVariableNode*) operation->left
+    ));
+    cb_assert(!cb_ast_node_has_assignment(operation->right));
+    
+    self->append = true;
+}
+
 bool cb_ast_assignment_node_check_semantic(const CbAstAssignmentNode* self,
                                            CbSymbolTable* symbols)
 {
@@ -87,3 +120,47 @@ bool cb_ast_assignment_node_check_semantic(const CbAstAssignmentNode* self,
     
     return result;
 }
+
+
+/* -------------------------------------------------------------------------- */
+
+static const CbVariant* cb_ast_assignment_node_append(const CbAstAssignmentNode* self,
+                                                      const CbSymbolTable* symbols)
+{
+    CbVariant left;
+    CbVariant right;
+    CbVariant value;
+    const CbAstNode* operation        = self->base.right;
+    const CbAstVariableNode* variable = (const CbAstVariableNode*) self->base.left;
+    const CbVariant* result           = NULL;
+    
+    /*
+     * NOTE: The right operand can not change the variable, so it may be
+     *       evaluated before the value of the variable is read.
+     */
+    if (!cb_ast_node_eval_value(operation->right, symbols, &right))
+    {
+        cb_variant_release(&right);
+        return NULL;
+    }
+    
+    result = cb_ast_variable_node_append(variable, symbols, &right);
+    
+    /* not a string concatenation -> evaluate the addition as usual */
+    if (result == NULL)
+    {
+        if (cb_ast_node_eval_value(operation->left, symbols, &left) &&
+            cb_binary_operation_eval(CB_BINARY_OPERATOR_TYPE_ADD, &left,
+                                     &right, operation->line, &value))
+        {
+            result = cb_ast_variable_node_assign(variable, symbols, &value);
+            cb_variant_release(&value);
+        }
+        
+        cb_variant_release(&left);
+    }
+    
+    cb_variant_release(&right);
+    
+    return result;
+}
@@ -9,6 +9,7 @@
 #define AST_ASSIGNMENT_H
 
 #include "ast.h"
+#include "arena.h"
 
 
 /* -------------------------------------------------------------------------- */
@@ -21,19 +22,32 @@ typedef struct CbAstAssignmentNode CbAstAssignmentNode;
 /*
  * Constructor
  */
-CbAstAssignmentNode* cb_ast_assignment_node_create(CbAstNode* left,
+CbAstAssignmentNode* cb_ast_assignment_node_create(CbArena* arena,
+                                                   CbAstNode* left,
                                                    CbAstNode* right);
 
 /*
- * Destructor
+ * Evaluate/perform assignment
  */
-void cb_ast_assignment_node_destroy(CbAstAssignmentNode* self);
+bool cb_ast_assignment_node_eval(const CbAstAssignmentNode* self,
+                                 const CbSymbolTable* symbols,
+                                 CbVariant* result);
 
 /*
- * Evaluate/perform assignment
+ * Perform assignment without copying the assigned value.
+ * Returns the value of the variable (borrowed, it is only valid until the
+ * variable is assigned again) or NULL, if a runtime error occurred.
+ */
+const CbVariant* cb_ast_assignment_node_perform(const CbAstAssignmentNode* self,
+                                                const CbSymbolTable* symbols);
+
+/*
+ * Perform the assignment "variable := variable + x" by appending x to the
+ * value of the variable in place, if both are strings (see optimizer.h).
+ * NOTE: The right node must be an addition, whose left operand is the assigned
+ *       variable and whose right operand does not contain any assignments.
  */
-CbVariant* cb_ast_assignment_node_eval(const CbAstAssignmentNode* self,
-                                       const CbSymbolTable* symbols);
+void cb_ast_assignment_node_set_append(CbAstAssignmentNode* self);
 
 /*
  * Check semantics
@@ -1,8 +1,7 @@
 #include "utils.h"
 #include "cb_utils.h"
 #include "error_handling.h"
-#include "symbol_variable.h"
-#include "ast_variable.h"
+#include "operation.h"
 #include "ast_internal.h"
 #include "ast_binary.h"
 
@@ -13,110 +12,82 @@ struct CbAstBinaryNode
 {
     CbAstNode base;
     CbBinaryOperatorType operator_type;
+    CbVariantType operand_type; /* type of both operands, if specialized */
 };
 
 /*
- * Evaluate binary node (integer)
- */
-static CbVariant* cb_ast_binary_node_eval_integer(const CbAstBinaryNode* self,
-                                                  const CbVariant* left,
-                                                  const CbVariant* right);
-
-/*
- * Evaluate binary node (float)
- */
-static CbVariant* cb_ast_binary_node_eval_float(const CbAstBinaryNode* self,
-                                                const CbVariant* left,
-                                                const CbVariant* right);
-
-/*
- * Evaluate binary node (string)
+ * Check if a binary operation is valid. Raise an error if not.
  */
-static CbVariant* cb_ast_binary_node_eval_string(const CbAstBinaryNode* self,
-                                                 const CbVariant* left,
-                                                 const CbVariant* right);
+static bool cb_ast_binary_node_check_operation(const CbAstBinaryNode* self,
+                                               const CbVariantType lhs,
+                                               const CbVariantType rhs);
 
 /*
- * Evaluate binary node (boolean)
+ * Evaluate both operands. On failure both values are undefined.
  */
-static CbVariant* cb_ast_binary_node_eval_boolean(const CbAstBinaryNode* self,
-                                                  const CbVariant* left,
-                                                  const CbVariant* right);
+static bool cb_ast_binary_node_eval_operands(const CbAstBinaryNode* self,
+                                             const CbSymbolTable* symbols,
+                                             CbVariant* left,
+                                             CbVariant* right);
 
 /*
- * Check if a binary operation is valid. Raise an error if not.
+ * Evaluate specialized nodes (operands of type integer, float or string)
  */
-static bool cb_ast_binary_node_check_operation(const CbAstBinaryNode* self,
-                                               const CbVariantType lhs,
-                                               const CbVariantType rhs);
+static bool cb_ast_binary_node_eval_integer(const CbAstBinaryNode* self,
+                                            const CbSymbolTable* symbols,
+                                            CbVariant* result);
+static bool cb_ast_binary_node_eval_float(const CbAstBinaryNode* self,
+                                          const CbSymbolTable* symbols,
+                                          CbVariant* result);
+static bool cb_ast_binary_node_eval_string(const CbAstBinaryNode* self,
+                                           const CbSymbolTable* symbols,
+                                           CbVariant* result);
 
 
 /* -------------------------------------------------------------------------- */
 
-CbAstBinaryNode* cb_ast_binary_node_create(CbBinaryOperatorType operator_type,
+CbAstBinaryNode* cb_ast_binary_node_create(CbArena* arena,
+                                           CbBinaryOperatorType operator_type,
                                            CbAstNode* left,
                                            CbAstNode* right)
 {
-    CbAstBinaryNode* self = (CbAstBinaryNode*) memalloc(sizeof(CbAstBinaryNode));
+    CbAstBinaryNode* self = cb_arena_alloc(arena, sizeof(CbAstBinaryNode));
     cb_ast_node_init(
         &self->base, CB_AST_TYPE_BINARY, left, right,
-        (CbAstNodeDestructorFunc) cb_ast_binary_node_destroy,
         (CbAstNodeEvalFunc)       cb_ast_binary_node_eval,
         (CbAstNodeSemanticFunc)   cb_ast_binary_node_check_semantic
     );
     self->operator_type = operator_type;
+    self->operand_type  = CB_VARIANT_TYPE_UNDEFINED;
     
     return self;
 }
 
-void cb_ast_binary_node_destroy(CbAstBinaryNode* self)
+bool cb_ast_binary_node_eval(const CbAstBinaryNode* self,
+                             const CbSymbolTable* symbols,
+                             CbVariant* result)
 {
-    /* destroy both child nodes */
-    cb_ast_node_destroy(self->base.left);
-    cb_ast_node_destroy(self->base.right);
+    bool success = false;
+    CbVariant left;
+    CbVariant right;
     
-    memfree(self);
-}
-
-CbVariant* cb_ast_binary_node_eval(const CbAstBinaryNode* self,
-                                   const CbSymbolTable* symbols)
-{
-    CbVariant* result = NULL;
+    *result = cb_variant_make();
     
     /* evaluate left child node first */
-    CbVariant* left = cb_ast_node_eval(self->base.left, symbols);
-    if (left != NULL)
+    if (cb_ast_node_eval_value(self->base.left, symbols, &left))
     {
-        /* evaluate right child node first */
-        CbVariant* right = cb_ast_node_eval(self->base.right, symbols);
-        if (right != NULL)
-        {
-            if (cb_ast_binary_node_check_operation(self,
-                                                   cb_variant_get_type(left),
-                                                   cb_variant_get_type(right)))
-            {
-                if (cb_variant_is_numeric(left))
-                {
-                    if (cb_variant_is_float(left) || cb_variant_is_float(right))
-                        result = cb_ast_binary_node_eval_float(self, left, right);
-                    else
-                        result = cb_ast_binary_node_eval_integer(self, left, right);
-                }
-                else if (cb_variant_is_string(left))
-                    result = cb_ast_binary_node_eval_string(self, left, right);
-                else if (cb_variant_is_boolean(left))
-                    result = cb_ast_binary_node_eval_boolean(self, left, right);
-                else
-                    cb_abort("Invalid binary operation");
-            }
-            
-            cb_variant_destroy(right);
-        }
+        /* evaluate right child node */
+        if (cb_ast_node_eval_value(self->base.right, symbols, &right))
+            success = cb_binary_operation_eval(self->operator_type, &left,
+                                               &right, self->base.line,
+                                               result);
         
-        cb_variant_destroy(left);
+        cb_variant_release(&right);
     }
     
-    return result;
+    cb_variant_release(&left);
+    
+    return success;
 }
 
 bool cb_ast_binary_node_check_semantic(const CbAstBinaryNode* self,
@@ -136,6 +107,55 @@ bool cb_ast_binary_node_check_semantic(const CbAstBinaryNode* self,
     return result;
 }
 
+CbBinaryOperatorType cb_ast_binary_node_get_operator_type(const CbAstBinaryNode* self)
+{
+    return self->operator_type;
+}
+
+bool cb_ast_binary_node_specialize(CbAstBinaryNode* self,
+                                   CbVariantType operand_type)
+{
+    CbAstNodeEvalFunc eval = NULL;
+    
+    switch (operand_type)
+    {
+        case CB_VARIANT_TYPE_INTEGER:
+            /* integer division yields either an integer or a float */
+            if (self->operator_type != CB_BINARY_OPERATOR_TYPE_DIV)
+                eval = (CbAstNodeEvalFunc) cb_ast_binary_node_eval_integer;
+            break;
+        
+        case CB_VARIANT_TYPE_FLOAT:
+            eval = (CbAstNodeEvalFunc) cb_ast_binary_node_eval_float;
+            break;
+        
+        case CB_VARIANT_TYPE_STRING:
+            if (self->operator_type == CB_BINARY_OPERATOR_TYPE_ADD)
+                eval = (CbAstNodeEvalFunc) cb_ast_binary_node_eval_string;
+            break;
+        
+        default: break;
+    }
+    
+    /* logical operations are not supported for numbers */
+    if (self->operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_AND ||
+        self->operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_OR)
+        eval = NULL;
+    
+    if (eval != NULL)
+    {
+        self->base.eval    = eval;
+        self->operand_type = operand_type;
+    }
+    
+    return eval != NULL;
+}
+
+CbVariantType cb_ast_binary_node_get_operand_type(const CbAstBinaryNode* self)
+{
+    return self->operand_type;
+}
+
 CbVariantType cb_ast_binary_node_get_expression_type(const CbAstBinaryNode* self)
 {
     CbVariantType result = CB_VARIANT_TYPE_UNDEFINED;
@@ -160,7 +180,10 @@ CbVariantType cb_ast_binary_node_get_expression_type(const CbAstBinaryNode* self
              * ensured to be semantically correct, so types of left and right
              * node are equal (or both types are numeric).
              */
-            result = cb_ast_node_get_expression_type(self->base.left);
+            if (self->operand_type != CB_VARIANT_TYPE_UNDEFINED)
+                result = self->operand_type;
+            else
+                result = cb_ast_node_get_expression_type(self->base.left);
             break;
     }
     
@@ -170,207 +193,174 @@ CbVariantType cb_ast_binary_node_get_expression_type(const CbAstBinaryNode* self
 
 /* -------------------------------------------------------------------------- */
 
-static CbVariant* cb_ast_binary_node_eval_integer(const CbAstBinaryNode* self,
-                                                  const CbVariant* left,
-                                                  const CbVariant* right)
+static bool cb_ast_binary_node_check_operation(const CbAstBinaryNode* self,
+                                               const CbVariantType lhs,
+                                               const CbVariantType rhs)
 {
-    CbVariant* result    = NULL;
-    CbIntegerDataType v1 = cb_integer_get_value(left);
-    CbIntegerDataType v2 = cb_integer_get_value(right);
-    
-    switch (self->operator_type)
-    {
-        case CB_BINARY_OPERATOR_TYPE_ADD:
-            result = cb_integer_create(v1 + v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_SUB:
-            result = cb_integer_create(v1 - v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_MUL:
-            result = cb_integer_create(v1 * v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_DIV:
-            if (v2 == 0)
-                cb_error_trigger(CB_ERROR_RUNTIME, self->base.line,
-                                 "Division by zero is not allowed");
-            else
-            {
-                if ((v1 % v2) == 0)
-                    /* 
-                     * Division does not yield a real number.
-                     * -> Create an integer result.
-                     */
-                    result = cb_integer_create(v1 / v2);
-                else
-                    /*
-                     * Division yields a real number -> Create a float result.
-                     */
-                    result = cb_float_create((CbFloatDataType) v1 /
-                                             (CbFloatDataType) v2);
-            }
-            break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GT:
-            result = cb_boolean_create(v1 > v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GE:
-            result = cb_boolean_create(v1 >= v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LT:
-            result = cb_boolean_create(v1 < v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LE:
-            result = cb_boolean_create(v1 <= v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
-            result = cb_boolean_create(v1 == v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
-            result = cb_boolean_create(v1 != v2); break;
-        
-        /* invalid binary operator type */
-        default: cb_abort("Invalid binary operator type"); break;
-    }
-    
-    return result;
+    return cb_binary_operation_check(self->operator_type, lhs, rhs,
+                                     self->base.error_context, self->base.line);
 }
 
-static CbVariant* cb_ast_binary_node_eval_float(const CbAstBinaryNode* self,
-                                                const CbVariant* left,
-                                                const CbVariant* right)
+static bool cb_ast_binary_node_eval_operands(const CbAstBinaryNode* self,
+                                             const CbSymbolTable* symbols,
+                                             CbVariant* left,
+                                             CbVariant* right)
 {
-    CbFloatDataType v1;
-    CbFloatDataType v2;
-    CbVariant* result = NULL;
+    bool success = cb_ast_node_eval_value(self->base.left, symbols, left);
     
-    v1 = cb_numeric_as_float(left);
-    v2 = cb_numeric_as_float(right);
+    if (success)
+        success = cb_ast_node_eval_value(self->base.right, symbols, right);
+    else
+        *right = cb_variant_make();
     
-    switch (self->operator_type)
-    {
-        case CB_BINARY_OPERATOR_TYPE_ADD:
-            result = cb_float_create(v1 + v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_SUB:
-            result = cb_float_create(v1 - v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_MUL:
-            result = cb_float_create(v1 * v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_DIV:
-            if (v2 == 0.0)
-                cb_error_trigger(CB_ERROR_RUNTIME, self->base.line,
-                                 "Division by zero is not allowed");
-            else
-                result = cb_float_create(v1 / v2);
-            break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GT:
-            result = cb_boolean_create(v1 > v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GE:
-            result = cb_boolean_create((v1 > v2) || dequal(v1, v2)); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LT:
-            result = cb_boolean_create(v1 < v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LE:
-            result = cb_boolean_create((v1 < v2) || dequal(v1, v2)); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
-            result = cb_boolean_create(dequal(v1, v2)); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
-            result = cb_boolean_create(!dequal(v1, v2)); break;
-        
-        /* invalid binary operator type */
-        default: cb_abort("Invalid binary operator type"); break;
-    }
-    
-    return result;
+    return success;
 }
 
-static CbVariant* cb_ast_binary_node_eval_string(const CbAstBinaryNode* self,
-                                                 const CbVariant* left,
-                                                 const CbVariant* right)
+static bool cb_ast_binary_node_eval_integer(const CbAstBinaryNode* self,
+                                            const CbSymbolTable* symbols,
+                                            CbVariant* result)
 {
-    CbVariant* result = NULL;
+    CbVariant left;
+    CbVariant right;
+    CbIntegerDataType v1;
+    CbIntegerDataType v2;
+    bool success = cb_ast_binary_node_eval_operands(self, symbols, &left,
+                                                    &right);
     
-    switch (self->operator_type)
+    *result = cb_variant_make();
+    
+    if (success)
     {
-        case CB_BINARY_OPERATOR_TYPE_ADD:
-            result = cb_variant_copy(left);
-            cb_string_concat(result, right);
-            break;
+        v1 = cb_integer_get_value(&left);
+        v2 = cb_integer_get_value(&right);
         
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
-            result = cb_boolean_create(cb_string_lhs_equal(left, right)); break;
+        switch (self->operator_type)
+        {
+            case CB_BINARY_OPERATOR_TYPE_ADD:
+                *result = cb_integer_make(v1 + v2); break;
             
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
-            result = cb_boolean_create(cb_string_equal(left, right)); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
-            result = cb_boolean_create(!cb_string_equal(left, right)); break;
-        
-        /* invalid binary operator type */
-        default: cb_abort("Invalid binary operator type"); break;
+            case CB_BINARY_OPERATOR_TYPE_SUB:
+                *result = cb_integer_make(v1 - v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_MUL:
+                *result = cb_integer_make(v1 * v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_GT:
+                *result = cb_boolean_make(v1 > v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_GE:
+                *result = cb_boolean_make(v1 >= v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_LT:
+                *result = cb_boolean_make(v1 < v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_LE:
+                *result = cb_boolean_make(v1 <= v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+                *result = cb_boolean_make(v1 == v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+                *result = cb_boolean_make(v1 != v2); break;
+            
+            /* invalid binary operator type */
+            default: cb_abort("Invalid binary operator type"); break;
+        }
     }
     
-    
-    return result;
+    return success;
 }
 
-static CbVariant* cb_ast_binary_node_eval_boolean(const CbAstBinaryNode* self,
-                                                  const CbVariant* left,
-                                                  const CbVariant* right)
+static bool cb_ast_binary_node_eval_float(const CbAstBinaryNode* self,
+                                          const CbSymbolTable* symbols,
+                                          CbVariant* result)
 {
+    CbVariant left;
+    CbVariant right;
     CbFloatDataType v1;
     CbFloatDataType v2;
-    CbVariant* result = NULL;
+    bool success = cb_ast_binary_node_eval_operands(self, symbols, &left,
+                                                    &right);
     
-    v1 = cb_boolean_get_value(left);
-    v2 = cb_boolean_get_value(right);
+    *result = cb_variant_make();
     
-    switch (self->operator_type)
+    if (success)
     {
-        case CB_BINARY_OPERATOR_TYPE_LOGICAL_AND:
-            result = cb_boolean_create(v1 && v2); break;
+        v1 = cb_float_get_value(&left);
+        v2 = cb_float_get_value(&right);
         
-        case CB_BINARY_OPERATOR_TYPE_LOGICAL_OR:
-            result = cb_boolean_create(v1 || v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
-            result = cb_boolean_create(v1 == v2); break;
-        
-        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
-            result = cb_boolean_create(v1 != v2); break;
-        
-        /* invalid binary operator type */
-        default: cb_abort("Invalid binary operator type"); break;
+        /* NOTE: Same rules as cb_binary_operation_eval() */
+        switch (self->operator_type)
+        {
+            case CB_BINARY_OPERATOR_TYPE_ADD:
+                *result = cb_float_make(v1 + v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_SUB:
+                *result = cb_float_make(v1 - v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_MUL:
+                *result = cb_float_make(v1 * v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_DIV:
+                if (v2 == 0.0)
+                {
+                    cb_error_trigger(CB_ERROR_RUNTIME, self->base.line,
+                                     "Division by zero is not allowed");
+                    success = false;
+                }
+                else
+                    *result = cb_float_make(v1 / v2);
+                break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_GT:
+                *result = cb_boolean_make(v1 > v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_GE:
+                *result = cb_boolean_make((v1 > v2) || dequal(v1, v2)); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_LT:
+                *result = cb_boolean_make(v1 < v2); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_LE:
+                *result = cb_boolean_make((v1 < v2) || dequal(v1, v2)); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+                *result = cb_boolean_make(dequal(v1, v2)); break;
+            
+            case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+                *result = cb_boolean_make(!dequal(v1, v2)); break;
+            
+            /* invalid binary operator type */
+            default: cb_abort("Invalid binary operator type"); break;
+        }
     }
     
-    return result;
+    return success;
 }
 
-static bool cb_ast_binary_node_check_operation(const CbAstBinaryNode* self,
-                                               const CbVariantType lhs,
-                                               const CbVariantType rhs)
+static bool cb_ast_binary_node_eval_string(const CbAstBinaryNode* self,
+                                           const CbSymbolTable* symbols,
+                                           CbVariant* result)
 {
-    bool result = cb_variant_type_is_binary_operation_valid(self->operator_type,
-                                                            lhs, rhs);
-    if (!result)
+    CbVariant left;
+    CbVariant right;
+    bool success = cb_ast_binary_node_eval_operands(self, symbols, &left,
+                                                    &right);
+    
+    if (success)
     {
-        cb_error_trigger(
-            self->base.error_context, self->base.line,
-            "Invalid binary operation: <%s> %s <%s>",
-            cb_variant_type_stringify(lhs),
-            cb_binary_operator_type_stringify(self->operator_type),
-            cb_variant_type_stringify(rhs)
-        );
+        /* the left value is not used anymore -> append to it directly */
+        *result = left;
+        left    = cb_variant_make();
+        cb_string_concat(result, &right);
     }
+    else
+        *result = cb_variant_make();
     
-    return result;
+    cb_variant_release(&left);
+    cb_variant_release(&right);
+    
+    return success;
 }
@@ -11,6 +11,7 @@
 #define AST_BINARY_H
 
 #include "variant.h"
+#include "arena.h"
 
 
 /* -------------------------------------------------------------------------- */
@@ -23,20 +24,17 @@ typedef struct CbAstBinaryNode CbAstBinaryNode;
 /*
  * Constructor
  */
-CbAstBinaryNode* cb_ast_binary_node_create(CbBinaryOperatorType operator_type,
+CbAstBinaryNode* cb_ast_binary_node_create(CbArena* arena,
+                                           CbBinaryOperatorType operator_type,
                                            CbAstNode* left,
                                            CbAstNode* right);
 
-/*
- * Destructor
- */
-void cb_ast_binary_node_destroy(CbAstBinaryNode* self);
-
 /*
  * Evaluate binary node
  */
-CbVariant* cb_ast_binary_node_eval(const CbAstBinaryNode* self,
-                                   const CbSymbolTable* symbols);
+bool cb_ast_binary_node_eval(const CbAstBinaryNode* self,
+                             const CbSymbolTable* symbols,
+                             CbVariant* result);
 
 /*
  * Check semantics
@@ -44,6 +42,30 @@ CbVariant* cb_ast_binary_node_eval(const CbAstBinaryNode* self,
 bool cb_ast_binary_node_check_semantic(const CbAstBinaryNode* self,
                                        CbSymbolTable* symbols);
 
+/*
+ * Operator type (Getter)
+ */
+CbBinaryOperatorType cb_ast_binary_node_get_operator_type(const CbAstBinaryNode* self);
+
+/*
+ * Specialize the node for operands, whose types are known in advance (see
+ * optimizer.h). A specialized node evaluates its operation directly, without
+ * checking the operand types at runtime.
+ * Supported are integer and float arithmetic (except integer division, whose
+ * result type depends on the values) and comparisons, as well as string
+ * concatenation. Returns false, if the operation cannot be specialized.
+ * 
+ * NOTE: Both operands must be proven to be of the given operand type.
+ */
+bool cb_ast_binary_node_specialize(CbAstBinaryNode* self,
+                                   CbVariantType operand_type);
+
+/*
+ * Get the operand type of a specialized node
+ * (CB_VARIANT_TYPE_UNDEFINED, if the node is not specialized)
+ */
+CbVariantType cb_ast_binary_node_get_operand_type(const CbAstBinaryNode* self);
+
 /*
  * Get the variant type of a binary operation
  */
@@ -20,8 +20,8 @@ struct CbAstControlFlowNode
 /*
  * Constructor (Internal)
  */
-CbAstControlFlowNode* cb_ast_control_flow_node_create(CbAstControlFlowNodeType type,
-                                                      CbAstNodeDestructorFunc destructor_func,
+CbAstControlFlowNode* cb_ast_control_flow_node_create(CbArena* arena,
+                                                      CbAstControlFlowNodeType type,
                                                       CbAstNodeEvalFunc eval_func,
                                                       CbAstNodeSemanticFunc check_func,
                                                       CbAstNode* condition,
@@ -31,53 +31,61 @@ CbAstControlFlowNode* cb_ast_control_flow_node_create(CbAstControlFlowNodeType t
 
 /* -------------------------------------------------------------------------- */
 
-CbAstControlFlowNode* cb_ast_if_node_create(CbAstNode* condition,
+CbAstControlFlowNodeType cb_ast_control_flow_node_get_flow_type(const CbAstControlFlowNode* self)
+{
+    return self->flow_type;
+}
+
+const CbAstNode* cb_ast_control_flow_node_get_condition(const CbAstControlFlowNode* self)
+{
+    return self->condition;
+}
+
+void cb_ast_control_flow_node_set_condition(CbAstControlFlowNode* self,
+                                            CbAstNode* condition)
+{
+    self->condition = condition;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+CbAstControlFlowNode* cb_ast_if_node_create(CbArena* arena,
+                                            CbAstNode* condition,
                                             CbAstNode* true_branch,
                                             CbAstNode* false_branch)
 {
     return cb_ast_control_flow_node_create(
-        CB_AST_CONTROL_FLOW_TYPE_IF,
-        (CbAstNodeDestructorFunc) cb_ast_if_node_destroy,
+        arena, CB_AST_CONTROL_FLOW_TYPE_IF,
         (CbAstNodeEvalFunc) cb_ast_if_node_eval,
         (CbAstNodeSemanticFunc) cb_ast_if_node_check_semantic,
         condition, true_branch, false_branch
     );
 }
 
-void cb_ast_if_node_destroy(CbAstControlFlowNode* self)
-{
-    /* destroy condition node */
-    cb_ast_node_destroy(self->condition);
-    
-    /*
-     * Destroy both child nodes
-     * NOTE: Child nodes can be NULL. For example consider the following if:
-     *    if True then
-     *       // do stuff
-     *    endif,
-     * The statement does not contain an else-branch, which is - in this case -
-     * NULL.
-     */
-    if (self->base.left  != NULL) cb_ast_node_destroy(self->base.left);
-    if (self->base.right != NULL) cb_ast_node_destroy(self->base.right);
-    
-    memfree(self);
-}
-
-CbVariant* cb_ast_if_node_eval(const CbAstControlFlowNode* self,
-                               const CbSymbolTable* symbols)
+bool cb_ast_if_node_eval(const CbAstControlFlowNode* self,
+                         const CbSymbolTable* symbols,
+                         CbVariant* result)
 {
-    CbVariant* result   = NULL;
-    CbVariant* decision = cb_ast_node_eval(self->condition, symbols);
+    bool success;
+    CbVariant decision;
     
-    if (cb_boolean_get_value(decision))
-        result = cb_ast_node_safe_eval(self->base.left, symbols);
+    success = cb_ast_node_eval_value(self->condition, symbols, &decision);
+    if (success)
+    {
+        if (cb_boolean_get_value(&decision))
+            success = cb_ast_node_safe_eval_value(self->base.left, symbols,
+                                                  result);
+        else
+            success = cb_ast_node_safe_eval_value(self->base.right, symbols,
+                                                  result);
+    }
     else
-        result = cb_ast_node_safe_eval(self->base.right, symbols);
+        *result = cb_variant_make();
     
-    cb_variant_destroy(decision);
+    cb_variant_release(&decision);
     
-    return result;
+    return success;
 }
 
 bool cb_ast_if_node_check_semantic(const CbAstControlFlowNode* self,
@@ -107,53 +115,42 @@ bool cb_ast_if_node_check_semantic(const CbAstControlFlowNode* self,
 
 /* -------------------------------------------------------------------------- */
 
-CbAstControlFlowNode* cb_ast_while_node_create(CbAstNode* condition,
+CbAstControlFlowNode* cb_ast_while_node_create(CbArena* arena,
+                                               CbAstNode* condition,
                                                CbAstNode* body)
 {
     
     return cb_ast_control_flow_node_create(
-        CB_AST_CONTROL_FLOW_TYPE_WHILE,
-        (CbAstNodeDestructorFunc) cb_ast_while_node_destroy,
+        arena, CB_AST_CONTROL_FLOW_TYPE_WHILE,
         (CbAstNodeEvalFunc) cb_ast_while_node_eval,
         (CbAstNodeSemanticFunc) cb_ast_while_node_check_semantic,
         condition, body, NULL
     );
 }
 
-void cb_ast_while_node_destroy(CbAstControlFlowNode* self)
+bool cb_ast_while_node_eval(const CbAstControlFlowNode* self,
+                            const CbSymbolTable* symbols,
+                            CbVariant* result)
 {
-    /* destroy condition node */
-    cb_ast_node_destroy(self->condition);
+    bool success      = true;
+    bool execute_body = true;
+    CbVariant condition;
     
-    /* destroy left child node */
-    cb_ast_node_destroy(self->base.left);
+    *result = cb_variant_make();
     
-    memfree(self);
-}
-
-CbVariant* cb_ast_while_node_eval(const CbAstControlFlowNode* self,
-                                  const CbSymbolTable* symbols)
-{
-    CbVariant* result   = NULL;
-    bool execute_body   = true;
-    
-    while (execute_body)
+    while (success && execute_body)
     {
-        CbVariant* condition = cb_ast_node_eval(self->condition, symbols);
-        execute_body         = cb_boolean_get_value(condition);
-        cb_variant_destroy(condition);
-        if (execute_body)
-        {
-            if (result != NULL)
-                cb_variant_destroy(result);
-            
-            result = cb_ast_node_eval(self->base.left, symbols);
-        }
-        else
-            result = cb_variant_create();
+        success = cb_ast_node_eval_value(self->condition, symbols, &condition);
+        if (success)
+            execute_body = cb_boolean_get_value(&condition);
+        cb_variant_release(&condition);
+        
+        /* a while-statement always yields an undefined value */
+        if (success && execute_body)
+            success = cb_ast_node_exec(self->base.left, symbols);
     }
     
-    return result;
+    return success;
 }
 
 bool cb_ast_while_node_check_semantic(const CbAstControlFlowNode* self,
@@ -182,18 +179,18 @@ bool cb_ast_while_node_check_semantic(const CbAstControlFlowNode* self,
 
 /* -------------------------------------------------------------------------- */
 
-CbAstControlFlowNode* cb_ast_control_flow_node_create(CbAstControlFlowNodeType type,
-                                                      CbAstNodeDestructorFunc destructor_func,
+CbAstControlFlowNode* cb_ast_control_flow_node_create(CbArena* arena,
+                                                      CbAstControlFlowNodeType type,
                                                       CbAstNodeEvalFunc eval_func,
                                                       CbAstNodeSemanticFunc semantic_func,
                                                       CbAstNode* condition,
                                                       CbAstNode* left,
                                                       CbAstNode* right)
 {
-    CbAstControlFlowNode* self = (CbAstControlFlowNode*) memalloc(sizeof(CbAstControlFlowNode));
+    CbAstControlFlowNode* self = cb_arena_alloc(arena, sizeof(CbAstControlFlowNode));
     cb_ast_node_init(
-        &self->base, CB_AST_TYPE_CONTROL_FLOW, left, right, destructor_func,
-        eval_func, semantic_func
+        &self->base, CB_AST_TYPE_CONTROL_FLOW, left, right, eval_func,
+        semantic_func
     );
     
     self->flow_type = type;
@@ -13,6 +13,7 @@
 #define AST_CONTROL_FLOW_H
 
 #include "ast.h"
+#include "arena.h"
 
 
 /* -------------------------------------------------------------------------- */
@@ -29,22 +30,38 @@ typedef enum
 /* -------------------------------------------------------------------------- */
 
 /*
- * Constructor for an if-statement
+ * Control flow type (Getter)
  */
-CbAstControlFlowNode* cb_ast_if_node_create(CbAstNode* condition,
-                                            CbAstNode* true_branch,
-                                            CbAstNode* false_branch);
+CbAstControlFlowNodeType cb_ast_control_flow_node_get_flow_type(const CbAstControlFlowNode* self);
 
 /*
- * Destructor for an if-statement
+ * Condition node (Getter)
  */
-void cb_ast_if_node_destroy(CbAstControlFlowNode* self);
+const CbAstNode* cb_ast_control_flow_node_get_condition(const CbAstControlFlowNode* self);
+
+/*
+ * Condition node (Setter)
+ */
+void cb_ast_control_flow_node_set_condition(CbAstControlFlowNode* self,
+                                            CbAstNode* condition);
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Constructor for an if-statement
+ */
+CbAstControlFlowNode* cb_ast_if_node_create(CbArena* arena,
+                                            CbAstNode* condition,
+                                            CbAstNode* true_branch,
+                                            CbAstNode* false_branch);
 
 /*
  * Evaluate an if-statement
  */
-CbVariant* cb_ast_if_node_eval(const CbAstControlFlowNode* self,
-                               const CbSymbolTable* symbols);
+bool cb_ast_if_node_eval(const CbAstControlFlowNode* self,
+                         const CbSymbolTable* symbols,
+                         CbVariant* result);
 
 /*
  * Check semantics for an if-statement
@@ -58,19 +75,16 @@ bool cb_ast_if_node_check_semantic(const CbAstControlFlowNode* self,
 /*
  * Constructor for a while-statement
  */
-CbAstControlFlowNode* cb_ast_while_node_create(CbAstNode* condition,
+CbAstControlFlowNode* cb_ast_while_node_create(CbArena* arena,
+                                               CbAstNode* condition,
                                                CbAstNode* body);
 
-/*
- * Destructor for a while-statement
- */
-void cb_ast_while_node_destroy(CbAstControlFlowNode* self);
-    
 /*
  * Evaluate a while-statement
  */
-CbVariant* cb_ast_while_node_eval(const CbAstControlFlowNode* self,
-                                  const CbSymbolTable* symbols);
+bool cb_ast_while_node_eval(const CbAstControlFlowNode* self,
+                            const CbSymbolTable* symbols,
+                            CbVariant* result);
 
 /*
  * Check semantics for a while-statement
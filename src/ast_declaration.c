@@ -1,6 +1,7 @@
 #include "utils.h"
 #include "cb_utils.h"
 #include "error_handling.h"
+#include "intern.h"
 #include "symbol_variable.h"
 #include "symbol_function.h"
 #include "ast_internal.h"
@@ -13,37 +14,43 @@ struct CbAstDeclarationNode
 {
     CbAstNode base;
     CbAstDeclarationType type;
-    char* identifier;
+    const char* identifier; /* interned (see intern.h) */
 };
 
 
 /* -------------------------------------------------------------------------- */
 
-CbAstDeclarationNode* cb_ast_declaration_node_create(CbAstDeclarationType type,
+CbAstDeclarationNode* cb_ast_declaration_node_create(CbArena* arena,
+                                                     CbAstDeclarationType type,
                                                      const char* identifier)
 {
-    CbAstDeclarationNode* self = (CbAstDeclarationNode*) memalloc(sizeof(CbAstDeclarationNode));
+    CbAstDeclarationNode* self = cb_arena_alloc(arena, sizeof(CbAstDeclarationNode));
     cb_ast_node_init(
         &self->base, CB_AST_TYPE_DECLARATION, NULL, NULL,
-        (CbAstNodeDestructorFunc) cb_ast_declaration_node_destroy,
         (CbAstNodeEvalFunc)       cb_ast_declaration_node_eval,
         (CbAstNodeSemanticFunc)   cb_ast_declaration_node_check_semantic
     );
     
+    cb_intern_assert(identifier);
     self->type       = type;
-    self->identifier = strdup(identifier);
+    self->identifier = identifier;
     
     return self;
 }
 
-void cb_ast_declaration_node_destroy(CbAstDeclarationNode* self)
+const char* cb_ast_declaration_node_get_identifier(const CbAstDeclarationNode* self)
 {
-    memfree(self->identifier);
-    memfree(self);
+    return self->identifier;
 }
 
-CbVariant* cb_ast_declaration_node_eval(const CbAstDeclarationNode* self,
-                                        const CbSymbolTable* symbols)
+CbAstDeclarationType cb_ast_declaration_node_get_declaration_type(const CbAstDeclarationNode* self)
+{
+    return self->type;
+}
+
+bool cb_ast_declaration_node_eval(const CbAstDeclarationNode* self,
+                                  const CbSymbolTable* symbols,
+                                  CbVariant* result)
 {
     /*
      * NOTE: The symbol was already declared during the semantic check.
@@ -56,13 +63,14 @@ CbVariant* cb_ast_declaration_node_eval(const CbAstDeclarationNode* self,
      *       doing a semantic check.
      */
     
-    return cb_variant_create();
+    *result = cb_variant_make();
+    return true;
 }
 
 bool cb_ast_declaration_node_check_semantic(const CbAstDeclarationNode* self,
                                             CbSymbolTable* symbols)
 {
-    CbSymbol* symbol = cb_symbol_table_lookup(symbols, self->identifier);
+    CbSymbol* symbol = cb_symbol_table_lookup_interned(symbols, self->identifier);
     
     /*
      * There should not be a symbol with the same identifier yet!
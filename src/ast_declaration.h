@@ -10,6 +10,7 @@
 
 #include "variant.h"
 #include "symbol_table.h"
+#include "arena.h"
 
 
 /**
@@ -35,18 +36,30 @@ typedef enum CbAstDeclarationType
  * @memberof CbAstDeclarationNode
  * @brief    Create a CbAstDeclarationNode object.
  * 
- * @param identifier The name of the symbol to be declared
+ * @param arena      The arena, that owns the node
+ * @param type       The kind of symbol to be declared
+ * @param identifier The name of the symbol to be declared (interned, see
+ *                   intern.h)
  */
-CbAstDeclarationNode* cb_ast_declaration_node_create(CbAstDeclarationType type,
+CbAstDeclarationNode* cb_ast_declaration_node_create(CbArena* arena,
+                                                     CbAstDeclarationType type,
                                                      const char* identifier);
 
 /**
  * @memberof CbAstDeclarationNode
- * @brief    Destroy a CbAstDeclarationNode object.
+ * @brief    Get the name of the declared symbol.
  * 
  * @param self The CbAstDeclarationNode instance
  */
-void cb_ast_declaration_node_destroy(CbAstDeclarationNode* self);
+const char* cb_ast_declaration_node_get_identifier(const CbAstDeclarationNode* self);
+
+/**
+ * @memberof CbAstDeclarationNode
+ * @brief    Get the declaration type.
+ * 
+ * @param self The CbAstDeclarationNode instance
+ */
+CbAstDeclarationType cb_ast_declaration_node_get_declaration_type(const CbAstDeclarationNode* self);
 
 /**
  * @memberof CbAstDeclarationNode
@@ -54,9 +67,11 @@ void cb_ast_declaration_node_destroy(CbAstDeclarationNode* self);
  * 
  * @param self    The CbAstDeclarationNode instance
  * @param symbols The symbol-table
+ * @param result  Receives the (undefined) result
  */
-CbVariant* cb_ast_declaration_node_eval(const CbAstDeclarationNode* self,
-                                        const CbSymbolTable* symbols);
+bool cb_ast_declaration_node_eval(const CbAstDeclarationNode* self,
+                                  const CbSymbolTable* symbols,
+                                  CbVariant* result);
 
 /**
  * @memberof CbAstDeclarationNode
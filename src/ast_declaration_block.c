@@ -1,7 +1,8 @@
+#include <string.h>
+
 #include "utils.h"
 #include "cb_utils.h"
 #include "error_handling.h"
-#include "vector.h"
 #include "symbol_table.h"
 #include "ast_internal.h"
 #include "ast_declaration_block.h"
@@ -12,70 +13,57 @@
 struct CbAstDeclarationBlockNode
 {
     CbAstNode base;
-    Vector* declarations;
+    CbArena* arena; /* owns the declaration list */
+    CbAstDeclarationNode** declarations;
+    size_t count;
+    size_t capacity;
 };
 
+static const size_t CB_AST_DECLARATION_BLOCK_INITIAL_CAPACITY = 4;
+
 
 /* -------------------------------------------------------------------------- */
 
-CbAstDeclarationBlockNode* cb_ast_declaration_block_node_create()
+CbAstDeclarationBlockNode* cb_ast_declaration_block_node_create(CbArena* arena)
 {
-    CbAstDeclarationBlockNode* self = memalloc(sizeof(CbAstDeclarationBlockNode));
+    CbAstDeclarationBlockNode* self = cb_arena_alloc(arena, sizeof(CbAstDeclarationBlockNode));
     cb_ast_node_init(
         &self->base, CB_AST_TYPE_DECLARATION_BLOCK, NULL, NULL,
-        (CbAstNodeDestructorFunc) cb_ast_declaration_block_node_destroy,
         (CbAstNodeEvalFunc)       cb_ast_declaration_block_node_eval,
         (CbAstNodeSemanticFunc)   cb_ast_declaration_block_node_check_semantic
     );
     
-    self->declarations = vector_create();
+    self->arena        = arena;
+    self->count        = 0;
+    self->capacity     = CB_AST_DECLARATION_BLOCK_INITIAL_CAPACITY;
+    self->declarations = cb_arena_alloc(arena, self->capacity *
+                                        sizeof(CbAstDeclarationNode*));
     
     return self;
 }
 
-void cb_ast_declaration_block_node_destroy(CbAstDeclarationBlockNode* self)
-{
-    size_t i;
-    size_t size = vector_get_count(self->declarations);
-    for (i = 0; i < size; i++)
-    {
-        CbAstDeclarationNode* node = NULL;
-        cb_assert(
-            vector_get(self->declarations, i, (VectorItem*) &node)
-        );
-        cb_ast_declaration_node_destroy(node);
-    }
-    
-    vector_destroy(self->declarations);
-    memfree(self);
-}
-
-CbVariant* cb_ast_declaration_block_node_eval(const CbAstDeclarationBlockNode* self,
-                                              const CbSymbolTable* symbols)
+bool cb_ast_declaration_block_node_eval(const CbAstDeclarationBlockNode* self,
+                                        const CbSymbolTable* symbols,
+                                        CbVariant* result)
 {
     /*
      * NOTE: The variables were already declared during the semantic check.
      *       -> No further action requiered.
      */
     
-    return cb_variant_create();
+    *result = cb_variant_make();
+    return true;
 }
 
 bool cb_ast_declaration_block_node_check_semantic(const CbAstDeclarationBlockNode* self,
                                                   CbSymbolTable* symbols)
 {
     size_t i;
-    size_t size = vector_get_count(self->declarations);
     bool result = true;
     
-    for (i = 0; result && i < size; i++)
-    {
-        CbAstDeclarationNode* node = NULL;
-        cb_assert(
-            vector_get(self->declarations, i, (VectorItem*) &node)
-        );
-        result = cb_ast_declaration_node_check_semantic(node, symbols);
-    }
+    for (i = 0; result && i < self->count; i++)
+        result = cb_ast_declaration_node_check_semantic(self->declarations[i],
+                                                        symbols);
     
     return result;
 }
@@ -83,5 +71,31 @@ bool cb_ast_declaration_block_node_check_semantic(const CbAstDeclarationBlockNod
 void cb_ast_declaration_block_node_add(CbAstDeclarationBlockNode* self,
                                        CbAstDeclarationNode* node)
 {
-    vector_append(self->declarations, node);
+    CbAstDeclarationNode** declarations;
+    
+    /* NOTE: The old list is not freed, it is released with the arena. */
+    if (self->count == self->capacity)
+    {
+        declarations = cb_arena_alloc(self->arena, 2 * self->capacity *
+                                      sizeof(CbAstDeclarationNode*));
+        memcpy(declarations, self->declarations,
+               self->count * sizeof(CbAstDeclarationNode*));
+        
+        self->declarations  = declarations;
+        self->capacity     *= 2;
+    }
+    
+    self->declarations[self->count++] = node;
+}
+
+size_t cb_ast_declaration_block_node_get_count(const CbAstDeclarationBlockNode* self)
+{
+    return self->count;
+}
+
+const CbAstDeclarationNode* cb_ast_declaration_block_node_get(const CbAstDeclarationBlockNode* self,
+                                                              size_t index)
+{
+    cb_assert(index < self->count);
+    return self->declarations[index];
 }
@@ -9,6 +9,7 @@
 #define AST_DECLARATION_BLOCK_H
 
 #include "ast_declaration.h"
+#include "arena.h"
 
 
 /**
@@ -24,16 +25,10 @@ typedef struct CbAstDeclarationBlockNode CbAstDeclarationBlockNode;
 /**
  * @memberof CbAstDeclarationBlockNode
  * @brief    Create a CbAstDeclarationBlockNode object.
- */
-CbAstDeclarationBlockNode* cb_ast_declaration_block_node_create();
-
-/**
- * @memberof CbAstDeclarationBlockNode
- * @brief    Destroy a CbAstDeclarationBlockNode object.
  * 
- * @param self The CbAstDeclarationBlockNode instance
+ * @param arena The arena, that owns the node and its declaration list
  */
-void cb_ast_declaration_block_node_destroy(CbAstDeclarationBlockNode* self);
+CbAstDeclarationBlockNode* cb_ast_declaration_block_node_create(CbArena* arena);
 
 /**
  * @memberof CbAstDeclarationBlockNode
@@ -41,9 +36,11 @@ void cb_ast_declaration_block_node_destroy(CbAstDeclarationBlockNode* self);
  * 
  * @param self    The CbAstDeclarationBlockNode instance
  * @param symbols The symbol-table
+ * @param result  Receives the (undefined) result
  */
-CbVariant* cb_ast_declaration_block_node_eval(const CbAstDeclarationBlockNode* self,
-                                              const CbSymbolTable* symbols);
+bool cb_ast_declaration_block_node_eval(const CbAstDeclarationBlockNode* self,
+                                        const CbSymbolTable* symbols,
+                                        CbVariant* result);
 
 /**
  * @memberof CbAstDeclarationBlockNode
@@ -65,5 +62,23 @@ bool cb_ast_declaration_block_node_check_semantic(const CbAstDeclarationBlockNod
 void cb_ast_declaration_block_node_add(CbAstDeclarationBlockNode* self,
                                        CbAstDeclarationNode* node);
 
+/**
+ * @memberof CbAstDeclarationBlockNode
+ * @brief    Get the number of declarations in the block.
+ * 
+ * @param self The CbAstDeclarationBlockNode instance
+ */
+size_t cb_ast_declaration_block_node_get_count(const CbAstDeclarationBlockNode* self);
+
+/**
+ * @memberof CbAstDeclarationBlockNode
+ * @brief    Get a declaration node from the internal declaration list.
+ * 
+ * @param self  The CbAstDeclarationBlockNode instance
+ * @param index Index of the declaration node
+ */
+const CbAstDeclarationNode* cb_ast_declaration_block_node_get(const CbAstDeclarationBlockNode* self,
+                                                              size_t index);
+
 
 #endif /* AST_DECLARATION_BLOCK_H */
@@ -15,9 +15,9 @@
 
 /* -------------------------------------------------------------------------- */
 
-typedef void       (*CbAstNodeDestructorFunc) (CbAstNode*);
-typedef CbVariant* (*CbAstNodeEvalFunc)       (const CbAstNode*,
-                                               const CbSymbolTable*);
+typedef bool       (*CbAstNodeEvalFunc)       (const CbAstNode*,
+                                               const CbSymbolTable*,
+                                               CbVariant*);
 typedef bool       (*CbAstNodeSemanticFunc)   (const CbAstNode*,
                                                CbSymbolTable*);
 
@@ -30,7 +30,6 @@ struct CbAstNode
     struct CbAstNode* left;
     struct CbAstNode* right;
     
-    CbAstNodeDestructorFunc destructor;
     CbAstNodeEvalFunc eval;
     CbAstNodeSemanticFunc semantic_check;
 };
@@ -45,7 +44,6 @@ void cb_ast_node_init(CbAstNode* self,
                       CbAstType type,
                       CbAstNode* left_node,
                       CbAstNode* right_node,
-                      CbAstNodeDestructorFunc destructor,
                       CbAstNodeEvalFunc eval,
                       CbAstNodeSemanticFunc semantic_check);
 
@@ -0,0 +1,134 @@
+#include "utils.h"
+#include "cb_utils.h"
+#include "error_handling.h"
+#include "operation.h"
+#include "ast_internal.h"
+#include "ast_logical.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+struct CbAstLogicalNode
+{
+    CbAstNode base;
+    CbBinaryOperatorType operator_type;
+};
+
+/*
+ * Check if the value of the left operand already determines the result
+ * ("False and ..." or "True or ...").
+ */
+static bool cb_ast_logical_node_is_short_circuit(const CbAstLogicalNode* self,
+                                                 const CbVariant* left);
+
+
+/* -------------------------------------------------------------------------- */
+
+CbAstLogicalNode* cb_ast_logical_node_create(CbArena* arena,
+                                             CbBinaryOperatorType operator_type,
+                                             CbAstNode* left,
+                                             CbAstNode* right)
+{
+    CbAstLogicalNode* self = cb_arena_alloc(arena, sizeof(CbAstLogicalNode));
+    
+    cb_assert(operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_AND ||
+              operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_OR);
+    
+    cb_ast_node_init(
+        &self->base, CB_AST_TYPE_LOGICAL, left, right,
+        (CbAstNodeEvalFunc)       cb_ast_logical_node_eval,
+        (CbAstNodeSemanticFunc)   cb_ast_logical_node_check_semantic
+    );
+    self->operator_type = operator_type;
+    
+    return self;
+}
+
+bool cb_ast_logical_node_eval(const CbAstLogicalNode* self,
+                              const CbSymbolTable* symbols,
+                              CbVariant* result)
+{
+    bool success = false;
+    CbVariant left;
+    CbVariant right;
+    
+    *result = cb_variant_make();
+    
+    if (cb_ast_node_eval_value(self->base.left, symbols, &left))
+    {
+        /*
+         * The result is the (boolean) value of the left operand, if it
+         * determines the result on its own. Otherwise the operation is
+         * evaluated like any other binary operation, so invalid operand types
+         * are still reported.
+         */
+        if (!cb_ast_logical_node_is_branch_free(self) &&
+            cb_ast_logical_node_is_short_circuit(self, &left))
+        {
+            /* move the value of the left operand into the result */
+            *result = left;
+            left    = cb_variant_make();
+            success = true;
+        }
+        else
+        {
+            if (cb_ast_node_eval_value(self->base.right, symbols, &right))
+                success = cb_binary_operation_eval(self->operator_type, &left,
+                                                   &right, self->base.line,
+                                                   result);
+            
+            cb_variant_release(&right);
+        }
+    }
+    
+    cb_variant_release(&left);
+    
+    return success;
+}
+
+bool cb_ast_logical_node_check_semantic(const CbAstLogicalNode* self,
+                                        CbSymbolTable* symbols)
+{
+    /* check semantic of both child nodes, regardless of short-circuiting */
+    bool result = cb_ast_node_check_semantic(self->base.left, symbols) &&
+                  cb_ast_node_check_semantic(self->base.right, symbols);
+    /* also, make sure both operands are of type boolean */
+    if (result)
+    {
+        result = cb_binary_operation_check(
+            self->operator_type,
+            cb_ast_node_get_expression_type(self->base.left),
+            cb_ast_node_get_expression_type(self->base.right),
+            self->base.error_context, self->base.line
+        );
+    }
+    
+    return result;
+}
+
+CbBinaryOperatorType cb_ast_logical_node_get_operator_type(const CbAstLogicalNode* self)
+{
+    return self->operator_type;
+}
+
+bool cb_ast_logical_node_is_branch_free(const CbAstLogicalNode* self)
+{
+    CbAstType type = cb_ast_node_get_type(self->base.right);
+    return type == CB_AST_TYPE_VALUE || type == CB_AST_TYPE_VARIABLE;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static bool cb_ast_logical_node_is_short_circuit(const CbAstLogicalNode* self,
+                                                 const CbVariant* left)
+{
+    bool result = false;
+    
+    if (cb_variant_is_boolean(left))
+        result = cb_boolean_get_value(left) ?
+                 self->operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_OR :
+                 self->operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_AND;
+    
+    return result;
+}
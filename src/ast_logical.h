@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Abstract syntax tree node: Logical
+ * Representation of a logical operation ("and", "or"), which is evaluated with
+ * short-circuit semantics: The right operand is only evaluated, if the value
+ * of the left operand does not already determine the result.
+ * 
+ * Inherites from CbAstNode
+ ******************************************************************************/
+
+#ifndef AST_LOGICAL_H
+#define AST_LOGICAL_H
+
+#include "variant.h"
+#include "arena.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+typedef struct CbAstLogicalNode CbAstLogicalNode;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Constructor
+ * NOTE: Only CB_BINARY_OPERATOR_TYPE_LOGICAL_AND and
+ *       CB_BINARY_OPERATOR_TYPE_LOGICAL_OR are valid operator types.
+ */
+CbAstLogicalNode* cb_ast_logical_node_create(CbArena* arena,
+                                             CbBinaryOperatorType operator_type,
+                                             CbAstNode* left,
+                                             CbAstNode* right);
+
+/*
+ * Evaluate logical node
+ */
+bool cb_ast_logical_node_eval(const CbAstLogicalNode* self,
+                              const CbSymbolTable* symbols,
+                              CbVariant* result);
+
+/*
+ * Check semantics: Both operands are checked, even though the right operand
+ * might not be evaluated at runtime.
+ */
+bool cb_ast_logical_node_check_semantic(const CbAstLogicalNode* self,
+                                        CbSymbolTable* symbols);
+
+/*
+ * Operator type (Getter)
+ */
+CbBinaryOperatorType cb_ast_logical_node_get_operator_type(const CbAstLogicalNode* self);
+
+/*
+ * Check if the right operand is cheap enough to be evaluated unconditionally
+ * (a value or a variable). In this case there is nothing to gain from
+ * skipping it, so both operands can be combined without a branch.
+ */
+bool cb_ast_logical_node_is_branch_free(const CbAstLogicalNode* self);
+
+
+#endif /* AST_LOGICAL_H */
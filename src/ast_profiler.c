@@ -0,0 +1,349 @@
+/* clock_gettime() is POSIX */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "utils.h"
+#include "cb_utils.h"
+
+#include "ast_internal.h"
+#include "ast_statement_list.h"
+#include "ast_control_flow.h"
+#include "ast_profiler.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Profile of a single node
+ * NOTE: Type and line are copied, so the report does not depend on the AST.
+ */
+typedef struct CbAstProfilerEntry
+{
+    const CbAstNode* node;
+    CbAstNodeEvalFunc eval; /* original eval function of the node */
+    CbAstType type;
+    int line;
+    size_t count;
+    double inclusive; /* seconds */
+    double exclusive; /* seconds */
+} CbAstProfilerEntry;
+
+struct CbAstProfiler
+{
+    CbAstProfilerEntry* entries; /* sorted by node address, once attached */
+    size_t count;
+    size_t capacity;
+    double children; /* time spent in child nodes of the current node */
+    bool attached;
+};
+
+static const size_t CB_AST_PROFILER_INITIAL_CAPACITY = 64;
+
+/* names of the node types (see CbAstType) */
+static const char* const CB_AST_PROFILER_TYPE_NAMES[] = {
+    "none",
+    "value",
+    "binary",
+    "unary",
+    "variable",
+    "assignment",
+    "declaration",
+    "declaration_block",
+    "statement_list",
+    "control_flow",
+    "comparison",
+    "logical"
+};
+
+/*
+ * Profiler attached in the current thread: The instrumented eval function has
+ * the same signature as the original ones and finds its profiler here.
+ */
+static CB_THREAD_LOCAL CbAstProfiler* cb_ast_profiler_active = NULL;
+
+/*
+ * Register a node and all of its child nodes.
+ */
+static void cb_ast_profiler_add(CbAstProfiler* self, CbAstNode* node);
+
+/*
+ * Find the entry of a node (binary search).
+ */
+static CbAstProfilerEntry* cb_ast_profiler_find(const CbAstProfiler* self,
+                                                const CbAstNode* node);
+
+/*
+ * Instrumented eval function: Evaluate a node using its original eval
+ * function and measure the time spent.
+ */
+static bool cb_ast_profiler_eval(const CbAstNode* node,
+                                 const CbSymbolTable* symbols,
+                                 CbVariant* result);
+
+/*
+ * Current time in seconds (monotonic clock)
+ */
+static double cb_ast_profiler_now();
+
+/*
+ * Comparison functions for qsort() and bsearch()
+ */
+static int cb_ast_profiler_compare_node(const void* a, const void* b);
+static int cb_ast_profiler_compare_location(const void* a, const void* b);
+static int cb_ast_profiler_compare_exclusive(const void* a, const void* b);
+
+
+/* -------------------------------------------------------------------------- */
+
+CbAstProfiler* cb_ast_profiler_create()
+{
+    CbAstProfiler* self = memalloc(sizeof(CbAstProfiler));
+    
+    self->count    = 0;
+    self->capacity = CB_AST_PROFILER_INITIAL_CAPACITY;
+    self->entries  = memalloc(self->capacity * sizeof(CbAstProfilerEntry));
+    self->children = 0.0;
+    self->attached = false;
+    
+    return self;
+}
+
+void cb_ast_profiler_destroy(CbAstProfiler* self)
+{
+    cb_assert(!self->attached);
+    
+    memfree(self->entries);
+    memfree(self);
+}
+
+void cb_ast_profiler_attach(CbAstProfiler* self, CbAstNode* ast)
+{
+    cb_assert(!self->attached);
+    cb_assert(cb_ast_profiler_active == NULL);
+    
+    cb_ast_profiler_add(self, ast);
+    qsort(self->entries, self->count, sizeof(CbAstProfilerEntry),
+          cb_ast_profiler_compare_node);
+    
+    self->attached         = true;
+    cb_ast_profiler_active = self;
+}
+
+void cb_ast_profiler_detach(CbAstProfiler* self)
+{
+    size_t i;
+    
+    cb_assert(self->attached);
+    
+    for (i = 0; i < self->count; i++)
+        ((CbAstNode*) self->entries[i].node)->eval = self->entries[i].eval;
+    
+    self->attached         = false;
+    cb_ast_profiler_active = NULL;
+}
+
+size_t cb_ast_profiler_get_count(const CbAstProfiler* self,
+                                 int line,
+                                 CbAstType type)
+{
+    size_t i;
+    size_t result = 0;
+    
+    for (i = 0; i < self->count; i++)
+    {
+        if (self->entries[i].line == line && self->entries[i].type == type)
+            result += self->entries[i].count;
+    }
+    
+    return result;
+}
+
+void cb_ast_profiler_report(const CbAstProfiler* self,
+                            CbAstProfilerFormat format,
+                            FILE* output)
+{
+    size_t i;
+    size_t spot_count = 0;
+    double total      = 0.0;
+    CbAstProfilerEntry* spot;
+    CbAstProfilerEntry* spots =
+        memalloc((self->count + 1) * sizeof(CbAstProfilerEntry));
+    
+    /* merge the entries of each line and node type into a hot spot */
+    memcpy(spots, self->entries, self->count * sizeof(CbAstProfilerEntry));
+    qsort(spots, self->count, sizeof(CbAstProfilerEntry),
+          cb_ast_profiler_compare_location);
+    for (i = 0; i < self->count; i++)
+    {
+        if (spots[i].count == 0)
+            continue;
+        
+        spot = (spot_count > 0) ? &spots[spot_count - 1] : NULL;
+        if (spot != NULL && spot->line == spots[i].line &&
+            spot->type == spots[i].type)
+        {
+            spot->count     += spots[i].count;
+            spot->inclusive += spots[i].inclusive;
+            spot->exclusive += spots[i].exclusive;
+        }
+        else
+            spots[spot_count++] = spots[i];
+        total += spots[i].exclusive;
+    }
+    qsort(spots, spot_count, sizeof(CbAstProfilerEntry),
+          cb_ast_profiler_compare_exclusive);
+    
+    if (format == CB_AST_PROFILER_FORMAT_CSV)
+        fprintf(output, "line,kind,count,inclusive_ns,exclusive_ns\n");
+    else
+        fprintf(output, "%6s  %-18s %12s %14s %14s %7s\n", "line", "kind",
+                "count", "inclusive [us]", "exclusive [us]", "excl.");
+    
+    for (i = 0; i < spot_count; i++)
+    {
+        spot = &spots[i];
+        if (format == CB_AST_PROFILER_FORMAT_CSV)
+            fprintf(output, "%d,%s,%lu,%.0f,%.0f\n", spot->line,
+                    CB_AST_PROFILER_TYPE_NAMES[spot->type],
+                    (unsigned long) spot->count,
+                    spot->inclusive * 1e9, spot->exclusive * 1e9);
+        else
+            fprintf(output, "%6d  %-18s %12lu %14.1f %14.1f %6.1f%%\n",
+                    spot->line, CB_AST_PROFILER_TYPE_NAMES[spot->type],
+                    (unsigned long) spot->count,
+                    spot->inclusive * 1e6, spot->exclusive * 1e6,
+                    total > 0.0 ? spot->exclusive / total * 100.0 : 0.0);
+    }
+    
+    memfree(spots);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void cb_ast_profiler_add(CbAstProfiler* self, CbAstNode* node)
+{
+    size_t i;
+    CbAstProfilerEntry* entry;
+    const CbAstStatementListNode* list;
+    
+    /* nodes, that are referenced more than once, are registered only once */
+    if (node == NULL || node->eval == cb_ast_profiler_eval)
+        return;
+    
+    if (self->count == self->capacity)
+    {
+        self->capacity *= 2;
+        self->entries   = memrealloc(self->entries, self->capacity *
+                                     sizeof(CbAstProfilerEntry));
+    }
+    
+    entry            = &self->entries[self->count++];
+    entry->node      = node;
+    entry->eval      = node->eval;
+    entry->type      = node->type;
+    entry->line      = node->line;
+    entry->count     = 0;
+    entry->inclusive = 0.0;
+    entry->exclusive = 0.0;
+    node->eval       = cb_ast_profiler_eval;
+    
+    if (node->type == CB_AST_TYPE_STATEMENT_LIST)
+    {
+        list = (const CbAstStatementListNode*) node;
+        for (i = 0; i < cb_ast_statement_list_node_get_count(list); i++)
+            cb_ast_profiler_add(self, (CbAstNode*)
+                                cb_ast_statement_list_node_get(list, i));
+    }
+    else if (node->type == CB_AST_TYPE_CONTROL_FLOW)
+        cb_ast_profiler_add(self, (CbAstNode*)
+                            cb_ast_control_flow_node_get_condition(
+                                (const CbAstControlFlowNode*) node
+                            ));
+    
+    cb_ast_profiler_add(self, node->left);
+    cb_ast_profiler_add(self, node->right);
+}
+
+static CbAstProfilerEntry* cb_ast_profiler_find(const CbAstProfiler* self,
+                                                const CbAstNode* node)
+{
+    CbAstProfilerEntry key;
+    
+    key.node = node;
+    return bsearch(&key, self->entries, self->count,
+                   sizeof(CbAstProfilerEntry), cb_ast_profiler_compare_node);
+}
+
+static bool cb_ast_profiler_eval(const CbAstNode* node,
+                                 const CbSymbolTable* symbols,
+                                 CbVariant* result)
+{
+    bool success;
+    double start;
+    double elapsed;
+    CbAstProfiler* self = cb_ast_profiler_active;
+    CbAstProfilerEntry* entry;
+    double children;
+    
+    cb_assert(self != NULL);
+    
+    entry          = cb_ast_profiler_find(self, node);
+    children       = self->children;
+    self->children = 0.0;
+    
+    start   = cb_ast_profiler_now();
+    success = entry->eval(node, symbols, result);
+    elapsed = cb_ast_profiler_now() - start;
+    
+    /* the time of this node counts as child time of the calling node */
+    entry->count++;
+    entry->inclusive += elapsed;
+    entry->exclusive += elapsed - self->children;
+    self->children    = children + elapsed;
+    
+    return success;
+}
+
+static double cb_ast_profiler_now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+
+static int cb_ast_profiler_compare_node(const void* a, const void* b)
+{
+    uintptr_t left  = (uintptr_t) ((const CbAstProfilerEntry*) a)->node;
+    uintptr_t right = (uintptr_t) ((const CbAstProfilerEntry*) b)->node;
+    
+    return (left > right) - (left < right);
+}
+
+static int cb_ast_profiler_compare_location(const void* a, const void* b)
+{
+    const CbAstProfilerEntry* left  = a;
+    const CbAstProfilerEntry* right = b;
+    
+    if (left->line != right->line)
+        return (left->line > right->line) - (left->line < right->line);
+    else
+        return (int) left->type - (int) right->type;
+}
+
+static int cb_ast_profiler_compare_exclusive(const void* a, const void* b)
+{
+    const CbAstProfilerEntry* left  = a;
+    const CbAstProfilerEntry* right = b;
+    
+    /* descending, ties by location */
+    if (left->exclusive != right->exclusive)
+        return (left->exclusive < right->exclusive) -
+               (left->exclusive > right->exclusive);
+    else
+        return cb_ast_profiler_compare_location(a, b);
+}
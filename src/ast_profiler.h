@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * AST profiler
+ * Counts the evaluations of each node of an AST and measures the time spent in
+ * it: Inclusive time covers the evaluation of the node and its child nodes,
+ * exclusive time only the node itself.
+ * 
+ * While the profiler is attached to an AST, the eval functions of the nodes
+ * are replaced by an instrumented one, that calls the original function. So
+ * there is no overhead at all for ASTs without a profiler.
+ * 
+ * NOTE: The attached AST must only be evaluated by the thread, that attached
+ *       the profiler. Only one profiler can be attached per thread.
+ ******************************************************************************/
+
+#ifndef AST_PROFILER_H
+#define AST_PROFILER_H
+
+#include <stdio.h>
+#include "ast.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+typedef struct CbAstProfiler CbAstProfiler;
+
+/* report formats */
+typedef enum
+{
+    CB_AST_PROFILER_FORMAT_TEXT, /* human readable table   */
+    CB_AST_PROFILER_FORMAT_CSV   /* comma separated values */
+} CbAstProfilerFormat;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Constructor
+ */
+CbAstProfiler* cb_ast_profiler_create();
+
+/*
+ * Destructor
+ * NOTE: The profiler must be detached before.
+ */
+void cb_ast_profiler_destroy(CbAstProfiler* self);
+
+/*
+ * Install the instrumented eval function in all nodes of an AST.
+ * NOTE: The AST must have passed the semantic check and the optimizer, since
+ *       both might change the eval functions of the nodes.
+ */
+void cb_ast_profiler_attach(CbAstProfiler* self, CbAstNode* ast);
+
+/*
+ * Restore the original eval functions of the nodes. The collected data is
+ * kept and can still be reported afterwards.
+ */
+void cb_ast_profiler_detach(CbAstProfiler* self);
+
+/*
+ * Get the number of evaluations of all nodes of the given type on a line.
+ */
+size_t cb_ast_profiler_get_count(const CbAstProfiler* self,
+                                 int line,
+                                 CbAstType type);
+
+/*
+ * Write a hot spot report: The nodes are grouped by source line and node type
+ * and sorted by exclusive time (descending). The CSV format has the columns
+ * line, kind, count, inclusive_ns and exclusive_ns (times in nanoseconds).
+ * Nodes without a line number (e.g. statement lists) are reported on line -1.
+ * NOTE: Inclusive times of nested nodes of the same type on one line (e.g.
+ *       "a + b + c") are accumulated for each of these nodes.
+ */
+void cb_ast_profiler_report(const CbAstProfiler* self,
+                            CbAstProfilerFormat format,
+                            FILE* output);
+
+
+#endif /* AST_PROFILER_H */
@@ -1,4 +1,4 @@
-#include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 
 #include "utils.h"
@@ -11,47 +11,130 @@
 
 /* -------------------------------------------------------------------------- */
 
-CbAstNode* cb_ast_statement_list_node_create(CbAstNode* left, CbAstNode* right)
+struct CbAstStatementListNode
 {
-    CbAstNode* self = (CbAstNode*) memalloc(sizeof(CbAstNode));
+    CbAstNode base;
+    CbArena* arena; /* owns the statement array */
+    CbAstNode** statements;
+    size_t count;
+    size_t capacity;
+};
+
+static const size_t CB_AST_STATEMENT_LIST_INITIAL_CAPACITY = 8;
+
+
+/* -------------------------------------------------------------------------- */
+
+CbAstStatementListNode* cb_ast_statement_list_node_create(CbArena* arena)
+{
+    CbAstStatementListNode* self = cb_arena_alloc(arena, sizeof(CbAstStatementListNode));
     cb_ast_node_init(
-        self, CB_AST_TYPE_STATEMENT_LIST, left, right,
-        (CbAstNodeDestructorFunc) cb_ast_statement_list_node_destroy,
+        &self->base, CB_AST_TYPE_STATEMENT_LIST, NULL, NULL,
         (CbAstNodeEvalFunc)       cb_ast_statement_list_node_eval,
         (CbAstNodeSemanticFunc)   cb_ast_statement_list_node_check_semantic
     );
     
+    self->arena      = arena;
+    self->count      = 0;
+    self->capacity   = CB_AST_STATEMENT_LIST_INITIAL_CAPACITY;
+    self->statements = cb_arena_alloc(arena, self->capacity *
+                                      sizeof(CbAstNode*));
+    
     return self;
 }
 
-void cb_ast_statement_list_node_destroy(CbAstNode* self)
+void cb_ast_statement_list_node_add(CbAstStatementListNode* self,
+                                    CbAstNode* statement)
 {
-    /* destroy child nodes */
-    cb_ast_node_destroy(self->left);
-    cb_ast_node_destroy(self->right);
+    CbAstNode** statements;
+    
+    /* NOTE: The old array is not freed, it is released with the arena. */
+    if (self->count == self->capacity)
+    {
+        statements = cb_arena_alloc(self->arena, 2 * self->capacity *
+                                    sizeof(CbAstNode*));
+        memcpy(statements, self->statements,
+               self->count * sizeof(CbAstNode*));
+        
+        self->statements  = statements;
+        self->capacity   *= 2;
+    }
     
-    memfree(self);
+    self->statements[self->count++] = statement;
 }
 
-CbVariant* cb_ast_statement_list_node_eval(const CbAstNode* self,
-                                           const CbSymbolTable* symbols)
+CbAstNode* cb_ast_statement_list_node_append(CbArena* arena,
+                                             CbAstNode* sequence,
+                                             CbAstNode* statement)
 {
-    CbVariant* result = cb_ast_node_eval(self->left, symbols);
-    if (!cb_error_occurred())
+    CbAstStatementListNode* list;
+    
+    if (sequence == NULL)
+        return statement;
+    
+    if (cb_ast_node_get_type(sequence) == CB_AST_TYPE_STATEMENT_LIST)
+        list = (CbAstStatementListNode*) sequence;
+    else
     {
-        cb_variant_destroy(result);
-        result = cb_ast_node_eval(self->right, symbols);
+        list = cb_ast_statement_list_node_create(arena);
+        cb_ast_statement_list_node_add(list, sequence);
     }
     
-    return result;
+    cb_ast_statement_list_node_add(list, statement);
+    
+    return (CbAstNode*) list;
 }
 
-bool cb_ast_statement_list_node_check_semantic(const CbAstNode* self,
+size_t cb_ast_statement_list_node_get_count(const CbAstStatementListNode* self)
+{
+    return self->count;
+}
+
+const CbAstNode* cb_ast_statement_list_node_get(const CbAstStatementListNode* self,
+                                                size_t index)
+{
+    cb_assert(index < self->count);
+    return self->statements[index];
+}
+
+void cb_ast_statement_list_node_set(CbAstStatementListNode* self,
+                                    size_t index,
+                                    CbAstNode* statement)
+{
+    cb_assert(index < self->count);
+    self->statements[index] = statement;
+}
+
+bool cb_ast_statement_list_node_eval(const CbAstStatementListNode* self,
+                                     const CbSymbolTable* symbols,
+                                     CbVariant* result)
+{
+    size_t i;
+    bool success = true;
+    
+    *result = cb_variant_make();
+    if (self->count == 0)
+        return success;
+    
+    /* only the value of the last statement is kept */
+    for (i = 0; success && i + 1 < self->count; i++)
+        success = cb_ast_node_exec(self->statements[i], symbols);
+    
+    if (success)
+        success = cb_ast_node_eval_value(self->statements[self->count - 1],
+                                         symbols, result);
+    
+    return success;
+}
+
+bool cb_ast_statement_list_node_check_semantic(const CbAstStatementListNode* self,
                                                CbSymbolTable* symbols)
 {
-    bool result = cb_ast_node_check_semantic(self->left, symbols);
-    if (result)
-        result = cb_ast_node_check_semantic(self->right, symbols);
+    size_t i;
+    bool result = true;
+    
+    for (i = 0; result && i < self->count; i++)
+        result = cb_ast_node_check_semantic(self->statements[i], symbols);
     
     return result;
 }
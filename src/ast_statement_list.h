@@ -1,6 +1,7 @@
 /*******************************************************************************
  * Abstract syntax tree node: StatementList
- * Connects two AST nodes.
+ * Sequence of statements, that are stored in a contiguous array and executed
+ * one after another (without recursion).
  * 
  * Inherites from CbAstNode
  ******************************************************************************/
@@ -11,30 +12,64 @@
 #include "variant.h"
 #include "symbol_table.h"
 #include "ast.h"
+#include "arena.h"
+
+
+typedef struct CbAstStatementListNode CbAstStatementListNode;
 
 
 /* -------------------------------------------------------------------------- */
 
 /*
- * Constructor
+ * Constructor: Creates an empty statement list
+ */
+CbAstStatementListNode* cb_ast_statement_list_node_create(CbArena* arena);
+
+/*
+ * Append a statement to the end of the list
+ */
+void cb_ast_statement_list_node_add(CbAstStatementListNode* self,
+                                    CbAstNode* statement);
+
+/*
+ * Append a statement to a sequence of statements, that is either empty
+ * (NULL), a single statement or a statement list. A statement list is only
+ * created for two or more statements.
+ * Returns the resulting sequence.
+ */
+CbAstNode* cb_ast_statement_list_node_append(CbArena* arena,
+                                             CbAstNode* sequence,
+                                             CbAstNode* statement);
+
+/*
+ * Get the number of statements
+ */
+size_t cb_ast_statement_list_node_get_count(const CbAstStatementListNode* self);
+
+/*
+ * Get a statement by its index
  */
-CbAstNode* cb_ast_statement_list_node_create(CbAstNode* left, CbAstNode* right);
+const CbAstNode* cb_ast_statement_list_node_get(const CbAstStatementListNode* self,
+                                                size_t index);
 
 /*
- * Destructor
+ * Replace a statement by its index
  */
-void cb_ast_statement_list_node_destroy(CbAstNode* self);
+void cb_ast_statement_list_node_set(CbAstStatementListNode* self,
+                                    size_t index,
+                                    CbAstNode* statement);
 
 /*
- * Evaluate statement list
+ * Evaluate statement list: The result is the value of the last statement.
  */
-CbVariant* cb_ast_statement_list_node_eval(const CbAstNode* self,
-                                           const CbSymbolTable* symbols);
+bool cb_ast_statement_list_node_eval(const CbAstStatementListNode* self,
+                                     const CbSymbolTable* symbols,
+                                     CbVariant* result);
 
 /*
  * Check semantics
  */
-bool cb_ast_statement_list_node_check_semantic(const CbAstNode* self,
+bool cb_ast_statement_list_node_check_semantic(const CbAstStatementListNode* self,
                                                CbSymbolTable* symbols);
 
 
@@ -1,6 +1,7 @@
 #include "utils.h"
 #include "cb_utils.h"
 #include "error_handling.h"
+#include "operation.h"
 #include "ast_internal.h"
 #include "ast_unary.h"
 
@@ -22,13 +23,13 @@ static bool cb_ast_unary_node_check_operation(const CbAstUnaryNode* self,
 
 /* -------------------------------------------------------------------------- */
 
-CbAstUnaryNode* cb_ast_unary_node_create(const CbUnaryOperatorType operator_type,
+CbAstUnaryNode* cb_ast_unary_node_create(CbArena* arena,
+                                         const CbUnaryOperatorType operator_type,
                                          CbAstNode* operand)
 {
-    CbAstUnaryNode* self = (CbAstUnaryNode*) memalloc(sizeof(CbAstUnaryNode));
+    CbAstUnaryNode* self = cb_arena_alloc(arena, sizeof(CbAstUnaryNode));
     cb_ast_node_init(
         &self->base, CB_AST_TYPE_UNARY, operand, NULL,
-        (CbAstNodeDestructorFunc) cb_ast_unary_node_destroy,
         (CbAstNodeEvalFunc)       cb_ast_unary_node_eval,
         (CbAstNodeSemanticFunc)   cb_ast_unary_node_check_semantic
     );
@@ -37,54 +38,27 @@ CbAstUnaryNode* cb_ast_unary_node_create(const CbUnaryOperatorType operator_type
     return self;
 }
 
-void cb_ast_unary_node_destroy(CbAstUnaryNode* self)
+bool cb_ast_unary_node_eval(const CbAstUnaryNode* self,
+                            const CbSymbolTable* symbols,
+                            CbVariant* result)
 {
-    /* destroy left child node */
-    cb_ast_node_destroy(self->base.left);
+    bool success = false;
+    CbVariant value;
     
-    memfree(self);
+    *result = cb_variant_make();
+    
+    if (cb_ast_node_eval_value(self->base.left, symbols, &value))
+        success = cb_unary_operation_eval(self->operator_type, &value,
+                                          self->base.line, result);
+    
+    cb_variant_release(&value);
+    
+    return success;
 }
 
-CbVariant* cb_ast_unary_node_eval(const CbAstUnaryNode* self,
-                                  const CbSymbolTable* symbols)
+CbUnaryOperatorType cb_ast_unary_node_get_operator_type(const CbAstUnaryNode* self)
 {
-    CbVariant* result = NULL;
-    CbVariant* value  = cb_ast_node_eval(self->base.left, symbols);
-    
-    if (value != NULL)
-    {
-        if (cb_ast_unary_node_check_operation(self, cb_variant_get_type(value)))
-        {
-            switch (self->operator_type)
-            {
-                case CB_UNARY_OPERATOR_TYPE_MINUS:
-                {
-                    if (cb_variant_is_integer(value))
-                        result = cb_integer_create( - cb_integer_get_value(value));
-                    else if (cb_variant_is_float(value))
-                        result = cb_float_create( - cb_float_get_value(value));
-                    else
-                        /* TODO: handle all compatible AST node types */
-                        cb_abort("Wrong variant type");
-                    
-                    break;
-                }
-                
-                case CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT:
-                    cb_assert(cb_variant_is_boolean(value));
-                    result = cb_boolean_create(!cb_boolean_get_value(value));
-                    break;
-                
-                /* invalid unary operator type */
-                default:
-                    cb_abort("Invalid unary operator type"); break;
-            }
-        }
-        
-        cb_variant_destroy(value);
-    }
-    
-    return result;
+    return self->operator_type;
 }
 
 bool cb_ast_unary_node_check_semantic(const CbAstUnaryNode* self,
@@ -103,17 +77,6 @@ bool cb_ast_unary_node_check_semantic(const CbAstUnaryNode* self,
 static bool cb_ast_unary_node_check_operation(const CbAstUnaryNode* self,
                                               const CbVariantType type)
 {
-    bool result = cb_variant_type_is_unary_operation_valid(self->operator_type,
-                                                           type);
-    if (!result)
-    {
-        cb_error_trigger(
-            self->base.error_context, self->base.line,
-            "Invalid unary operation: %s <%s>",
-            cb_unary_operator_type_stringify(self->operator_type),
-            cb_variant_type_stringify(type)
-        );
-    }
-    
-    return result;
+    return cb_unary_operation_check(self->operator_type, type,
+                                    self->base.error_context, self->base.line);
 }
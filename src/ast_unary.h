@@ -9,6 +9,7 @@
 #define AST_UNARY_H
 
 #include "variant.h"
+#include "arena.h"
 
 
 /* -------------------------------------------------------------------------- */
@@ -21,19 +22,21 @@ typedef struct CbAstUnaryNode CbAstUnaryNode;
 /*
  * Constructor
  */
-CbAstUnaryNode* cb_ast_unary_node_create(const CbUnaryOperatorType operator_type,
+CbAstUnaryNode* cb_ast_unary_node_create(CbArena* arena,
+                                         const CbUnaryOperatorType operator_type,
                                          CbAstNode* operand);
 
 /*
- * Destructor
+ * Evaluate unary node
  */
-void cb_ast_unary_node_destroy(CbAstUnaryNode* self);
+bool cb_ast_unary_node_eval(const CbAstUnaryNode* self,
+                            const CbSymbolTable* symbols,
+                            CbVariant* result);
 
 /*
- * Evaluate unary node
+ * Operator type (Getter)
  */
-CbVariant* cb_ast_unary_node_eval(const CbAstUnaryNode* self,
-                                  const CbSymbolTable* symbols);
+CbUnaryOperatorType cb_ast_unary_node_get_operator_type(const CbAstUnaryNode* self);
 
 /*
  * Check semantics
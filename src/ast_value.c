@@ -10,41 +10,53 @@
 struct CbAstValueNode
 {
     CbAstNode base;
-    CbVariant* value;
+    CbVariant value;
 };
 
 
 /* -------------------------------------------------------------------------- */
 
-CbAstValueNode* cb_ast_value_node_create(const CbVariant* value)
+CbAstValueNode* cb_ast_value_node_create(CbArena* arena, const CbVariant* value)
 {
-    CbAstValueNode* self = (CbAstValueNode*) memalloc(sizeof(CbAstValueNode));
+    size_t length;
+    CbAstValueNode* self = cb_arena_alloc(arena, sizeof(CbAstValueNode));
     cb_ast_node_init(
         &self->base, CB_AST_TYPE_VALUE, NULL, NULL,
-        (CbAstNodeDestructorFunc) cb_ast_value_node_destroy,
         (CbAstNodeEvalFunc)       cb_ast_value_node_eval,
         (CbAstNodeSemanticFunc)   cb_ast_value_node_check_semantic
     );
     
-    self->value = cb_variant_copy(value);
+    /*
+     * The characters of a string literal are owned by the arena as well (short
+     * strings are stored inline and need no storage).
+     */
+    if (cb_variant_is_string(value))
+    {
+        length = cb_string_get_length(value);
+        self->value = cb_string_make_borrowed(
+            cb_string_get_storage_size(length) > 0 ?
+                cb_arena_alloc(arena, cb_string_get_storage_size(length)) :
+                NULL,
+            cb_string_get_value(value), length
+        );
+    }
+    else
+        self->value = *value;
     
     return self;
 }
 
-void cb_ast_value_node_destroy(CbAstValueNode* self)
-{
-    cb_variant_destroy(self->value);
-    memfree(self);
-}
-
 const CbVariant* cb_ast_value_node_get_value(const CbAstValueNode* self)
 {
-    return self->value;
+    return &self->value;
 }
 
-CbVariant* cb_ast_value_node_eval(const CbAstValueNode* self)
+bool cb_ast_value_node_eval(const CbAstValueNode* self,
+                            const void* dummy,
+                            CbVariant* result)
 {
-    return cb_variant_copy(self->value);
+    *result = cb_variant_clone(&self->value);
+    return true;
 }
 
 bool cb_ast_value_node_check_semantic(const CbAstValueNode* self,
@@ -9,6 +9,7 @@
 #define AST_VALUE_H
 
 #include "variant.h"
+#include "arena.h"
 
 
 /* -------------------------------------------------------------------------- */
@@ -20,13 +21,10 @@ typedef struct CbAstValueNode CbAstValueNode;
 
 /*
  * Constructor
+ * NOTE: The value is copied into the arena (including the characters of a
+ *       string value).
  */
-CbAstValueNode* cb_ast_value_node_create(const CbVariant* value);
-
-/*
- * Destructor
- */
-void cb_ast_value_node_destroy(CbAstValueNode* self);
+CbAstValueNode* cb_ast_value_node_create(CbArena* arena, const CbVariant* value);
 
 /*
  * Value (Getter)
@@ -36,7 +34,9 @@ const CbVariant* cb_ast_value_node_get_value(const CbAstValueNode* self);
 /*
  * Evaluate value node
  */
-CbVariant* cb_ast_value_node_eval(const CbAstValueNode* self);
+bool cb_ast_value_node_eval(const CbAstValueNode* self,
+                            const void* dummy,
+                            CbVariant* result);
 
 /*
  * Check semantics
@@ -3,6 +3,7 @@
 #include "utils.h"
 #include "cb_utils.h"
 #include "error_handling.h"
+#include "intern.h"
 #include "symbol_variable.h"
 #include "ast_internal.h"
 #include "ast_variable.h"
@@ -13,17 +14,16 @@
 struct CbAstVariableNode
 {
     CbAstNode base;
-    char* identifier;
+    const char* identifier; /* interned (see intern.h) */
     
     /*
-     * TODO:
-     * Implement a cache (i.e. a pointer), that holds a reference to the proper
-     * symbol object in the symbol table.
-     * The cache should be filled during the semantic check of this node, so
-     * that the cb_symbol_table_lookup()-function is only called once per
-     * execution.
+     * Location of the variable (i.e. the slot in the frame of the declaring
+     * scope), which is resolved during the semantic check of this node.
+     * This way no identifier lookup is necessary during execution.
      */
-    /* CbSymbolVariable* variable; */
+    bool resolved;
+    size_t scope_depth;
+    size_t slot;
 };
 
 
@@ -35,44 +35,64 @@ static CbSymbolVariable* cb_ast_variable_node_get_symbol_from_table(const CbAstV
 
 /* -------------------------------------------------------------------------- */
 
-CbAstVariableNode* cb_ast_variable_node_create(const char* identifier)
+CbAstVariableNode* cb_ast_variable_node_create(CbArena* arena,
+                                               const char* identifier)
 {
-    CbAstVariableNode* self = (CbAstVariableNode*) memalloc(sizeof(CbAstVariableNode));
+    CbAstVariableNode* self = cb_arena_alloc(arena, sizeof(CbAstVariableNode));
     cb_ast_node_init(
         &self->base, CB_AST_TYPE_VARIABLE, NULL, NULL,
-        (CbAstNodeDestructorFunc) cb_ast_variable_node_destroy,
         (CbAstNodeEvalFunc)       cb_ast_variable_node_eval,
         (CbAstNodeSemanticFunc)   cb_ast_variable_node_check_semantic
     );
     
-    self->identifier = strdup(identifier);
+    cb_intern_assert(identifier);
+    self->identifier  = identifier;
+    self->resolved    = false;
+    self->scope_depth = 0;
+    self->slot        = 0;
     
     return self;
 }
 
-void cb_ast_variable_node_destroy(CbAstVariableNode* self)
+const char* cb_ast_variable_node_get_identifier(const CbAstVariableNode* self)
 {
-    memfree(self->identifier);
-    memfree(self);
+    return self->identifier;
 }
 
-CbVariant* cb_ast_variable_node_eval(const CbAstVariableNode* self,
-                                     const CbSymbolTable* symbols)
+bool cb_ast_variable_node_is_resolved(const CbAstVariableNode* self)
+{
+    return self->resolved;
+}
+
+size_t cb_ast_variable_node_get_scope_depth(const CbAstVariableNode* self)
+{
+    cb_assert(self->resolved);
+    return self->scope_depth;
+}
+
+size_t cb_ast_variable_node_get_slot(const CbAstVariableNode* self)
+{
+    cb_assert(self->resolved);
+    return self->slot;
+}
+
+bool cb_ast_variable_node_eval(const CbAstVariableNode* self,
+                               const CbSymbolTable* symbols,
+                               CbVariant* result)
 {
-    CbVariant* result = NULL;
     const CbSymbolVariable* symbol =
         cb_ast_variable_node_get_symbol_from_table(self, symbols);
     
     /* return copy of the value */
-    result = cb_variant_copy(cb_symbol_variable_get_value(symbol));
+    *result = cb_variant_clone(cb_symbol_variable_get_value(symbol));
     
-    return result;
+    return true;
 }
 
-bool cb_ast_variable_node_check_semantic(const CbAstVariableNode* self,
+bool cb_ast_variable_node_check_semantic(CbAstVariableNode* self,
                                          CbSymbolTable* symbols)
 {
-    CbSymbol* symbol = cb_symbol_table_lookup(symbols, self->identifier);
+    CbSymbol* symbol = cb_symbol_table_lookup_interned(symbols, self->identifier);
     
     if (symbol == NULL)
     {
@@ -101,6 +121,11 @@ bool cb_ast_variable_node_check_semantic(const CbAstVariableNode* self,
         return false;
     }
     
+    /* resolve location of the variable */
+    self->resolved    = true;
+    self->scope_depth = cb_symbol_get_scope_depth(symbol);
+    self->slot        = cb_symbol_get_slot(symbol);
+    
     return true;
 }
 
@@ -117,30 +142,59 @@ bool cb_ast_variable_node_check_expression_type(const CbAstVariableNode* self,
 bool cb_ast_variable_node_is_declared(const CbAstVariableNode* self,
                                       const CbSymbolTable* symbols)
 {
-    CbSymbol* symbol = cb_symbol_table_lookup(symbols, self->identifier);
+    CbSymbol* symbol = cb_symbol_table_lookup_interned(symbols, self->identifier);
     if (symbol == NULL)
         return false;
     else
         return cb_symbol_is_variable(symbol);
 }
 
-const CbVariant* cb_ast_variable_node_assign(CbAstVariableNode* self,
+const CbVariant* cb_ast_variable_node_assign(const CbAstVariableNode* self,
                                              const CbSymbolTable* symbols,
-                                             const CbVariant* value)
+                                             CbVariant* value)
 {
     CbSymbolVariable* symbol =
         cb_ast_variable_node_get_symbol_from_table(self, symbols);
-    cb_symbol_variable_assign(symbol, value);
+    cb_symbol_variable_move(symbol, value);
     return cb_symbol_variable_get_value(symbol);
 }
 
+const CbVariant* cb_ast_variable_node_append(const CbAstVariableNode* self,
+                                             const CbSymbolTable* symbols,
+                                             const CbVariant* value)
+{
+    CbSymbolVariable* symbol =
+        cb_ast_variable_node_get_symbol_from_table(self, symbols);
+    
+    if (cb_symbol_variable_append(symbol, value))
+        return cb_symbol_variable_get_value(symbol);
+    else
+        return NULL;
+}
+
+bool cb_ast_variable_node_is_same(const CbAstVariableNode* self,
+                                  const CbAstVariableNode* other)
+{
+    return self->resolved && other->resolved &&
+           self->scope_depth == other->scope_depth &&
+           self->slot == other->slot;
+}
+
 
 /* -------------------------------------------------------------------------- */
 
 static CbSymbolVariable* cb_ast_variable_node_get_symbol_from_table(const CbAstVariableNode* self,
                                                                     const CbSymbolTable* symbols)
 {
-    CbSymbol* symbol = cb_symbol_table_lookup(symbols, self->identifier);
+    CbSymbol* symbol;
+    
+    if (self->resolved)
+        symbol = cb_symbol_table_get_slot(symbols, self->scope_depth,
+                                          self->slot);
+    else
+        /* fallback for ASTs, that did not pass the semantic check */
+        symbol = cb_symbol_table_lookup_interned(symbols, self->identifier);
+    
     /* make sure symbol is valid */
     cb_assert(symbol != NULL);
     cb_assert(cb_symbol_is_variable(symbol));
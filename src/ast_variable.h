@@ -10,6 +10,7 @@
 
 #include "variant.h"
 #include "symbol_table.h"
+#include "arena.h"
 
 
 /**
@@ -25,26 +26,56 @@ typedef struct CbAstVariableNode CbAstVariableNode;
  * @memberof CbAstVariableNode
  * @brief    Constructor
  * 
- * @param identifier The name of the variable
+ * @param arena      The arena, that owns the node
+ * @param identifier The name of the variable (interned, see intern.h)
  */
-CbAstVariableNode* cb_ast_variable_node_create(const char* identifier);
+CbAstVariableNode* cb_ast_variable_node_create(CbArena* arena,
+                                               const char* identifier);
 
 /**
  * @memberof CbAstVariableNode
- * @brief    Destructor
+ * @brief    Get the name of the variable
  * 
  * @param self The CbAstVariableNode instance
  */
-void cb_ast_variable_node_destroy(CbAstVariableNode* self);
+const char* cb_ast_variable_node_get_identifier(const CbAstVariableNode* self);
 
 /**
  * @memberof CbAstVariableNode
- * @brief    Evaluate a CbAstVariableNode
+ * @brief    Check if the location of the variable was resolved
+ *           (i.e. the node passed the semantic check)
+ * 
+ * @param self The CbAstVariableNode instance
+ */
+bool cb_ast_variable_node_is_resolved(const CbAstVariableNode* self);
+
+/**
+ * @memberof CbAstVariableNode
+ * @brief    Get the depth of the scope, that declares the variable
+ * 
+ * @param self The CbAstVariableNode instance
+ */
+size_t cb_ast_variable_node_get_scope_depth(const CbAstVariableNode* self);
+
+/**
+ * @memberof CbAstVariableNode
+ * @brief    Get the slot index of the variable within its declaring scope
  * 
  * @param self The CbAstVariableNode instance
  */
-CbVariant* cb_ast_variable_node_eval(const CbAstVariableNode* self,
-                                     const CbSymbolTable* symbols);
+size_t cb_ast_variable_node_get_slot(const CbAstVariableNode* self);
+
+/**
+ * @memberof CbAstVariableNode
+ * @brief    Evaluate a CbAstVariableNode
+ * 
+ * @param self    The CbAstVariableNode instance
+ * @param symbols The symbol-table
+ * @param result  Receives a copy of the variable's value
+ */
+bool cb_ast_variable_node_eval(const CbAstVariableNode* self,
+                               const CbSymbolTable* symbols,
+                               CbVariant* result);
 
 /**
  * @memberof CbAstVariableNode
@@ -53,7 +84,7 @@ CbVariant* cb_ast_variable_node_eval(const CbAstVariableNode* self,
  * @param self    The CbAstVariableNode instance
  * @param symbols The symbol-table
  */
-bool cb_ast_variable_node_check_semantic(const CbAstVariableNode* self,
+bool cb_ast_variable_node_check_semantic(CbAstVariableNode* self,
                                          CbSymbolTable* symbols);
 
 /**
@@ -85,13 +116,41 @@ bool cb_ast_variable_node_is_declared(const CbAstVariableNode* self,
  * 
  * @param self    The CbAstVariableNode instance.
  * @param symbols The symbol-table to look for the identifier.
- * @param value   The new value to be assigned.
+ * @param value   The new value to be assigned. The value is moved into the
+ *                symbol, so it is undefined afterwards.
  * 
- * @return Returns a pointer to the new value assigned to the symbol.
+ * @return Returns a pointer to the new value assigned to the symbol (owned by
+ *         the symbol).
  */
-const CbVariant* cb_ast_variable_node_assign(CbAstVariableNode* self,
+const CbVariant* cb_ast_variable_node_assign(const CbAstVariableNode* self,
+                                             const CbSymbolTable* symbols,
+                                             CbVariant* value);
+
+/**
+ * @memberof CbAstVariableNode
+ * @brief    Append a string to the value of the symbol referenced by this node
+ *           in place (i.e. without copying the current value).
+ * 
+ * @param self    The CbAstVariableNode instance.
+ * @param symbols The symbol-table to look for the identifier.
+ * @param value   The string to be appended.
+ * 
+ * @return Returns a pointer to the new value of the symbol or NULL, if the
+ *         current value or the appended value is not a string.
+ */
+const CbVariant* cb_ast_variable_node_append(const CbAstVariableNode* self,
                                              const CbSymbolTable* symbols,
                                              const CbVariant* value);
 
+/**
+ * @memberof CbAstVariableNode
+ * @brief    Check if two nodes refer to the same (resolved) variable
+ * 
+ * @param self  The CbAstVariableNode instance.
+ * @param other The other CbAstVariableNode instance.
+ */
+bool cb_ast_variable_node_is_same(const CbAstVariableNode* self,
+                                  const CbAstVariableNode* other);
+
 
 #endif /* AST_VARIABLE_H */
@@ -0,0 +1,148 @@
+#include "utils.h"
+#include "cb_utils.h"
+#include "bytecode.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+struct CbBytecode
+{
+    CbInstruction* instructions;
+    int* lines;
+    size_t count;
+    size_t capacity;
+    
+    CbVariant* constants;
+    size_t constant_count;
+    size_t constant_capacity;
+    
+    size_t register_count;
+};
+
+static const size_t CB_BYTECODE_INITIAL_CAPACITY = 32;
+
+
+/* -------------------------------------------------------------------------- */
+
+CbBytecode* cb_bytecode_create()
+{
+    CbBytecode* self = memalloc(sizeof(CbBytecode));
+    
+    self->capacity     = CB_BYTECODE_INITIAL_CAPACITY;
+    self->count        = 0;
+    self->instructions = memalloc(self->capacity * sizeof(CbInstruction));
+    self->lines        = memalloc(self->capacity * sizeof(int));
+    
+    self->constant_capacity = CB_BYTECODE_INITIAL_CAPACITY;
+    self->constant_count    = 0;
+    self->constants         = memalloc(self->constant_capacity *
+                                       sizeof(CbVariant));
+    
+    self->register_count = 0;
+    
+    return self;
+}
+
+void cb_bytecode_destroy(CbBytecode* self)
+{
+    size_t i;
+    for (i = 0; i < self->constant_count; i++)
+        cb_variant_release(&self->constants[i]);
+    
+    memfree(self->constants);
+    memfree(self->lines);
+    memfree(self->instructions);
+    memfree(self);
+}
+
+size_t cb_bytecode_emit(CbBytecode* self,
+                        CbOpcode opcode,
+                        int operator_type,
+                        unsigned int a,
+                        unsigned int b,
+                        unsigned int c,
+                        int line)
+{
+    CbInstruction* instruction;
+    
+    cb_assert(a < CB_BYTECODE_MAX_REGISTERS);
+    
+    if (self->count == self->capacity)
+    {
+        self->capacity    *= 2;
+        self->instructions = memrealloc(self->instructions,
+                                        self->capacity * sizeof(CbInstruction));
+        self->lines        = memrealloc(self->lines,
+                                        self->capacity * sizeof(int));
+        cb_assert(self->instructions != NULL && self->lines != NULL);
+    }
+    
+    instruction                = &self->instructions[self->count];
+    instruction->opcode        = (unsigned char) opcode;
+    instruction->operator_type = (unsigned char) operator_type;
+    instruction->a             = (unsigned short) a;
+    instruction->b             = b;
+    instruction->c             = c;
+    self->lines[self->count]   = line;
+    
+    return self->count++;
+}
+
+void cb_bytecode_patch_jump(CbBytecode* self, size_t index, size_t target)
+{
+    cb_assert(index < self->count);
+    cb_assert(self->instructions[index].opcode == CB_OPCODE_JUMP ||
+              self->instructions[index].opcode == CB_OPCODE_JUMP_IF_FALSE ||
+              self->instructions[index].opcode == CB_OPCODE_JUMP_IF_BOOLEAN);
+    
+    self->instructions[index].b = (unsigned int) target;
+}
+
+size_t cb_bytecode_add_constant(CbBytecode* self, const CbVariant* value)
+{
+    if (self->constant_count == self->constant_capacity)
+    {
+        self->constant_capacity *= 2;
+        self->constants = memrealloc(self->constants,
+                                     self->constant_capacity *
+                                     sizeof(CbVariant));
+        cb_assert(self->constants != NULL);
+    }
+    
+    self->constants[self->constant_count] = cb_variant_clone(value);
+    
+    return self->constant_count++;
+}
+
+size_t cb_bytecode_get_count(const CbBytecode* self)
+{
+    return self->count;
+}
+
+const CbInstruction* cb_bytecode_get_instructions(const CbBytecode* self)
+{
+    return self->instructions;
+}
+
+const CbVariant* cb_bytecode_get_constant(const CbBytecode* self, size_t index)
+{
+    cb_assert(index < self->constant_count);
+    return &self->constants[index];
+}
+
+int cb_bytecode_get_line(const CbBytecode* self, size_t index)
+{
+    cb_assert(index < self->count);
+    return self->lines[index];
+}
+
+void cb_bytecode_set_register_count(CbBytecode* self, size_t count)
+{
+    cb_assert(count <= CB_BYTECODE_MAX_REGISTERS);
+    self->register_count = count;
+}
+
+size_t cb_bytecode_get_register_count(const CbBytecode* self)
+{
+    return self->register_count;
+}
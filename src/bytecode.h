@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * @file  bytecode.h
+ * @brief Contains the CbBytecode structure
+ * 
+ * Compact, linear representation of a checked AST, that can be executed by
+ * the register based virtual machine (see vm.h).
+ ******************************************************************************/
+
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <stddef.h>
+
+#include "variant.h"
+
+
+/**
+ * @struct CbBytecode
+ * @brief  Instruction sequence and constant pool of a compiled codeblock
+ */
+typedef struct CbBytecode CbBytecode;
+
+/**
+ * @enum  CbOpcode
+ * @brief Operation codes of the virtual machine
+ * 
+ * R[x] denotes register x, K[x] denotes constant x of the constant pool.
+ */
+typedef enum CbOpcode
+{
+    CB_OPCODE_LOAD_UNDEFINED,  /* R[a] := <undefined>                       */
+    CB_OPCODE_LOAD_CONSTANT,   /* R[a] := K[b]                              */
+    CB_OPCODE_MOVE,            /* R[a] := R[b]                              */
+    CB_OPCODE_BINARY,          /* R[a] := R[b] <operator> R[c]              */
+    CB_OPCODE_UNARY,           /* R[a] := <operator> R[b]                   */
+    CB_OPCODE_JUMP,            /* goto b                                    */
+    CB_OPCODE_JUMP_IF_FALSE,   /* if not R[a] then goto b                   */
+    CB_OPCODE_JUMP_IF_BOOLEAN, /* if R[a] is the boolean c then goto b      */
+    CB_OPCODE_RETURN           /* return R[a]                               */
+} CbOpcode;
+
+/**
+ * @struct CbInstruction
+ * @brief  A single instruction of the virtual machine
+ */
+typedef struct CbInstruction
+{
+    unsigned char opcode;        /* CbOpcode                                */
+    unsigned char operator_type; /* CbBinaryOperatorType/CbUnaryOperatorType */
+    unsigned short a;            /* destination/condition register          */
+    unsigned int b;              /* operand register, constant or target    */
+    unsigned int c;              /* operand register                        */
+} CbInstruction;
+
+/**
+ * @brief Maximum number of registers addressable by an instruction
+ */
+#define CB_BYTECODE_MAX_REGISTERS 65536
+
+
+/**
+ * @memberof CbBytecode
+ * @brief    Constructor
+ */
+CbBytecode* cb_bytecode_create();
+
+/**
+ * @memberof CbBytecode
+ * @brief    Destructor
+ * 
+ * @param self The CbBytecode instance
+ */
+void cb_bytecode_destroy(CbBytecode* self);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Append an instruction
+ * 
+ * @param self          The CbBytecode instance
+ * @param opcode        The operation code
+ * @param operator_type The operator of a unary or binary operation
+ * @param a             First operand
+ * @param b             Second operand
+ * @param c             Third operand
+ * @param line          Source line of the instruction (for error messages)
+ * 
+ * @return Returns the index (address) of the appended instruction.
+ */
+size_t cb_bytecode_emit(CbBytecode* self,
+                        CbOpcode opcode,
+                        int operator_type,
+                        unsigned int a,
+                        unsigned int b,
+                        unsigned int c,
+                        int line);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Set the jump target of a previously emitted jump instruction
+ * 
+ * @param self   The CbBytecode instance
+ * @param index  Index of the jump instruction
+ * @param target Index of the instruction to jump to
+ */
+void cb_bytecode_patch_jump(CbBytecode* self, size_t index, size_t target);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Add a value to the constant pool
+ * 
+ * @param self  The CbBytecode instance
+ * @param value The constant value (will be copied)
+ * 
+ * @return Returns the index of the constant in the constant pool.
+ */
+size_t cb_bytecode_add_constant(CbBytecode* self, const CbVariant* value);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Get the number of instructions
+ * 
+ * @param self The CbBytecode instance
+ */
+size_t cb_bytecode_get_count(const CbBytecode* self);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Get the instruction sequence
+ * 
+ * @param self The CbBytecode instance
+ */
+const CbInstruction* cb_bytecode_get_instructions(const CbBytecode* self);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Get a value from the constant pool
+ * 
+ * @param self  The CbBytecode instance
+ * @param index Index of the constant
+ */
+const CbVariant* cb_bytecode_get_constant(const CbBytecode* self, size_t index);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Get the source line of an instruction
+ * 
+ * @param self  The CbBytecode instance
+ * @param index Index of the instruction
+ */
+int cb_bytecode_get_line(const CbBytecode* self, size_t index);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Set the number of registers requiered to execute the bytecode
+ * 
+ * @param self  The CbBytecode instance
+ * @param count Number of registers
+ */
+void cb_bytecode_set_register_count(CbBytecode* self, size_t count);
+
+/**
+ * @memberof CbBytecode
+ * @brief    Get the number of registers requiered to execute the bytecode
+ * 
+ * @param self The CbBytecode instance
+ */
+size_t cb_bytecode_get_register_count(const CbBytecode* self);
+
+
+#endif /* BYTECODE_H */
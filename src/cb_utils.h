@@ -24,9 +24,44 @@ void _cb_abort(const char* message,
                const int line,
                const char* function);
 #else
+#include <assert.h>
+#include <stdlib.h>
+
 #define cb_assert(condition) do { assert(condition); } while (0)
 #define cb_abort(message) do { abort(); } while (0)
 #endif /* DEBUG */
 
+/*
+ * Storage class for thread local variables
+ * NOTE: Thread local storage is not part of C99, so the compiler specific
+ *       extension is used.
+ */
+#ifdef _MSC_VER
+#define CB_THREAD_LOCAL __declspec(thread)
+#else
+#define CB_THREAD_LOCAL __thread
+#endif
+
+/*
+ * Atomically load, increment or decrement a counter of type long (the latter
+ * return the new value), e.g. for reference counts of data shared between
+ * threads
+ * NOTE: Atomic operations are not part of C99 either, so the compiler specific
+ *       intrinsics are used.
+ */
+#ifdef _MSC_VER
+#include <intrin.h>
+#define cb_atomic_load(counter)      (*(volatile long*) (counter))
+#define cb_atomic_increment(counter) _InterlockedIncrement(counter)
+#define cb_atomic_decrement(counter) _InterlockedDecrement(counter)
+#else
+#define cb_atomic_load(counter) \
+        __atomic_load_n(counter, __ATOMIC_ACQUIRE)
+#define cb_atomic_increment(counter) \
+        __atomic_add_fetch(counter, 1, __ATOMIC_RELAXED)
+#define cb_atomic_decrement(counter) \
+        __atomic_sub_fetch(counter, 1, __ATOMIC_ACQ_REL)
+#endif
+
 
 #endif /* CB_UTILS_H */
@@ -5,10 +5,12 @@
 #include <stdarg.h>
 #include "utils.h"
 #include "variant.h"
+#include "arena.h"
 #include "ast.h"
 #include "ast_value.h"
 #include "ast_unary.h"
 #include "ast_binary.h"
+#include "ast_logical.h"
 #include "ast_variable.h"
 #include "ast_assignment.h"
 #include "ast_declaration.h"
@@ -17,21 +19,28 @@
 #include "ast_statement_list.h"
 
 
-extern int yychar;
-extern int yylineno;
+/* opaque scanner type of the reentrant lexer (see cbc_lexer.l) */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
 
-extern int yylex();
-void yyerror(void* data, const char* format, ...);
+void yyerror(yyscan_t scanner,
+             CbAstNode** result_ast,
+             CbArena* arena,
+             const char* format, ...);
 
 }
 
-%{
+%code {
 
-%}
+#include "cbc_lexer.h"
+    
+}
 
 %union {
     CbAstNode*        ast;
-    char*             identifier;
+    const char*       identifier;
     CbIntegerDataType integer_val;
     CbFloatDataType   float_val;
     CbBooleanDataType boolean_val;
@@ -60,23 +69,22 @@ void yyerror(void* data, const char* format, ...);
             var_declaration var_declaration_block var_declaration_list
             var_access
 
+/*
+ * Pure (reentrant) parser: All state is kept in the parser's stack and in the
+ * scanner instance, so several codeblocks can be parsed at the same time.
+ */
+%define api.pure full
+%lex-param   {yyscan_t scanner}
+%parse-param {yyscan_t scanner}
 /* Output parameter: The AST of the parsed codeblock */
 %parse-param {CbAstNode** result_ast}
-%error-verbose
-
-/* Destructors: Destroy discarded symbols in case of errors */
-%destructor {
-    cb_ast_node_destroy($$);
-} expression statement statement_list var_declaration var_access
-
 /*
- * TODO: The following destructor might be useless or even wrong, since the 
- *       identifier string is already freed right after usage.
- *       (see expression rule for IDENTIFIER)
+ * The arena, that owns all nodes of the AST (see arena.h).
+ * NOTE: Discarded symbols need no destructors in case of errors, since all
+ *       nodes and strings (see cbc_lexer.l) are released with the arena.
  */
-%destructor {
-    free($$);
-} IDENTIFIER
+%parse-param {CbArena* arena}
+%error-verbose
 
 
 %%  /* RULES ---------------------------------------------------------------- */
@@ -89,57 +97,46 @@ program:
                         }
     ;
 
+/*
+ * The statement list is left recursive, so the parser stack does not grow with
+ * the number of statements. The statements are collected in a single
+ * statement list node (see ast_statement_list.h).
+ */
 statement_list:
-    var_declaration_list statement_list {
-                            if ($2 == NULL)
-                                $$ = $1;
-                            else
-                                $$ = cb_ast_statement_list_node_create($1, $2);
+                        { $$ = NULL; }
+    | statement_list var_declaration_list {
+                            $$ = cb_ast_statement_list_node_append(arena, $1, $2);
                             /* do not set line number for this node */
                         }
-    | statement ',' statement_list {
-                            if ($3 == NULL)
-                                $$ = $1;
-                            else
-                                $$ = cb_ast_statement_list_node_create($1, $3);
+    | statement_list statement ',' {
+                            $$ = cb_ast_statement_list_node_append(arena, $1, $2);
                             /* do not set line number for this node */
                         }
-    |                   { $$ = NULL; }
-    ;
-/*
- * Alternative statement list syntax:
- */
-/*
-    statement           { $$ = $1; }
-    | statement_list ',' statement {
-                            $$ = cb_ast_statement_list_node_create($1, $3);
-                        }
     ;
-*/
 
 statement:
     expression          { $$ = $1; }
     | IF expression THEN statement_list ENDIF {
                             $$ = (CbAstNode*) cb_ast_if_node_create(
-                                $2, $4, NULL
+                                arena, $2, $4, NULL
                             );
                             /*
                              * TODO: It might be neccessary to push the line
                              *       number at the opening keyword "if".
-                             *       Otherwise yylineno will correspond to the
-                             *       "endif"s line number.
+                             *       Otherwise the line number will correspond
+                             *       to the "endif"s line number.
                              */
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | IF expression THEN statement_list ELSE statement_list ENDIF {
                             $$ = (CbAstNode*) cb_ast_if_node_create(
-                                $2, $4, $6
+                                arena, $2, $4, $6
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | WHILE expression DO statement_list END {
-                            $$ = (CbAstNode*) cb_ast_while_node_create($2, $4);
-                            cb_ast_node_set_line($$, yylineno);
+                            $$ = (CbAstNode*) cb_ast_while_node_create(arena, $2, $4);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     ;
 
@@ -150,8 +147,8 @@ var_declaration_list:
 
 var_declaration_block:
     var_declaration     {
-                            $$ = (CbAstNode*) cb_ast_declaration_block_node_create();
-                            cb_ast_node_set_line($$, yylineno);
+                            $$ = (CbAstNode*) cb_ast_declaration_block_node_create(arena);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                             cb_ast_declaration_block_node_add(
                                 (CbAstDeclarationBlockNode*) $$,
                                 (CbAstDeclarationNode*) $1
@@ -169,154 +166,166 @@ var_declaration_block:
 var_declaration:
     IDENTIFIER          {
                             $$ = (CbAstNode*) cb_ast_declaration_node_create(
+                                arena,
                                 CB_AST_DECLARATION_TYPE_VARIABLE,
                                 $1
                             );
-                            cb_ast_node_set_line($$, yylineno);
-                            memfree($1); /* free duplicated string */
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     ;
 
 var_access:
     IDENTIFIER          {
-                            $$ = (CbAstNode*) cb_ast_variable_node_create($1);
-                            cb_ast_node_set_line($$, yylineno);
-                            memfree($1); /* free duplicated string */
+                            $$ = (CbAstNode*) cb_ast_variable_node_create(arena, $1);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     ;
 
 expression:
     INTEGER             {
-                            CbVariant* value = cb_integer_create($1);
-                            $$ = (CbAstNode*) cb_ast_value_node_create(value);
-                            cb_ast_node_set_line($$, yylineno);
-                            cb_variant_destroy(value);
+                            CbVariant value = cb_integer_make($1);
+                            $$ = (CbAstNode*) cb_ast_value_node_create(arena, &value);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | FLOAT             {
-                            CbVariant* value = cb_float_create($1);
-                            $$ = (CbAstNode*) cb_ast_value_node_create(value);
-                            cb_ast_node_set_line($$, yylineno);
-                            cb_variant_destroy(value);
+                            CbVariant value = cb_float_make($1);
+                            $$ = (CbAstNode*) cb_ast_value_node_create(arena, &value);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | BOOLEAN           {
-                            CbVariant* value = cb_boolean_create($1);
-                            $$ = (CbAstNode*) cb_ast_value_node_create(value);
-                            cb_ast_node_set_line($$, yylineno);
-                            cb_variant_destroy(value);
+                            CbVariant value = cb_boolean_make($1);
+                            $$ = (CbAstNode*) cb_ast_value_node_create(arena, &value);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | STRING            {
-                            CbVariant* value = cb_string_create($1);
-                            memfree($1); /* free duplicated string */
-                            $$ = (CbAstNode*) cb_ast_value_node_create(value);
-                            cb_ast_node_set_line($$, yylineno);
-                            cb_variant_destroy(value);
+                            /* the value node copies the string into the arena */
+                            CbVariant value = cb_string_make($1);
+                            $$ = (CbAstNode*) cb_ast_value_node_create(arena, &value);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
+                            cb_variant_release(&value);
                         }
     | var_access        {
                             $$ = $1;
                         }
     | var_access ASSIGNMENT expression {
                             $$ = (CbAstNode*) cb_ast_assignment_node_create(
+                                arena,
                                 $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression COMPARISON_EQ expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ, $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression COMPARISON_GT expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_COMPARISON_GT, $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression COMPARISON_LT expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_COMPARISON_LT, $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression COMPARISON_SE expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_COMPARISON_SE, $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression COMPARISON_GE expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_COMPARISON_GE, $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression COMPARISON_LE expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_COMPARISON_LE, $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression COMPARISON_NE expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_COMPARISON_NE, $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression '+' expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_ADD,
                                 $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression '-' expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_SUB,
                                 $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression '*' expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_MUL,
                                 $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression '/' expression {
                             $$ = (CbAstNode*) cb_ast_binary_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_DIV,
                                 $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression LOGICAL_AND expression {
-                            $$ = (CbAstNode*) cb_ast_binary_node_create(
+                            $$ = (CbAstNode*) cb_ast_logical_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_LOGICAL_AND,
                                 $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | expression LOGICAL_OR expression {
-                            $$ = (CbAstNode*) cb_ast_binary_node_create(
+                            $$ = (CbAstNode*) cb_ast_logical_node_create(
+                                arena,
                                 CB_BINARY_OPERATOR_TYPE_LOGICAL_OR,
                                 $1, $3
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | '-' expression    {
                             $$ = (CbAstNode*) cb_ast_unary_node_create(
+                                arena,
                                 CB_UNARY_OPERATOR_TYPE_MINUS,
                                 $2
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | LOGICAL_NOT expression {
                             $$ = (CbAstNode*) cb_ast_unary_node_create(
+                                arena,
                                 CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT,
                                 $2
                             );
-                            cb_ast_node_set_line($$, yylineno);
+                            cb_ast_node_set_line($$, yyget_lineno(scanner));
                         }
     | '(' expression ')' {  $$ = $2; }
     ;
@@ -325,7 +334,10 @@ expression:
 %%  /* ROUTINES ------------------------------------------------------------- */
 
 
-void yyerror(void* data, const char* format, ...)
+void yyerror(yyscan_t scanner,
+             CbAstNode** result_ast,
+             CbArena* arena,
+             const char* format, ...)
 {
     va_list arglist;
     va_start(arglist, format);
@@ -3,8 +3,14 @@
 #include "error_handling.h"
 #include "symbol_table.h"
 #include "ast.h"
+#include "ast_profiler.h"
+#include "optimizer.h"
+#include "bytecode.h"
+#include "compiler.h"
+#include "vm.h"
+#include "worker_pool.h"
+#include "cbc_parser.h" /* must be included before the lexer header */
 #include "cbc_lexer.h"
-#include "cbc_parser.h"
 #include "codeblock.h"
 
 
@@ -22,7 +28,14 @@ struct CbCodeblock
 {
     CbVariant* result;
     CbSymbolTable* symbols;
+    CbArena* arena; /* owns the AST */
     CbAstNode* ast;
+    CbBytecode* bytecode;
+    CbCodeblockEngine engine;
+    size_t thread_count;
+    CbWorkerPool* workers; /* started by the first threaded batch */
+    bool profiling;
+    CbAstProfiler* profiler; /* profile of the last execution */
     enum CbCodeblockState state;
 };
 
@@ -32,13 +45,28 @@ struct CbCodeblock
 /*
  * Parse the codeblock (internal)
  */
-static bool cb_codeblock_parse_internal(CbCodeblock* self);
+static bool cb_codeblock_parse_internal(CbCodeblock* self, yyscan_t scanner);
 
 /*
  * Reset codeblock state.
  */
 static void cb_codeblock_reset(CbCodeblock* self);
 
+/*
+ * Lookup the slots of the input variables of a program.
+ * Returns false, if an input variable is not declared.
+ */
+static bool cb_codeblock_lookup_inputs(const CbProgram* program,
+                                       const char* const* input_names,
+                                       size_t input_count,
+                                       size_t* slots);
+
+/*
+ * Get the pool of worker threads for a batch execution.
+ * Returns NULL, if the batch is executed by the calling thread.
+ */
+static CbWorkerPool* cb_codeblock_get_workers(CbCodeblock* self);
+
 
 /* -------------------------------------------------------------------------- */
 
@@ -46,9 +74,16 @@ CbCodeblock* cb_codeblock_create()
 {
     CbCodeblock* self = memalloc(sizeof(CbCodeblock));
     
-    self->result  = NULL;
-    self->ast     = NULL;
-    self->state   = CB_STATE_READY;
+    self->result   = NULL;
+    self->arena    = NULL;
+    self->ast      = NULL;
+    self->bytecode = NULL;
+    self->engine       = CB_CODEBLOCK_ENGINE_AST;
+    self->thread_count = 1;
+    self->workers      = NULL;
+    self->profiling    = false;
+    self->profiler     = NULL;
+    self->state        = CB_STATE_READY;
     
     return self;
 }
@@ -56,21 +91,26 @@ CbCodeblock* cb_codeblock_create()
 void cb_codeblock_destroy(CbCodeblock* self)
 {
     cb_codeblock_reset(self);
+    if (self->workers != NULL)
+        cb_worker_pool_destroy(self->workers);
     memfree(self);
 }
 
 bool cb_codeblock_parse_file(CbCodeblock* self, FILE* input)
 {
     bool result = false;
+    yyscan_t scanner;
+    
+    yylex_init(&scanner);
     
     if (input) /* determine input stream */
-        yyin = input;
+        yyset_in(input, scanner);
     else
-        yyin = stdin;
+        yyset_in(stdin, scanner);
     
-    result = cb_codeblock_parse_internal(self);
+    result = cb_codeblock_parse_internal(self, scanner);
     
-    yylex_destroy(); /* cleanup lexer */
+    yylex_destroy(scanner); /* cleanup lexer */
     
     return result;
 }
@@ -78,17 +118,21 @@ bool cb_codeblock_parse_file(CbCodeblock* self, FILE* input)
 bool cb_codeblock_parse_string(CbCodeblock* self, const char* string)
 {
     bool result = false;
+    yyscan_t scanner;
+    YY_BUFFER_STATE buffer_state;
     
-    YY_BUFFER_STATE buffer_state = yy_scan_string(string);
-    result = cb_codeblock_parse_internal(self);
+    yylex_init(&scanner);
+    
+    buffer_state = yy_scan_string(string, scanner);
+    result       = cb_codeblock_parse_internal(self, scanner);
     
     /* 
      * Cleanup
      * NOTE: Delete the buffer BEFORE calling yylex_destroy(), otherwise
      *       memory-leaks will occur!
      */
-    yy_delete_buffer(buffer_state);
-    yylex_destroy();
+    yy_delete_buffer(buffer_state, scanner);
+    yylex_destroy(scanner);
     
     return result;
 }
@@ -113,8 +157,25 @@ bool cb_codeblock_execute(CbCodeblock* self)
     else
     {
         symbols = cb_symbol_table_create();
-        result  = cb_ast_node_check_semantic(self->ast, symbols);
-        if (result) self->result = cb_ast_node_eval(self->ast, symbols);
+        result  = cb_ast_node_check_semantic(self->ast, symbols) &&
+                  cb_optimizer_optimize(self->arena, &self->ast);
+        if (result)
+        {
+            if (self->engine == CB_CODEBLOCK_ENGINE_VM)
+            {
+                self->bytecode = cb_compiler_compile(self->ast);
+                self->result   = cb_vm_execute(self->bytecode);
+            }
+            else if (self->profiling)
+            {
+                self->profiler = cb_ast_profiler_create();
+                cb_ast_profiler_attach(self->profiler, self->ast);
+                self->result = cb_ast_node_eval(self->ast, symbols);
+                cb_ast_profiler_detach(self->profiler);
+            }
+            else
+                self->result = cb_ast_node_eval(self->ast, symbols);
+        }
         
         if (cb_error_occurred())
         {
@@ -130,6 +191,177 @@ bool cb_codeblock_execute(CbCodeblock* self)
     return result;
 }
 
+CbProgram* cb_codeblock_compile(CbCodeblock* self)
+{
+    CbProgram* result      = NULL;
+    CbBytecode* bytecode   = NULL;
+    CbSymbolTable* symbols = NULL;
+    
+    cb_assert(self->state == CB_STATE_PARSED);
+    
+    symbols = cb_symbol_table_create();
+    
+    if (self->ast != NULL &&
+        (!cb_ast_node_check_semantic(self->ast, symbols) ||
+         !cb_optimizer_optimize(self->arena, &self->ast)))
+    {
+        cb_error_process();
+        cb_symbol_table_destroy(symbols);
+    }
+    else
+    {
+        if (self->ast != NULL && self->engine == CB_CODEBLOCK_ENGINE_VM)
+            bytecode = cb_compiler_compile(self->ast);
+        
+        /* the program takes ownership of the AST */
+        result      = cb_program_create(self->arena, self->ast, symbols,
+                                        bytecode);
+        self->arena = NULL;
+        self->ast   = NULL;
+    }
+    
+    cb_codeblock_reset(self);
+    
+    return result;
+}
+
+bool cb_codeblock_execute_batch(CbCodeblock* self,
+                                const char* const* input_names,
+                                size_t input_count,
+                                const CbVariant* inputs,
+                                size_t record_count,
+                                CbVariant* results)
+{
+    size_t* slots      = NULL;
+    bool result        = true;
+    CbProgram* program = cb_codeblock_compile(self);
+    
+    if (program == NULL)
+        return false;
+    
+    if (input_count > 0)
+        slots = memalloc(input_count * sizeof(size_t));
+    
+    result = cb_codeblock_lookup_inputs(program, input_names, input_count,
+                                        slots);
+    if (result)
+        result = cb_program_execute_batch(program, slots, input_count, inputs,
+                                          record_count, results,
+                                          cb_codeblock_get_workers(self));
+    
+    if (slots != NULL)
+        memfree(slots);
+    cb_program_destroy(program);
+    
+    return result;
+}
+
+bool cb_codeblock_execute_columns(CbCodeblock* self,
+                                  const char* const* input_names,
+                                  const CbColumn* columns,
+                                  size_t input_count,
+                                  size_t row_count,
+                                  CbVariant* results)
+{
+    size_t i;
+    size_t k;
+    size_t* slots      = NULL;
+    CbVariant* inputs;
+    CbColumnarProgram* columnar;
+    bool result        = true;
+    CbProgram* program = cb_codeblock_compile(self);
+    
+    if (program == NULL)
+        return false;
+    
+    if (input_count > 0)
+        slots = memalloc(input_count * sizeof(size_t));
+    
+    result = cb_codeblock_lookup_inputs(program, input_names, input_count,
+                                        slots);
+    if (result)
+    {
+        columnar = cb_columnar_program_create(program);
+        
+        if (columnar != NULL)
+        {
+            result = cb_columnar_program_execute(columnar, slots, columns,
+                                                 input_count, row_count,
+                                                 results);
+            cb_columnar_program_destroy(columnar);
+        }
+        else
+        {
+            /* no pure expression -> evaluate the rows one by one */
+            inputs = memalloc((row_count * input_count + 1) * sizeof(CbVariant));
+            for (i = 0; i < row_count; i++)
+            {
+                for (k = 0; k < input_count; k++)
+                    inputs[i * input_count + k] =
+                        cb_column_get_value(&columns[k], i);
+            }
+            
+            result = cb_program_execute_batch(program, slots, input_count,
+                                              inputs, row_count, results,
+                                              cb_codeblock_get_workers(self));
+            memfree(inputs);
+            
+            /* same as the columnar evaluation: all or nothing */
+            for (i = 0; !result && i < row_count; i++)
+                cb_variant_release(&results[i]);
+        }
+    }
+    
+    if (slots != NULL)
+        memfree(slots);
+    cb_program_destroy(program);
+    
+    return result;
+}
+
+void cb_codeblock_set_engine(CbCodeblock* self, CbCodeblockEngine engine)
+{
+    self->engine = engine;
+}
+
+CbCodeblockEngine cb_codeblock_get_engine(const CbCodeblock* self)
+{
+    return self->engine;
+}
+
+void cb_codeblock_set_thread_count(CbCodeblock* self, size_t thread_count)
+{
+    cb_assert(thread_count > 0);
+    
+    /* the workers are started again by the next threaded batch */
+    if (self->workers != NULL && thread_count != self->thread_count)
+    {
+        cb_worker_pool_destroy(self->workers);
+        self->workers = NULL;
+    }
+    self->thread_count = thread_count;
+}
+
+size_t cb_codeblock_get_thread_count(const CbCodeblock* self)
+{
+    return self->thread_count;
+}
+
+void cb_codeblock_set_profiling(CbCodeblock* self, bool enabled)
+{
+    self->profiling = enabled;
+}
+
+bool cb_codeblock_get_profiling(const CbCodeblock* self)
+{
+    return self->profiling;
+}
+
+const CbAstProfiler* cb_codeblock_get_profiler(const CbCodeblock* self)
+{
+    return self->profiler;
+}
+
 const CbVariant* cb_codeblock_get_result(const CbCodeblock* self)
 {
     cb_assert(self->state == CB_STATE_EXECUTED_SUCCESS);
@@ -140,7 +372,7 @@ const CbVariant* cb_codeblock_get_result(const CbCodeblock* self)
 
 /* -------------------------------------------------------------------------- */
 
-static bool cb_codeblock_parse_internal(CbCodeblock* self)
+static bool cb_codeblock_parse_internal(CbCodeblock* self, yyscan_t scanner)
 {
     bool result = false;
     
@@ -151,8 +383,12 @@ static bool cb_codeblock_parse_internal(CbCodeblock* self)
     cb_codeblock_reset(self);
     
     self->state = CB_STATE_PARSED;
+    self->arena = cb_arena_create();
     
-    switch (yyparse(&self->ast))
+    /* the lexer allocates string literals in the arena as well */
+    yyset_extra(self->arena, scanner);
+    
+    switch (yyparse(scanner, &self->ast, self->arena))
     {
         case 0: result = true; break;
         
@@ -180,12 +416,52 @@ static void cb_codeblock_reset(CbCodeblock* self)
             /* no break! */
         case CB_STATE_EXECUTED_FAILURE:
         case CB_STATE_PARSED:
-            if (self->ast != NULL)
+            /* releases the whole AST at once */
+            if (self->arena != NULL)
+            {
+                cb_arena_destroy(self->arena);
+                self->arena = NULL;
+                self->ast   = NULL;
+            }
+            if (self->bytecode != NULL)
             {
-                cb_ast_node_destroy(self->ast);
-                self->ast = NULL;
+                cb_bytecode_destroy(self->bytecode);
+                self->bytecode = NULL;
+            }
+            if (self->profiler != NULL)
+            {
+                cb_ast_profiler_destroy(self->profiler);
+                self->profiler = NULL;
             }
             self->state = CB_STATE_READY;
             break;
     }
 }
+
+static bool cb_codeblock_lookup_inputs(const CbProgram* program,
+                                       const char* const* input_names,
+                                       size_t input_count,
+                                       size_t* slots)
+{
+    size_t i;
+    
+    for (i = 0; i < input_count; i++)
+    {
+        if (!cb_program_lookup_variable(program, input_names[i], &slots[i]))
+        {
+            cb_error_print_msg("Input variable '%s' is not declared",
+                               input_names[i]);
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static CbWorkerPool* cb_codeblock_get_workers(CbCodeblock* self)
+{
+    if (self->workers == NULL && self->thread_count > 1)
+        self->workers = cb_worker_pool_create(self->thread_count);
+    
+    return self->workers;
+}
@@ -11,12 +11,22 @@
 
 #include <stdio.h>
 #include "variant.h"
+#include "program.h"
+#include "columnar.h"
+#include "ast_profiler.h"
 
 
 /* -------------------------------------------------------------------------- */
 
 typedef struct CbCodeblock CbCodeblock;
 
+/* execution engines */
+typedef enum
+{
+    CB_CODEBLOCK_ENGINE_AST, /* evaluate the AST directly (default)   */
+    CB_CODEBLOCK_ENGINE_VM   /* compile to bytecode and run it in a VM */
+} CbCodeblockEngine;
+
 
 /* -------------------------------------------------------------------------- */
 
@@ -45,6 +55,95 @@ bool cb_codeblock_parse_string(CbCodeblock* self, const char* string);
  */
 bool cb_codeblock_execute(CbCodeblock* self);
 
+/*
+ * Compile the parsed codeblock into a program, which can be executed many
+ * times (see program.h) using the currently selected engine.
+ * The codeblock releases the AST and needs to be parsed again afterwards.
+ * Returns NULL, if the semantic check failed.
+ * NOTE: The returned program must be destroyed by the caller.
+ */
+CbProgram* cb_codeblock_compile(CbCodeblock* self);
+
+/*
+ * Execute the parsed codeblock once for each input record using the configured
+ * number of worker threads (see cb_program_execute_batch()).
+ * The input variables are referred to by their identifiers and must be
+ * declared in the codeblock. Like cb_codeblock_compile(), this releases the
+ * AST of the codeblock.
+ * Returns false, if the semantic check failed, an input variable is not
+ * declared or a runtime error occurred for any record.
+ * NOTE: Each of the record_count results must be released by the caller (see
+ *       cb_variant_release()), unless the semantic check failed or an input
+ *       variable is not declared.
+ */
+bool cb_codeblock_execute_batch(CbCodeblock* self,
+                                const char* const* input_names,
+                                size_t input_count,
+                                const CbVariant* inputs,
+                                size_t record_count,
+                                CbVariant* results);
+
+/*
+ * Execute the parsed codeblock once for each row of the input columns (see
+ * columnar.h). Codeblocks, which consist of a single expression, are evaluated
+ * column by column. Any other codeblock is evaluated row by row like
+ * cb_codeblock_execute_batch().
+ * Returns false, if the semantic check failed, an input variable is not
+ * declared or a runtime error occurred. If a runtime error occurred, all
+ * results are undefined.
+ * NOTE: Each of the row_count results must be released by the caller (see
+ *       cb_variant_release()), unless the semantic check failed or an input
+ *       variable is not declared.
+ */
+bool cb_codeblock_execute_columns(CbCodeblock* self,
+                                  const char* const* input_names,
+                                  const CbColumn* columns,
+                                  size_t input_count,
+                                  size_t row_count,
+                                  CbVariant* results);
+
+/*
+ * Set the number of worker threads used by cb_codeblock_execute_batch().
+ * The threads are started by the first batch with more than one thread and
+ * are kept until the thread count changes or the codeblock is destroyed.
+ */
+void cb_codeblock_set_thread_count(CbCodeblock* self, size_t thread_count);
+
+/*
+ * Get the number of worker threads used by cb_codeblock_execute_batch().
+ */
+size_t cb_codeblock_get_thread_count(const CbCodeblock* self);
+
+/*
+ * Enable or disable profiling of cb_codeblock_execute(): Each node of the AST
+ * is timed and its evaluations are counted (see ast_profiler.h).
+ * NOTE: Only the AST engine can be profiled. Profiling is disabled by default
+ *       and does not cost anything then.
+ */
+void cb_codeblock_set_profiling(CbCodeblock* self, bool enabled);
+
+/*
+ * Check if profiling is enabled.
+ */
+bool cb_codeblock_get_profiling(const CbCodeblock* self);
+
+/*
+ * Get the profile of the last execution (see cb_ast_profiler_report()).
+ * Returns NULL, if the codeblock was not executed with profiling enabled.
+ * NOTE: The profile is released, when the codeblock is parsed again.
+ */
+const CbAstProfiler* cb_codeblock_get_profiler(const CbCodeblock* self);
+
+/*
+ * Select the engine used to execute the codeblock.
+ */
+void cb_codeblock_set_engine(CbCodeblock* self, CbCodeblockEngine engine);
+
+/*
+ * Get the engine used to execute the codeblock.
+ */
+CbCodeblockEngine cb_codeblock_get_engine(const CbCodeblock* self);
+
 /*
  * Get the result of the executed codeblock.
  */
@@ -0,0 +1,1063 @@
+#include <math.h>
+#include <float.h>
+
+#include "utils.h"
+#include "cb_utils.h"
+#include "error_handling.h"
+#include "operation.h"
+#include "ast.h"
+#include "ast_value.h"
+#include "ast_binary.h"
+#include "ast_unary.h"
+#include "ast_variable.h"
+#include "ast_statement_list.h"
+#include "columnar.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+typedef enum
+{
+    CB_COLUMNAR_OPCODE_LOAD_COLUMN,   /* values of an input variable */
+    CB_COLUMNAR_OPCODE_LOAD_CONSTANT, /* constant value for all rows */
+    CB_COLUMNAR_OPCODE_UNARY,         /* unary operation               */
+    CB_COLUMNAR_OPCODE_BINARY         /* binary operation              */
+} CbColumnarOpcode;
+
+/*
+ * Instruction of a columnar program
+ * 
+ * The instructions are stored in post-order, so the operands of an instruction
+ * are always evaluated before the instruction itself. The result of each
+ * instruction is stored in its own block (see CbColumnBlock) and the result of
+ * the last instruction is the result of the expression.
+ */
+typedef struct CbColumnarInstruction
+{
+    CbColumnarOpcode opcode;
+    int operator_type;      /* unary or binary operator                    */
+    size_t a;               /* slot of the variable or left operand        */
+    size_t b;               /* right operand                               */
+    CbVariant constant;     /* constant value (integer, float or boolean)  */
+    const char* identifier; /* identifier of the variable (error messages) */
+    int line;
+} CbColumnarInstruction;
+
+struct CbColumnarProgram
+{
+    CbColumnarInstruction* instructions;
+    size_t count;
+    size_t capacity;
+};
+
+/*
+ * Values of an instruction for a block of rows
+ */
+typedef struct CbColumnBlock
+{
+    CbVariantType type; /* type of all values (only if per_row is false)   */
+    bool per_row;       /* values have different types -> variant values   */
+    
+    union
+    {
+        CbIntegerDataType* integer;
+        CbFloatDataType*   decimal;
+        CbBooleanDataType* boolean;
+        CbVariant*         variant;
+    } values;
+    
+    void* storage;      /* storage for values calculated by the instruction */
+} CbColumnBlock;
+
+/* number of rows evaluated at once (keeps all blocks in the cache) */
+static const size_t CB_COLUMNAR_BLOCK_SIZE       = 1024;
+static const size_t CB_COLUMNAR_INITIAL_CAPACITY = 16;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Find the expression of the codeblock, i.e. skip all leading declarations.
+ * Returns NULL, if the codeblock is not a single expression.
+ */
+static const CbAstNode* cb_columnar_find_expression(const CbAstNode* node);
+
+/*
+ * Compile a pure expression into instructions.
+ * Returns false, if the expression contains any unsupported AST node.
+ */
+static bool cb_columnar_program_compile(CbColumnarProgram* self,
+                                        const CbAstNode* node,
+                                        size_t* index);
+
+/*
+ * Append an instruction and return its index
+ */
+static size_t cb_columnar_program_emit(CbColumnarProgram* self,
+                                       CbColumnarInstruction instruction);
+
+/*
+ * Evaluate an instruction for a block of rows
+ */
+static bool cb_columnar_execute_instruction(
+    const CbColumnarInstruction* instruction,
+    CbColumnBlock* blocks,
+    CbColumnBlock* dest,
+    const CbColumn* column,
+    size_t first,
+    size_t count,
+    CbFloatDataType** scratch
+);
+
+/*
+ * Evaluate a unary operation for a block of rows
+ */
+static bool cb_columnar_unary(CbUnaryOperatorType operator_type,
+                              const CbColumnBlock* value,
+                              CbColumnBlock* dest,
+                              size_t count,
+                              int line);
+
+/*
+ * Evaluate a binary operation for a block of rows
+ */
+static bool cb_columnar_binary(CbBinaryOperatorType operator_type,
+                               const CbColumnBlock* left,
+                               const CbColumnBlock* right,
+                               CbColumnBlock* dest,
+                               size_t count,
+                               int line,
+                               CbFloatDataType** scratch);
+
+/*
+ * Evaluate a binary operation on integer values
+ */
+static bool cb_columnar_binary_integer(CbBinaryOperatorType operator_type,
+                                       const CbIntegerDataType* restrict left,
+                                       const CbIntegerDataType* restrict right,
+                                       CbColumnBlock* dest,
+                                       size_t count,
+                                       int line);
+
+/*
+ * Divide integer values: The result of a row is a float value, if the
+ * division yields a real number (see cb_binary_operation_eval()).
+ */
+static bool cb_columnar_divide_integer(const CbIntegerDataType* restrict left,
+                                       const CbIntegerDataType* restrict right,
+                                       CbColumnBlock* dest,
+                                       size_t count,
+                                       int line);
+
+/*
+ * Evaluate a binary operation on float values
+ */
+static bool cb_columnar_binary_float(CbBinaryOperatorType operator_type,
+                                     const CbFloatDataType* restrict left,
+                                     const CbFloatDataType* restrict right,
+                                     CbColumnBlock* dest,
+                                     size_t count,
+                                     int line);
+
+/*
+ * Evaluate a binary operation on boolean values
+ */
+static void cb_columnar_binary_boolean(CbBinaryOperatorType operator_type,
+                                       const CbBooleanDataType* restrict left,
+                                       const CbBooleanDataType* restrict right,
+                                       CbColumnBlock* dest,
+                                       size_t count);
+
+/*
+ * Evaluate a binary operation row by row (values with different types)
+ */
+static bool cb_columnar_binary_per_row(CbBinaryOperatorType operator_type,
+                                       const CbColumnBlock* left,
+                                       const CbColumnBlock* right,
+                                       CbColumnBlock* dest,
+                                       size_t count,
+                                       int line);
+
+/*
+ * Prepare a block to store values of a specific type
+ */
+static void cb_column_block_prepare(CbColumnBlock* self, CbVariantType type);
+
+/*
+ * Prepare a block to store values of different types
+ */
+static void cb_column_block_prepare_per_row(CbColumnBlock* self);
+
+/*
+ * Get the value of a row of a block
+ */
+static CbVariant cb_column_block_get_value(const CbColumnBlock* self,
+                                           size_t row);
+
+/*
+ * Get the values of a numeric block as float values
+ */
+static const CbFloatDataType* cb_column_block_as_float(const CbColumnBlock* self,
+                                                       size_t count,
+                                                       CbFloatDataType* scratch);
+
+/*
+ * Store the values of a block as variant values
+ */
+static void cb_column_block_store(const CbColumnBlock* self,
+                                  size_t count,
+                                  CbVariant* results);
+
+/*
+ * Compare two float values
+ * NOTE: Same as dequal() (see utils.h), but can be inlined by the compiler.
+ */
+static bool cb_columnar_dequal(CbFloatDataType a, CbFloatDataType b);
+
+
+/* -------------------------------------------------------------------------- */
+
+CbColumn cb_integer_column(const CbIntegerDataType* values)
+{
+    CbColumn result;
+    result.type           = CB_VARIANT_TYPE_INTEGER;
+    result.values.integer = values;
+    return result;
+}
+
+CbColumn cb_float_column(const CbFloatDataType* values)
+{
+    CbColumn result;
+    result.type           = CB_VARIANT_TYPE_FLOAT;
+    result.values.decimal = values;
+    return result;
+}
+
+CbColumn cb_boolean_column(const CbBooleanDataType* values)
+{
+    CbColumn result;
+    result.type           = CB_VARIANT_TYPE_BOOLEAN;
+    result.values.boolean = values;
+    return result;
+}
+
+CbVariant cb_column_get_value(const CbColumn* self, size_t row)
+{
+    CbVariant result;
+    
+    switch (self->type)
+    {
+        case CB_VARIANT_TYPE_INTEGER:
+            result = cb_integer_make(self->values.integer[row]); break;
+        
+        case CB_VARIANT_TYPE_FLOAT:
+            result = cb_float_make(self->values.decimal[row]); break;
+        
+        case CB_VARIANT_TYPE_BOOLEAN:
+            result = cb_boolean_make(self->values.boolean[row]); break;
+        
+        default: cb_abort("Invalid column type"); break;
+    }
+    
+    return result;
+}
+
+CbColumnarProgram* cb_columnar_program_create(const CbProgram* program)
+{
+    size_t index;
+    const CbAstNode* expression;
+    CbColumnarProgram* self = memalloc(sizeof(CbColumnarProgram));
+    
+    self->count        = 0;
+    self->capacity     = CB_COLUMNAR_INITIAL_CAPACITY;
+    self->instructions = memalloc(self->capacity *
+                                  sizeof(CbColumnarInstruction));
+    
+    expression = cb_columnar_find_expression(cb_program_get_ast(program));
+    
+    if (expression == NULL ||
+        !cb_columnar_program_compile(self, expression, &index))
+    {
+        cb_columnar_program_destroy(self);
+        self = NULL;
+    }
+    
+    return self;
+}
+
+void cb_columnar_program_destroy(CbColumnarProgram* self)
+{
+    memfree(self->instructions);
+    memfree(self);
+}
+
+bool cb_columnar_program_execute(const CbColumnarProgram* self,
+                                 const size_t* input_slots,
+                                 const CbColumn* columns,
+                                 size_t input_count,
+                                 size_t row_count,
+                                 CbVariant* results)
+{
+    size_t i;
+    size_t k;
+    size_t first;
+    size_t count;
+    CbFloatDataType* scratch[2];
+    const CbColumnarInstruction* instruction;
+    bool success           = true;
+    CbColumnBlock* blocks  = memalloc(self->count * sizeof(CbColumnBlock));
+    const CbColumn** bound = memalloc(self->count * sizeof(CbColumn*));
+    
+    scratch[0] = memalloc(CB_COLUMNAR_BLOCK_SIZE * sizeof(CbFloatDataType));
+    scratch[1] = memalloc(CB_COLUMNAR_BLOCK_SIZE * sizeof(CbFloatDataType));
+    
+    for (i = 0; i < self->count; i++)
+    {
+        instruction = &self->instructions[i];
+        bound[i]    = NULL;
+        
+        /* bind the input columns */
+        if (instruction->opcode == CB_COLUMNAR_OPCODE_LOAD_COLUMN)
+        {
+            for (k = 0; k < input_count && bound[i] == NULL; k++)
+            {
+                if (input_slots[k] == instruction->a)
+                    bound[i] = &columns[k];
+            }
+            
+            if (success && bound[i] == NULL)
+            {
+                cb_error_trigger(CB_ERROR_RUNTIME, instruction->line,
+                                 "variable '%s' is not bound to a column",
+                                 instruction->identifier);
+                success = false;
+            }
+        }
+        
+        /* a block can store any kind of values */
+        blocks[i].storage = memalloc(CB_COLUMNAR_BLOCK_SIZE * sizeof(CbVariant));
+    }
+    
+    for (first = 0; success && first < row_count; first += count)
+    {
+        count = row_count - first;
+        if (count > CB_COLUMNAR_BLOCK_SIZE)
+            count = CB_COLUMNAR_BLOCK_SIZE;
+        
+        for (i = 0; success && i < self->count; i++)
+        {
+            success = cb_columnar_execute_instruction(&self->instructions[i],
+                                                      blocks, &blocks[i],
+                                                      bound[i], first, count,
+                                                      scratch);
+        }
+        
+        if (success)
+            cb_column_block_store(&blocks[self->count - 1], count,
+                                  &results[first]);
+    }
+    
+    if (!success)
+    {
+        /* NOTE: The results do not own any memory (no strings) */
+        for (i = 0; i < row_count; i++)
+            results[i] = cb_variant_make();
+        
+        cb_error_process();
+    }
+    
+    for (i = 0; i < self->count; i++)
+        memfree(blocks[i].storage);
+    memfree(blocks);
+    memfree(bound);
+    memfree(scratch[0]);
+    memfree(scratch[1]);
+    
+    return success;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static const CbAstNode* cb_columnar_find_expression(const CbAstNode* node)
+{
+    const CbAstStatementListNode* list;
+    CbAstType type;
+    size_t count;
+    size_t i;
+    
+    if (node == NULL ||
+        cb_ast_node_get_type(node) != CB_AST_TYPE_STATEMENT_LIST)
+        return node;
+    
+    /* all statements except for the last one must be declarations */
+    list  = (const CbAstStatementListNode*) node;
+    count = cb_ast_statement_list_node_get_count(list);
+    for (i = 0; i + 1 < count; i++)
+    {
+        type = cb_ast_node_get_type(cb_ast_statement_list_node_get(list, i));
+        if (type != CB_AST_TYPE_DECLARATION &&
+            type != CB_AST_TYPE_DECLARATION_BLOCK)
+            return NULL;
+    }
+    
+    return cb_ast_statement_list_node_get(list, count - 1);
+}
+
+static bool cb_columnar_program_compile(CbColumnarProgram* self,
+                                        const CbAstNode* node,
+                                        size_t* index)
+{
+    const CbVariant* value;
+    const CbAstVariableNode* variable;
+    CbColumnarInstruction instruction;
+    bool result = true;
+    
+    instruction.operator_type = 0;
+    instruction.a             = 0;
+    instruction.b             = 0;
+    instruction.constant      = cb_variant_make();
+    instruction.identifier    = NULL;
+    instruction.line          = cb_ast_node_get_line(node);
+    
+    switch (cb_ast_node_get_type(node))
+    {
+        case CB_AST_TYPE_VALUE:
+            value = cb_ast_value_node_get_value((const CbAstValueNode*) node);
+            /* only values without any heap memory are supported */
+            result = cb_variant_is_numeric(value) ||
+                     cb_variant_is_boolean(value);
+            
+            instruction.opcode   = CB_COLUMNAR_OPCODE_LOAD_CONSTANT;
+            instruction.constant = *value;
+            break;
+        
+        case CB_AST_TYPE_VARIABLE:
+            variable = (const CbAstVariableNode*) node;
+            result   = cb_ast_variable_node_get_scope_depth(variable) == 0;
+            
+            instruction.opcode     = CB_COLUMNAR_OPCODE_LOAD_COLUMN;
+            instruction.a          = cb_ast_variable_node_get_slot(variable);
+            instruction.identifier =
+                cb_ast_variable_node_get_identifier(variable);
+            break;
+        
+        case CB_AST_TYPE_UNARY:
+            result = cb_columnar_program_compile(self,
+                                                 cb_ast_node_get_left(node),
+                                                 &instruction.a);
+            
+            instruction.opcode        = CB_COLUMNAR_OPCODE_UNARY;
+            instruction.operator_type = cb_ast_unary_node_get_operator_type(
+                (const CbAstUnaryNode*) node
+            );
+            break;
+        
+        case CB_AST_TYPE_BINARY:
+            result = cb_columnar_program_compile(self,
+                                                 cb_ast_node_get_left(node),
+                                                 &instruction.a) &&
+                     cb_columnar_program_compile(self,
+                                                 cb_ast_node_get_right(node),
+                                                 &instruction.b);
+            
+            instruction.opcode        = CB_COLUMNAR_OPCODE_BINARY;
+            instruction.operator_type = cb_ast_binary_node_get_operator_type(
+                (const CbAstBinaryNode*) node
+            );
+            break;
+        
+        /*
+         * NOTE: Logical operations are not compiled, since short-circuit
+         *       evaluation skips the right operand for some rows, which might
+         *       fail for these rows (e.g. with a type error). The program
+         *       falls back to the row by row evaluation for them.
+         */
+        /* any other node is not a pure expression */
+        default: result = false; break;
+    }
+    
+    if (result)
+        *index = cb_columnar_program_emit(self, instruction);
+    
+    return result;
+}
+
+static size_t cb_columnar_program_emit(CbColumnarProgram* self,
+                                       CbColumnarInstruction instruction)
+{
+    if (self->count == self->capacity)
+    {
+        self->capacity    *= 2;
+        self->instructions = memrealloc(self->instructions,
+                                        self->capacity *
+                                        sizeof(CbColumnarInstruction));
+    }
+    
+    self->instructions[self->count] = instruction;
+    
+    return self->count++;
+}
+
+static bool cb_columnar_execute_instruction(
+    const CbColumnarInstruction* instruction,
+    CbColumnBlock* blocks,
+    CbColumnBlock* dest,
+    const CbColumn* column,
+    size_t first,
+    size_t count,
+    CbFloatDataType** scratch
+)
+{
+    size_t i;
+    bool result = true;
+    
+    switch (instruction->opcode)
+    {
+        case CB_COLUMNAR_OPCODE_LOAD_COLUMN:
+            /* refer to the values of the column directly (no copy) */
+            dest->type    = column->type;
+            dest->per_row = false;
+            switch (column->type)
+            {
+                case CB_VARIANT_TYPE_INTEGER:
+                    dest->values.integer =
+                        (CbIntegerDataType*) column->values.integer + first;
+                    break;
+                
+                case CB_VARIANT_TYPE_FLOAT:
+                    dest->values.decimal =
+                        (CbFloatDataType*) column->values.decimal + first;
+                    break;
+                
+                case CB_VARIANT_TYPE_BOOLEAN:
+                    dest->values.boolean =
+                        (CbBooleanDataType*) column->values.boolean + first;
+                    break;
+                
+                default: cb_abort("Invalid column type"); break;
+            }
+            break;
+        
+        case CB_COLUMNAR_OPCODE_LOAD_CONSTANT:
+            cb_column_block_prepare(dest,
+                                    cb_variant_get_type(&instruction->constant));
+            switch (dest->type)
+            {
+                case CB_VARIANT_TYPE_INTEGER:
+                    for (i = 0; i < count; i++)
+                        dest->values.integer[i] =
+                            cb_integer_get_value(&instruction->constant);
+                    break;
+                
+                case CB_VARIANT_TYPE_FLOAT:
+                    for (i = 0; i < count; i++)
+                        dest->values.decimal[i] =
+                            cb_float_get_value(&instruction->constant);
+                    break;
+                
+                case CB_VARIANT_TYPE_BOOLEAN:
+                    for (i = 0; i < count; i++)
+                        dest->values.boolean[i] =
+                            cb_boolean_get_value(&instruction->constant);
+                    break;
+                
+                default: cb_abort("Invalid constant type"); break;
+            }
+            break;
+        
+        case CB_COLUMNAR_OPCODE_UNARY:
+            result = cb_columnar_unary(
+                (CbUnaryOperatorType) instruction->operator_type,
+                &blocks[instruction->a], dest, count, instruction->line
+            );
+            break;
+        
+        case CB_COLUMNAR_OPCODE_BINARY:
+            result = cb_columnar_binary(
+                (CbBinaryOperatorType) instruction->operator_type,
+                &blocks[instruction->a], &blocks[instruction->b], dest, count,
+                instruction->line, scratch
+            );
+            break;
+        
+        default: cb_abort("Invalid columnar opcode"); break;
+    }
+    
+    return result;
+}
+
+static bool cb_columnar_unary(CbUnaryOperatorType operator_type,
+                              const CbColumnBlock* value,
+                              CbColumnBlock* dest,
+                              size_t count,
+                              int line)
+{
+    size_t i;
+    CbVariant row;
+    
+    if (value->per_row)
+    {
+        cb_column_block_prepare_per_row(dest);
+        for (i = 0; i < count; i++)
+        {
+            row = cb_column_block_get_value(value, i);
+            if (!cb_unary_operation_eval(operator_type, &row, line,
+                                         &dest->values.variant[i]))
+                return false;
+        }
+        return true;
+    }
+    
+    if (!cb_unary_operation_check(operator_type, value->type,
+                                  CB_ERROR_RUNTIME, line))
+        return false;
+    
+    cb_column_block_prepare(dest, value->type);
+    
+    switch (value->type)
+    {
+        case CB_VARIANT_TYPE_INTEGER:
+            for (i = 0; i < count; i++)
+                dest->values.integer[i] = - value->values.integer[i];
+            break;
+        
+        case CB_VARIANT_TYPE_FLOAT:
+            for (i = 0; i < count; i++)
+                dest->values.decimal[i] = - value->values.decimal[i];
+            break;
+        
+        case CB_VARIANT_TYPE_BOOLEAN:
+            for (i = 0; i < count; i++)
+                dest->values.boolean[i] = !value->values.boolean[i];
+            break;
+        
+        default: cb_abort("Invalid unary operation"); break;
+    }
+    
+    return true;
+}
+
+static bool cb_columnar_binary(CbBinaryOperatorType operator_type,
+                               const CbColumnBlock* left,
+                               const CbColumnBlock* right,
+                               CbColumnBlock* dest,
+                               size_t count,
+                               int line,
+                               CbFloatDataType** scratch)
+{
+    bool result = true;
+    
+    if (left->per_row || right->per_row)
+        return cb_columnar_binary_per_row(operator_type, left, right, dest,
+                                          count, line);
+    
+    if (!cb_binary_operation_check(operator_type, left->type, right->type,
+                                   CB_ERROR_RUNTIME, line))
+        return false;
+    
+    /* NOTE: Same promotion rules as cb_binary_operation_eval() */
+    if (cb_variant_type_is_numeric(left->type))
+    {
+        if (left->type == CB_VARIANT_TYPE_FLOAT ||
+            right->type == CB_VARIANT_TYPE_FLOAT)
+            result = cb_columnar_binary_float(
+                operator_type,
+                cb_column_block_as_float(left, count, scratch[0]),
+                cb_column_block_as_float(right, count, scratch[1]),
+                dest, count, line
+            );
+        else
+            result = cb_columnar_binary_integer(operator_type,
+                                                left->values.integer,
+                                                right->values.integer,
+                                                dest, count, line);
+    }
+    else if (left->type == CB_VARIANT_TYPE_BOOLEAN)
+        cb_columnar_binary_boolean(operator_type, left->values.boolean,
+                                   right->values.boolean, dest, count);
+    else
+        cb_abort("Invalid binary operation");
+    
+    return result;
+}
+
+static bool cb_columnar_binary_integer(CbBinaryOperatorType operator_type,
+                                       const CbIntegerDataType* restrict left,
+                                       const CbIntegerDataType* restrict right,
+                                       CbColumnBlock* dest,
+                                       size_t count,
+                                       int line)
+{
+    size_t i;
+    CbIntegerDataType* restrict integer = NULL;
+    CbBooleanDataType* restrict boolean = NULL;
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_DIV:
+            return cb_columnar_divide_integer(left, right, dest, count, line);
+        
+        case CB_BINARY_OPERATOR_TYPE_ADD:
+        case CB_BINARY_OPERATOR_TYPE_SUB:
+        case CB_BINARY_OPERATOR_TYPE_MUL:
+            cb_column_block_prepare(dest, CB_VARIANT_TYPE_INTEGER);
+            integer = dest->values.integer;
+            break;
+        
+        default:
+            cb_column_block_prepare(dest, CB_VARIANT_TYPE_BOOLEAN);
+            boolean = dest->values.boolean;
+            break;
+    }
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_ADD:
+            for (i = 0; i < count; i++)
+                integer[i] = left[i] + right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_SUB:
+            for (i = 0; i < count; i++)
+                integer[i] = left[i] - right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_MUL:
+            for (i = 0; i < count; i++)
+                integer[i] = left[i] * right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GT:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] > right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GE:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] >= right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LT:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] < right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LE:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] <= right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] == right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] != right[i];
+            break;
+        
+        /* invalid binary operator type */
+        default: cb_abort("Invalid binary operator type"); break;
+    }
+    
+    return true;
+}
+
+static bool cb_columnar_divide_integer(const CbIntegerDataType* restrict left,
+                                       const CbIntegerDataType* restrict right,
+                                       CbColumnBlock* dest,
+                                       size_t count,
+                                       int line)
+{
+    size_t i;
+    size_t exact = 0;
+    
+    for (i = 0; i < count; i++)
+    {
+        if (right[i] == 0)
+        {
+            cb_error_trigger(CB_ERROR_RUNTIME, line,
+                             "Division by zero is not allowed");
+            return false;
+        }
+    }
+    
+    for (i = 0; i < count; i++)
+        exact += (left[i] % right[i]) == 0;
+    
+    if (exact == count)
+    {
+        /* no division yields a real number -> integer results */
+        cb_column_block_prepare(dest, CB_VARIANT_TYPE_INTEGER);
+        for (i = 0; i < count; i++)
+            dest->values.integer[i] = left[i] / right[i];
+    }
+    else if (exact == 0)
+    {
+        /* all divisions yield a real number -> float results */
+        cb_column_block_prepare(dest, CB_VARIANT_TYPE_FLOAT);
+        for (i = 0; i < count; i++)
+            dest->values.decimal[i] = (CbFloatDataType) left[i] /
+                                      (CbFloatDataType) right[i];
+    }
+    else
+    {
+        cb_column_block_prepare_per_row(dest);
+        for (i = 0; i < count; i++)
+        {
+            if ((left[i] % right[i]) == 0)
+                dest->values.variant[i] = cb_integer_make(left[i] / right[i]);
+            else
+                dest->values.variant[i] = cb_float_make(
+                    (CbFloatDataType) left[i] / (CbFloatDataType) right[i]
+                );
+        }
+    }
+    
+    return true;
+}
+
+static bool cb_columnar_binary_float(CbBinaryOperatorType operator_type,
+                                     const CbFloatDataType* restrict left,
+                                     const CbFloatDataType* restrict right,
+                                     CbColumnBlock* dest,
+                                     size_t count,
+                                     int line)
+{
+    size_t i;
+    CbFloatDataType* restrict decimal   = NULL;
+    CbBooleanDataType* restrict boolean = NULL;
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_DIV:
+            for (i = 0; i < count; i++)
+            {
+                if (right[i] == 0.0)
+                {
+                    cb_error_trigger(CB_ERROR_RUNTIME, line,
+                                     "Division by zero is not allowed");
+                    return false;
+                }
+            }
+            /* no break! */
+        case CB_BINARY_OPERATOR_TYPE_ADD:
+        case CB_BINARY_OPERATOR_TYPE_SUB:
+        case CB_BINARY_OPERATOR_TYPE_MUL:
+            cb_column_block_prepare(dest, CB_VARIANT_TYPE_FLOAT);
+            decimal = dest->values.decimal;
+            break;
+        
+        default:
+            cb_column_block_prepare(dest, CB_VARIANT_TYPE_BOOLEAN);
+            boolean = dest->values.boolean;
+            break;
+    }
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_ADD:
+            for (i = 0; i < count; i++)
+                decimal[i] = left[i] + right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_SUB:
+            for (i = 0; i < count; i++)
+                decimal[i] = left[i] - right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_MUL:
+            for (i = 0; i < count; i++)
+                decimal[i] = left[i] * right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_DIV:
+            for (i = 0; i < count; i++)
+                decimal[i] = left[i] / right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GT:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] > right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GE:
+            for (i = 0; i < count; i++)
+                boolean[i] = (left[i] > right[i]) ||
+                             cb_columnar_dequal(left[i], right[i]);
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LT:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] < right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LE:
+            for (i = 0; i < count; i++)
+                boolean[i] = (left[i] < right[i]) ||
+                             cb_columnar_dequal(left[i], right[i]);
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+            for (i = 0; i < count; i++)
+                boolean[i] = cb_columnar_dequal(left[i], right[i]);
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+            for (i = 0; i < count; i++)
+                boolean[i] = !cb_columnar_dequal(left[i], right[i]);
+            break;
+        
+        /* invalid binary operator type */
+        default: cb_abort("Invalid binary operator type"); break;
+    }
+    
+    return true;
+}
+
+static void cb_columnar_binary_boolean(CbBinaryOperatorType operator_type,
+                                       const CbBooleanDataType* restrict left,
+                                       const CbBooleanDataType* restrict right,
+                                       CbColumnBlock* dest,
+                                       size_t count)
+{
+    size_t i;
+    CbBooleanDataType* restrict boolean;
+    
+    cb_column_block_prepare(dest, CB_VARIANT_TYPE_BOOLEAN);
+    boolean = dest->values.boolean;
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_LOGICAL_AND:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] && right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_LOGICAL_OR:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] || right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] == right[i];
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+            for (i = 0; i < count; i++)
+                boolean[i] = left[i] != right[i];
+            break;
+        
+        /* invalid binary operator type */
+        default: cb_abort("Invalid binary operator type"); break;
+    }
+}
+
+static bool cb_columnar_binary_per_row(CbBinaryOperatorType operator_type,
+                                       const CbColumnBlock* left,
+                                       const CbColumnBlock* right,
+                                       CbColumnBlock* dest,
+                                       size_t count,
+                                       int line)
+{
+    size_t i;
+    CbVariant lhs;
+    CbVariant rhs;
+    
+    cb_column_block_prepare_per_row(dest);
+    
+    for (i = 0; i < count; i++)
+    {
+        lhs = cb_column_block_get_value(left, i);
+        rhs = cb_column_block_get_value(right, i);
+        if (!cb_binary_operation_eval(operator_type, &lhs, &rhs, line,
+                                      &dest->values.variant[i]))
+            return false;
+    }
+    
+    return true;
+}
+
+static void cb_column_block_prepare(CbColumnBlock* self, CbVariantType type)
+{
+    self->type    = type;
+    self->per_row = false;
+    
+    switch (type)
+    {
+        case CB_VARIANT_TYPE_INTEGER: self->values.integer = self->storage; break;
+        case CB_VARIANT_TYPE_FLOAT:   self->values.decimal = self->storage; break;
+        case CB_VARIANT_TYPE_BOOLEAN: self->values.boolean = self->storage; break;
+        default: cb_abort("Invalid column type"); break;
+    }
+}
+
+static void cb_column_block_prepare_per_row(CbColumnBlock* self)
+{
+    self->type           = CB_VARIANT_TYPE_UNDEFINED;
+    self->per_row        = true;
+    self->values.variant = self->storage;
+}
+
+static CbVariant cb_column_block_get_value(const CbColumnBlock* self,
+                                           size_t row)
+{
+    CbVariant result;
+    
+    if (self->per_row)
+        return self->values.variant[row];
+    
+    switch (self->type)
+    {
+        case CB_VARIANT_TYPE_INTEGER:
+            result = cb_integer_make(self->values.integer[row]); break;
+        
+        case CB_VARIANT_TYPE_FLOAT:
+            result = cb_float_make(self->values.decimal[row]); break;
+        
+        case CB_VARIANT_TYPE_BOOLEAN:
+            result = cb_boolean_make(self->values.boolean[row]); break;
+        
+        default: cb_abort("Invalid column type"); break;
+    }
+    
+    return result;
+}
+
+static const CbFloatDataType* cb_column_block_as_float(const CbColumnBlock* self,
+                                                       size_t count,
+                                                       CbFloatDataType* scratch)
+{
+    size_t i;
+    
+    if (self->type == CB_VARIANT_TYPE_FLOAT)
+        return self->values.decimal;
+    
+    for (i = 0; i < count; i++)
+        scratch[i] = (CbFloatDataType) self->values.integer[i];
+    
+    return scratch;
+}
+
+static void cb_column_block_store(const CbColumnBlock* self,
+                                  size_t count,
+                                  CbVariant* results)
+{
+    size_t i;
+    
+    for (i = 0; i < count; i++)
+        results[i] = cb_column_block_get_value(self, i);
+}
+
+static bool cb_columnar_dequal(CbFloatDataType a, CbFloatDataType b)
+{
+    CbFloatDataType epsilon = (fabs(a) < fabs(b) ? fabs(b) : fabs(a)) *
+                              DBL_EPSILON;
+    return fabs(a - b) < epsilon;
+}
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * @file  columnar.h
+ * @brief Columnar (vectorized) evaluation of pure expressions
+ *
+ * A codeblock, that consists of a single expression built from values,
+ * variables and unary/binary operations (e.g. `|a, b| a * b > 100,`), can be
+ * evaluated over whole columns of input values at once: Each variable is bound
+ * to a contiguous array of integer, float or boolean values and every
+ * operation is applied to a block of rows in a tight loop.
+ *
+ * The results are identical to the row by row evaluation (see operation.h).
+ ******************************************************************************/
+
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "variant.h"
+#include "program.h"
+
+
+/**
+ * @struct CbColumn
+ * @brief  Contiguous array of input values of the same type
+ *
+ * NOTE: The structure is public, so that columns can be described without any
+ *       heap allocation. The values are not owned by the column.
+ */
+typedef struct CbColumn
+{
+    CbVariantType type; /* integer, float or boolean */
+
+    union
+    {
+        const CbIntegerDataType* integer;
+        const CbFloatDataType*   decimal;
+        const CbBooleanDataType* boolean;
+    } values;
+} CbColumn;
+
+/**
+ * @struct CbColumnarProgram
+ * @brief  Compiled columnar expression
+ */
+typedef struct CbColumnarProgram CbColumnarProgram;
+
+
+/**
+ * @memberof CbColumn
+ * @brief    Create an integer column
+ */
+CbColumn cb_integer_column(const CbIntegerDataType* values);
+
+/**
+ * @memberof CbColumn
+ * @brief    Create a float column
+ */
+CbColumn cb_float_column(const CbFloatDataType* values);
+
+/**
+ * @memberof CbColumn
+ * @brief    Create a boolean column
+ */
+CbColumn cb_boolean_column(const CbBooleanDataType* values);
+
+/**
+ * @memberof CbColumn
+ * @brief    Get the value of a row of the column
+ */
+CbVariant cb_column_get_value(const CbColumn* self, size_t row);
+
+/**
+ * @memberof CbColumnarProgram
+ * @brief    Constructor
+ *
+ * @param program The program to evaluate
+ *                (NOTE: The program must outlive the columnar program)
+ *
+ * @return Returns NULL, if the program is not a pure expression and can
+ *         therefore not be evaluated in columnar mode.
+ */
+CbColumnarProgram* cb_columnar_program_create(const CbProgram* program);
+
+/**
+ * @memberof CbColumnarProgram
+ * @brief    Destructor
+ *
+ * @param self The CbColumnarProgram instance
+ */
+void cb_columnar_program_destroy(CbColumnarProgram* self);
+
+/**
+ * @memberof CbColumnarProgram
+ * @brief    Evaluate the expression for each row of the input columns
+ *
+ * @param self         The CbColumnarProgram instance
+ * @param input_slots  Slots of the input variables (input_count items, see
+ *                     cb_program_lookup_variable())
+ * @param columns      Columns of the input variables (input_count items)
+ * @param input_count  Number of input variables
+ * @param row_count    Number of rows of each column
+ * @param results      Caller provided buffer for the results (row_count items).
+ *                     The results must be released by the caller (see
+ *                     cb_variant_release()).
+ *
+ * @return Returns false, if a runtime error occurred. In this case all results
+ *         are undefined.
+ */
+bool cb_columnar_program_execute(const CbColumnarProgram* self,
+                                 const size_t* input_slots,
+                                 const CbColumn* columns,
+                                 size_t input_count,
+                                 size_t row_count,
+                                 CbVariant* results);
+
+
+#endif /* COLUMNAR_H */
@@ -0,0 +1,427 @@
+#include "utils.h"
+#include "cb_utils.h"
+#include "ast.h"
+#include "ast_value.h"
+#include "ast_binary.h"
+#include "ast_logical.h"
+#include "ast_unary.h"
+#include "ast_variable.h"
+#include "ast_control_flow.h"
+#include "ast_statement_list.h"
+#include "compiler.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Compiler state
+ * 
+ * Register layout: Each variable is assigned a fixed register, which equals
+ * its slot in the global scope (resolved during the semantic check). All
+ * registers above are used for temporary values and are allocated in a
+ * stack-like manner.
+ */
+typedef struct CbCompiler
+{
+    CbBytecode* code;
+    size_t variable_count;
+    size_t next_register;  /* next free temporary register       */
+    size_t register_count; /* maximum number of registers in use */
+} CbCompiler;
+
+
+/*
+ * Determine the number of registers requiered for the variables of the AST
+ */
+static void cb_compiler_count_variables(CbCompiler* self,
+                                        const CbAstNode* node);
+
+/*
+ * Get the register of a declared variable
+ */
+static unsigned int cb_compiler_get_variable_register(const CbCompiler* self,
+                                                      const CbAstNode* node);
+
+/*
+ * Allocate a register for a temporary value
+ */
+static unsigned int cb_compiler_allocate_register(CbCompiler* self);
+
+/*
+ * Compile an AST node, so that its value is stored in the register dest
+ */
+static void cb_compiler_compile_node(CbCompiler* self,
+                                     const CbAstNode* node,
+                                     unsigned int dest);
+
+/*
+ * Compile an operand of an operation and return the register holding its
+ * value.
+ * If direct_access is true, variables are not copied into a temporary
+ * register, but their register is used directly.
+ */
+static unsigned int cb_compiler_compile_operand(CbCompiler* self,
+                                                const CbAstNode* node,
+                                                bool direct_access);
+
+/*
+ * Compile a statement, whose value is not used (see cb_ast_node_exec()).
+ * An assignment leaves its value in the register of the variable only.
+ */
+static void cb_compiler_compile_statement(CbCompiler* self,
+                                          const CbAstNode* node,
+                                          unsigned int dest);
+
+
+/* -------------------------------------------------------------------------- */
+
+CbBytecode* cb_compiler_compile(const CbAstNode* ast)
+{
+    CbCompiler compiler;
+    unsigned int result;
+    
+    compiler.code           = cb_bytecode_create();
+    compiler.variable_count = 0;
+    
+    cb_compiler_count_variables(&compiler, ast);
+    
+    compiler.next_register  = compiler.variable_count;
+    compiler.register_count = compiler.variable_count;
+    
+    result = cb_compiler_allocate_register(&compiler);
+    cb_compiler_compile_node(&compiler, ast, result);
+    cb_bytecode_emit(compiler.code, CB_OPCODE_RETURN, 0, result, 0, 0,
+                     cb_ast_node_get_line(ast));
+    
+    cb_bytecode_set_register_count(compiler.code, compiler.register_count);
+    
+    return compiler.code;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void cb_compiler_count_variables(CbCompiler* self,
+                                        const CbAstNode* node)
+{
+    size_t slot;
+    size_t i;
+    const CbAstVariableNode* variable;
+    const CbAstStatementListNode* list;
+    
+    if (node == NULL)
+        return;
+    
+    if (cb_ast_node_get_type(node) == CB_AST_TYPE_VARIABLE)
+    {
+        variable = (const CbAstVariableNode*) node;
+        slot     = cb_ast_variable_node_get_slot(variable);
+        /* there is only a global scope at the moment */
+        cb_assert(cb_ast_variable_node_get_scope_depth(variable) == 0);
+
+        if (slot >= self->variable_count)
+            self->variable_count = slot + 1;
+    }
+    else if (cb_ast_node_get_type(node) == CB_AST_TYPE_STATEMENT_LIST)
+    {
+        list = (const CbAstStatementListNode*) node;
+        for (i = 0; i < cb_ast_statement_list_node_get_count(list); i++)
+            cb_compiler_count_variables(
+                self, cb_ast_statement_list_node_get(list, i)
+            );
+    }
+    else if (cb_ast_node_get_type(node) == CB_AST_TYPE_CONTROL_FLOW)
+        cb_compiler_count_variables(
+            self,
+            cb_ast_control_flow_node_get_condition(
+                (const CbAstControlFlowNode*) node
+            )
+        );
+    
+    cb_compiler_count_variables(self, cb_ast_node_get_left(node));
+    cb_compiler_count_variables(self, cb_ast_node_get_right(node));
+}
+
+static unsigned int cb_compiler_get_variable_register(const CbCompiler* self,
+                                                      const CbAstNode* node)
+{
+    cb_assert(cb_ast_node_get_type(node) == CB_AST_TYPE_VARIABLE);
+    /* the semantic check resolves the location of every variable */
+    return cb_ast_variable_node_get_slot((const CbAstVariableNode*) node);
+}
+
+static unsigned int cb_compiler_allocate_register(CbCompiler* self)
+{
+    unsigned int result = self->next_register++;
+    
+    if (self->next_register > self->register_count)
+        self->register_count = self->next_register;
+    
+    if (self->register_count > CB_BYTECODE_MAX_REGISTERS)
+        cb_abort("Codeblock requires too many registers");
+    
+    return result;
+}
+
+static void cb_compiler_compile_node(CbCompiler* self,
+                                     const CbAstNode* node,
+                                     unsigned int dest)
+{
+    unsigned int left;
+    unsigned int right;
+    unsigned int reg;
+    size_t jump_false;
+    size_t jump_end;
+    size_t jump_short = 0;
+    bool short_circuit;
+    size_t loop_start;
+    size_t i;
+    const CbAstControlFlowNode* flow;
+    const CbAstStatementListNode* list;
+    size_t mark = self->next_register;
+    int line    = cb_ast_node_get_line(node);
+    
+    switch (cb_ast_node_get_type(node))
+    {
+        case CB_AST_TYPE_VALUE:
+            cb_bytecode_emit(
+                self->code, CB_OPCODE_LOAD_CONSTANT, 0, dest,
+                cb_bytecode_add_constant(
+                    self->code,
+                    cb_ast_value_node_get_value((const CbAstValueNode*) node)
+                ),
+                0, line
+            );
+            break;
+        
+        case CB_AST_TYPE_VARIABLE:
+            reg = cb_compiler_get_variable_register(self, node);
+            if (reg != dest)
+                cb_bytecode_emit(self->code, CB_OPCODE_MOVE, 0, dest, reg, 0,
+                                 line);
+            break;
+        
+        case CB_AST_TYPE_BINARY:
+            /*
+             * The left operand must be copied, if the right operand might
+             * change its value.
+             */
+            left  = cb_compiler_compile_operand(
+                self, cb_ast_node_get_left(node),
+                !cb_ast_node_has_assignment(cb_ast_node_get_right(node))
+            );
+            right = cb_compiler_compile_operand(
+                self, cb_ast_node_get_right(node), true
+            );
+            cb_bytecode_emit(
+                self->code, CB_OPCODE_BINARY,
+                cb_ast_binary_node_get_operator_type((const CbAstBinaryNode*) node),
+                dest, left, right, line
+            );
+            break;
+        
+        case CB_AST_TYPE_LOGICAL:
+            left = cb_compiler_compile_operand(
+                self, cb_ast_node_get_left(node),
+                !cb_ast_node_has_assignment(cb_ast_node_get_right(node))
+            );
+            
+            /* skip the right operand, if the left one decides the result */
+            short_circuit = !cb_ast_logical_node_is_branch_free(
+                (const CbAstLogicalNode*) node
+            );
+            if (short_circuit)
+                jump_short = cb_bytecode_emit(
+                    self->code, CB_OPCODE_JUMP_IF_BOOLEAN, 0, left, 0,
+                    cb_ast_logical_node_get_operator_type(
+                        (const CbAstLogicalNode*) node
+                    ) == CB_BINARY_OPERATOR_TYPE_LOGICAL_OR,
+                    line
+                );
+            
+            right = cb_compiler_compile_operand(
+                self, cb_ast_node_get_right(node), true
+            );
+            cb_bytecode_emit(
+                self->code, CB_OPCODE_BINARY,
+                cb_ast_logical_node_get_operator_type(
+                    (const CbAstLogicalNode*) node
+                ),
+                dest, left, right, line
+            );
+            
+            if (short_circuit)
+            {
+                jump_end = cb_bytecode_emit(self->code, CB_OPCODE_JUMP, 0, 0,
+                                            0, 0, line);
+                cb_bytecode_patch_jump(self->code, jump_short,
+                                       cb_bytecode_get_count(self->code));
+                /* the result is the value of the left operand */
+                cb_bytecode_emit(self->code, CB_OPCODE_MOVE, 0, dest, left,
+                                 0, line);
+                cb_bytecode_patch_jump(self->code, jump_end,
+                                       cb_bytecode_get_count(self->code));
+            }
+            break;
+        
+        case CB_AST_TYPE_UNARY:
+            reg = cb_compiler_compile_operand(self, cb_ast_node_get_left(node),
+                                              true);
+            cb_bytecode_emit(
+                self->code, CB_OPCODE_UNARY,
+                cb_ast_unary_node_get_operator_type((const CbAstUnaryNode*) node),
+                dest, reg, 0, line
+            );
+            break;
+        
+        case CB_AST_TYPE_ASSIGNMENT:
+            /*
+             * NOTE: Every expression writes its destination register with its
+             *       very last instruction, so the value of the expression can
+             *       be stored directly in the register of the variable.
+             */
+            reg = cb_compiler_get_variable_register(self,
+                                                    cb_ast_node_get_left(node));
+            cb_compiler_compile_node(self, cb_ast_node_get_right(node), reg);
+            if (reg != dest)
+                cb_bytecode_emit(self->code, CB_OPCODE_MOVE, 0, dest, reg, 0,
+                                 line);
+            break;
+        
+        case CB_AST_TYPE_DECLARATION:
+        case CB_AST_TYPE_DECLARATION_BLOCK:
+            /* variables are already declared -> yields an undefined value */
+            cb_bytecode_emit(self->code, CB_OPCODE_LOAD_UNDEFINED, 0, dest, 0,
+                             0, line);
+            break;
+        
+        case CB_AST_TYPE_STATEMENT_LIST:
+            /* only the value of the last statement is kept */
+            list = (const CbAstStatementListNode*) node;
+            for (i = 0; i < cb_ast_statement_list_node_get_count(list); i++)
+            {
+                if (i + 1 < cb_ast_statement_list_node_get_count(list))
+                    cb_compiler_compile_statement(
+                        self, cb_ast_statement_list_node_get(list, i), dest
+                    );
+                else
+                    cb_compiler_compile_node(
+                        self, cb_ast_statement_list_node_get(list, i), dest
+                    );
+            }
+            break;
+        
+        case CB_AST_TYPE_CONTROL_FLOW:
+            flow = (const CbAstControlFlowNode*) node;
+            switch (cb_ast_control_flow_node_get_flow_type(flow))
+            {
+                case CB_AST_CONTROL_FLOW_TYPE_IF:
+                    reg = cb_compiler_compile_operand(
+                        self, cb_ast_control_flow_node_get_condition(flow), true
+                    );
+                    jump_false = cb_bytecode_emit(self->code,
+                                                  CB_OPCODE_JUMP_IF_FALSE, 0,
+                                                  reg, 0, 0, line);
+                    
+                    if (cb_ast_node_get_left(node) != NULL)
+                        cb_compiler_compile_node(self, cb_ast_node_get_left(node),
+                                                 dest);
+                    else
+                        cb_bytecode_emit(self->code, CB_OPCODE_LOAD_UNDEFINED,
+                                         0, dest, 0, 0, line);
+                    
+                    jump_end = cb_bytecode_emit(self->code, CB_OPCODE_JUMP, 0,
+                                                0, 0, 0, line);
+                    cb_bytecode_patch_jump(self->code, jump_false,
+                                           cb_bytecode_get_count(self->code));
+                    
+                    if (cb_ast_node_get_right(node) != NULL)
+                        cb_compiler_compile_node(self, cb_ast_node_get_right(node),
+                                                 dest);
+                    else
+                        cb_bytecode_emit(self->code, CB_OPCODE_LOAD_UNDEFINED,
+                                         0, dest, 0, 0, line);
+                    
+                    cb_bytecode_patch_jump(self->code, jump_end,
+                                           cb_bytecode_get_count(self->code));
+                    break;
+                
+                case CB_AST_CONTROL_FLOW_TYPE_WHILE:
+                    loop_start = cb_bytecode_get_count(self->code);
+                    reg        = cb_compiler_compile_operand(
+                        self, cb_ast_control_flow_node_get_condition(flow), true
+                    );
+                    jump_false = cb_bytecode_emit(self->code,
+                                                  CB_OPCODE_JUMP_IF_FALSE, 0,
+                                                  reg, 0, 0, line);
+                    cb_compiler_compile_statement(
+                        self, cb_ast_node_get_left(node), dest
+                    );
+                    cb_bytecode_emit(self->code, CB_OPCODE_JUMP, 0, 0,
+                                     loop_start, 0, line);
+                    cb_bytecode_patch_jump(self->code, jump_false,
+                                           cb_bytecode_get_count(self->code));
+                    /* a while-statement always yields an undefined value */
+                    cb_bytecode_emit(self->code, CB_OPCODE_LOAD_UNDEFINED, 0,
+                                     dest, 0, 0, line);
+                    break;
+                
+                default: cb_abort("Invalid control flow type"); break;
+            }
+            break;
+        
+        /* invalid AST node types */
+        case CB_AST_TYPE_NONE:
+        default: cb_abort("Invalid AST node type"); break;
+    }
+    
+    /* release all temporary registers used by this node */
+    self->next_register = mark;
+}
+
+static unsigned int cb_compiler_compile_operand(CbCompiler* self,
+                                                const CbAstNode* node,
+                                                bool direct_access)
+{
+    unsigned int result;
+    
+    if (direct_access && cb_ast_node_get_type(node) == CB_AST_TYPE_VARIABLE)
+        result = cb_compiler_get_variable_register(self, node);
+    else
+    {
+        result = cb_compiler_allocate_register(self);
+        cb_compiler_compile_node(self, node, result);
+    }
+    
+    return result;
+}
+
+static void cb_compiler_compile_statement(CbCompiler* self,
+                                          const CbAstNode* node,
+                                          unsigned int dest)
+{
+    size_t i;
+    const CbAstStatementListNode* list;
+    
+    switch (cb_ast_node_get_type(node))
+    {
+        case CB_AST_TYPE_ASSIGNMENT:
+            /* the value is not copied into dest */
+            cb_compiler_compile_node(
+                self, node,
+                cb_compiler_get_variable_register(self,
+                                                  cb_ast_node_get_left(node))
+            );
+            break;
+        
+        case CB_AST_TYPE_STATEMENT_LIST:
+            list = (const CbAstStatementListNode*) node;
+            for (i = 0; i < cb_ast_statement_list_node_get_count(list); i++)
+                cb_compiler_compile_statement(
+                    self, cb_ast_statement_list_node_get(list, i), dest
+                );
+            break;
+        
+        default: cb_compiler_compile_node(self, node, dest); break;
+    }
+}
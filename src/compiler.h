@@ -0,0 +1,27 @@
+/*******************************************************************************
+ * @file  compiler.h
+ * @brief Bytecode compiler
+ * 
+ * Lowers a semantically checked AST into bytecode for the register based
+ * virtual machine (see vm.h).
+ ******************************************************************************/
+
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include "ast.h"
+#include "bytecode.h"
+
+
+/**
+ * @brief Compile an AST into bytecode
+ * 
+ * @param ast The AST to compile
+ *            (NOTE: The AST must have passed the semantic check)
+ * 
+ * @return Returns the compiled bytecode, which must be destroyed by the caller.
+ */
+CbBytecode* cb_compiler_compile(const CbAstNode* ast);
+
+
+#endif /* COMPILER_H */
@@ -17,9 +17,14 @@ struct CbError
     char* message;
 };
 
-static FILE* err_out        = NULL; /* default error output stream */
-static CbError* err_object  = NULL;
-static bool err_initialized = false;
+/*
+ * NOTE: The error state is thread local, so that codeblocks can be parsed and
+ *       executed in several threads at the same time. Therefore error handling
+ *       needs to be initialized in each thread separately.
+ */
+static CB_THREAD_LOCAL FILE* err_out        = NULL; /* error output stream */
+static CB_THREAD_LOCAL CbError* err_object  = NULL;
+static CB_THREAD_LOCAL bool err_initialized = false;
 
 
 /*
@@ -71,6 +76,11 @@ void cb_error_set_output(FILE* error_output)
     err_out = error_output;
 }
 
+FILE* cb_error_get_output()
+{
+    return err_out;
+}
+
 void cb_error_initialize(FILE* error_output)
 {
     /* make sure error handling is not initialized yet */
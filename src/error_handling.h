@@ -33,8 +33,15 @@ void cb_error_print_msg(const char* message, ...);
  */
 void cb_error_set_output(FILE* error_output);
 
+/*
+ * Get error output stream
+ */
+FILE* cb_error_get_output();
+
 /*
  * Initialize error handling
+ * NOTE: The error state is thread local -> Each thread that parses or executes
+ *       codeblocks needs to initialize error handling.
  */
 void cb_error_initialize(FILE* error_output);
 
@@ -1,46 +1,98 @@
-#include <stdlib.h>
 #include <string.h>
 
 #include "utils.h"
+#include "intern.h"
 #include "hash_table.h"
 
 
 /* -------------------------------------------------------------------------- */
 
-typedef struct CbHashNode CbHashNode;
-struct CbHashNode
+typedef struct CbHashSlot
 {
-    char* key;
+    char* key;       /* NULL, if the slot is empty */
     void* data;
-    CbHashNode* next;
-};
+    CbHashSize hash; /* full hash of the key       */
+} CbHashSlot;
 
 struct CbHashTable
 {
-    CbHashSize size;
-    CbHashNode** nodes;
+    CbHashSize capacity; /* number of slots (always a power of two) */
+    CbHashSize count;    /* number of occupied slots                */
+    CbHashSlot* slots;
     CbHashFunc hash_func;
+    bool interned_keys;  /* keys are interned identifiers (not copied)    */
     bool destroy_items;
     CbHashItemDestructor item_destructor;
 };
 
-static CbHashSize cb_hash_table_default_hash_function(const char* key);
+static const CbHashSize CB_HASH_TABLE_MIN_CAPACITY = 8;
+
+/*
+ * Maximum load factor (numerator/denominator) before the table grows
+ */
+static const CbHashSize CB_HASH_TABLE_LOAD_NUMERATOR   = 3;
+static const CbHashSize CB_HASH_TABLE_LOAD_DENOMINATOR = 4;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Get the smallest power of two, that is greater than or equal to size and
+ * can hold count items without exceeding the maximum load factor.
+ */
+static CbHashSize cb_hash_table_get_capacity(CbHashSize size, CbHashSize count);
+
+/*
+ * Get the distance of the item in the slot at index from its home slot.
+ */
+static CbHashSize cb_hash_table_get_distance(const CbHashTable* self,
+                                             CbHashSize index);
+
+/*
+ * Find the slot index of the given key with the given hash. Returns false, if
+ * there is no slot with the given key.
+ */
+static bool cb_hash_table_find(const CbHashTable* self,
+                               const char* key,
+                               CbHashSize hash,
+                               CbHashSize* index);
+
+/*
+ * Place an item in the table (robin hood hashing): Items, that are closer to
+ * their home slot, make room for items, that are farther away from theirs.
+ * NOTE: The key must not yet be in the table and there must be an empty slot.
+ */
+static void cb_hash_table_place(CbHashTable* self, CbHashSlot item);
 
 
 /* -------------------------------------------------------------------------- */
 
+CbHashTable* cb_hash_table_create_interned(CbHashSize size,
+                                           CbHashItemDestructor item_destructor)
+{
+    CbHashTable* self   = cb_hash_table_create(size, cb_intern_hash,
+                                               item_destructor);
+    self->interned_keys = true;
+    
+    return self;
+}
+
 CbHashTable* cb_hash_table_create(CbHashSize size,
                                   CbHashFunc hash_func,
                                   CbHashItemDestructor item_destructor)
 {
     CbHashTable* self = memalloc(sizeof(CbHashTable));
-    self->nodes       = calloc(size, sizeof(CbHashNode*));
-    self->size        = size;
+    self->capacity    = cb_hash_table_get_capacity(size, 0);
+    self->count       = 0;
+    self->slots       = memalloc(self->capacity * sizeof(CbHashSlot));
+    memclr(self->slots, self->capacity * sizeof(CbHashSlot));
     
     if (hash_func)
         self->hash_func = hash_func;
     else
-        self->hash_func = cb_hash_table_default_hash_function;
+        self->hash_func = cb_hash_table_hash_string;
+    
+    self->interned_keys = false;
     
     if (item_destructor)
     {
@@ -58,137 +110,225 @@ CbHashTable* cb_hash_table_create(CbHashSize size,
 
 void cb_hash_table_destroy(CbHashTable* self)
 {
-    CbHashNode* node;
-    CbHashNode* old_node;
-    CbHashSize n = 0;
+    CbHashSize n;
+    CbHashSlot* slot;
     
-    for (; n < self->size; n++)
+    for (n = 0; n < self->capacity; n++)
     {
-        node = self->nodes[n];
-        while (node)
-        {
-            memfree(node->key);
-            old_node = node;
-            node     = node->next;
-            
-            if (self->destroy_items && old_node->data)
-                self->item_destructor(old_node->data);
-            
-            memfree(old_node);
-        }
+        slot = &self->slots[n];
+        if (slot->key == NULL)
+            continue;
+        
+        if (!self->interned_keys)
+            memfree(slot->key);
+        if (self->destroy_items && slot->data)
+            self->item_destructor(slot->data);
     }
     
-    memfree(self->nodes);
+    memfree(self->slots);
     memfree(self);
 }
 
 void cb_hash_table_insert(CbHashTable* self, const char* key, void* data)
 {
-    CbHashNode* node;
-    CbHashSize hash = self->hash_func(key) % self->size;
+    CbHashSize index;
+    CbHashSlot item;
+    CbHashSlot* slot;
+    CbHashSize hash = self->hash_func(key);
     
-    node = self->nodes[hash];
-    while (node)
+    /* replace the data of an existing key */
+    if (cb_hash_table_find(self, key, hash, &index))
     {
-        if (!strcmp(node->key, key))
-            node->data = data;
+        slot = &self->slots[index];
+        if (self->destroy_items && slot->data && slot->data != data)
+            self->item_destructor(slot->data);
         
-        node = node->next;
+        slot->data = data;
+        return;
     }
     
-    node       = (CbHashNode*) malloc(sizeof(CbHashNode));
-    node->key  = strdup(key);
-    node->data = data;
-    node->next = self->nodes[hash];
+    if ((self->count + 1) * CB_HASH_TABLE_LOAD_DENOMINATOR >
+        self->capacity * CB_HASH_TABLE_LOAD_NUMERATOR)
+        cb_hash_table_resize(self, self->capacity * 2);
     
-    self->nodes[hash] = node;
+    item.key  = self->interned_keys ? (char*) key : strdup(key);
+    item.data = data;
+    item.hash = hash;
+    
+    cb_hash_table_place(self, item);
+    self->count++;
 }
 
 bool cb_hash_table_remove(CbHashTable* self, const char* key)
 {
-    CbHashNode* node;
-    CbHashNode* prev = NULL;
-    CbHashSize hash  = self->hash_func(key) % self->size;
+    CbHashSize mask = self->capacity - 1;
+    CbHashSize index;
+    CbHashSize next;
+    CbHashSlot* slot;
+    
+    if (!cb_hash_table_find(self, key, self->hash_func(key), &index))
+        return false;
+    
+    slot = &self->slots[index];
+    if (!self->interned_keys)
+        memfree(slot->key);
+    if (self->destroy_items && slot->data)
+        self->item_destructor(slot->data);
     
-    node = self->nodes[hash];
-    while (node)
+    /* shift the following items of the cluster back (no tombstones needed) */
+    next = (index + 1) & mask;
+    while (self->slots[next].key != NULL &&
+           cb_hash_table_get_distance(self, next) > 0)
     {
-        if (!strcmp(node->key, key))
-        {
-            memfree(node->key);
-            if(prev)
-                prev->next = node->next;
-            else
-                self->nodes[hash]=node->next;
-            
-            if (self->destroy_items && node->data)
-                self->item_destructor(node->data);
-            
-            memfree(node);
-            return true;
-        }
-        
-        prev = node;
-        node = node->next;
+        self->slots[index] = self->slots[next];
+        index              = next;
+        next               = (next + 1) & mask;
     }
     
-    return false;
+    self->slots[index].key  = NULL;
+    self->slots[index].data = NULL;
+    self->count--;
+    
+    return true;
 }
 
 void* cb_hash_table_get(const CbHashTable* self, const char* key)
 {
-    CbHashSize hash  = self->hash_func(key) % self->size;
-    CbHashNode* node = self->nodes[hash];
+    return cb_hash_table_get_hashed(self, key, self->hash_func(key));
+}
+
+void* cb_hash_table_get_hashed(const CbHashTable* self,
+                               const char* key,
+                               CbHashSize hash)
+{
+    CbHashSize index;
     
-    while (node)
-    {
-        if (!strcmp(node->key, key))
-            return node->data;
-        
-        node = node->next;
-    }
+    if (cb_hash_table_find(self, key, hash, &index))
+        return self->slots[index].data;
     
     return NULL;
 }
 
 void cb_hash_table_resize(CbHashTable* self, CbHashSize size)
 {
-    CbHashTable newtbl;
+    CbHashSlot* slots       = self->slots;
+    CbHashSize capacity     = self->capacity;
+    CbHashSize new_capacity = cb_hash_table_get_capacity(size, self->count);
     CbHashSize n;
-    CbHashNode* node;
-    CbHashNode* next;
     
-    newtbl.size      = size;
-    newtbl.hash_func = self->hash_func;
-    newtbl.nodes     = calloc(size, sizeof(CbHashNode*));
+    if (new_capacity == capacity)
+        return;
+    
+    self->capacity = new_capacity;
+    self->slots    = memalloc(new_capacity * sizeof(CbHashSlot));
+    memclr(self->slots, new_capacity * sizeof(CbHashSlot));
     
-    for (n = 0; n < self->size; n++)
+    /* keys are moved, not copied */
+    for (n = 0; n < capacity; n++)
     {
-        for (node = self->nodes[n]; node; node = next)
-        {
-            next = node->next;
-            cb_hash_table_insert(&newtbl, node->key, node->data);
-            cb_hash_table_remove(self, node->key);
-        }
+        if (slots[n].key != NULL)
+            cb_hash_table_place(self, slots[n]);
     }
     
-    memfree(self->nodes);
-    self->size  = newtbl.size;
-    self->nodes = newtbl.nodes;
+    memfree(slots);
 }
 
+CbHashSize cb_hash_table_get_count(const CbHashTable* self)
+{
+    return self->count;
+}
 
-/* -------------------------------------------------------------------------- */
-
-static CbHashSize cb_hash_table_default_hash_function(const char* key)
+CbHashSize cb_hash_table_hash_string(const char* key)
 {
-    CbHashSize hash = 0;
+    /* 64 bit FNV-1a (truncated on platforms with a 32 bit size_t) */
+    unsigned long long hash = 14695981039346656037ULL;
     
     while (*key)
     {
-        hash += (unsigned char) *key;
+        hash ^= (unsigned char) *key;
+        hash *= 1099511628211ULL;
         key++;
     }
     
-    return hash;
+    return (CbHashSize) hash;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static CbHashSize cb_hash_table_get_capacity(CbHashSize size, CbHashSize count)
+{
+    CbHashSize capacity = CB_HASH_TABLE_MIN_CAPACITY;
+    
+    while (capacity < size ||
+           count * CB_HASH_TABLE_LOAD_DENOMINATOR >
+           capacity * CB_HASH_TABLE_LOAD_NUMERATOR)
+        capacity *= 2;
+    
+    return capacity;
+}
+
+static CbHashSize cb_hash_table_get_distance(const CbHashTable* self,
+                                             CbHashSize index)
+{
+    CbHashSize mask = self->capacity - 1;
+    return (index - (self->slots[index].hash & mask)) & mask;
+}
+
+static bool cb_hash_table_find(const CbHashTable* self,
+                               const char* key,
+                               CbHashSize hash,
+                               CbHashSize* index)
+{
+    CbHashSize mask     = self->capacity - 1;
+    CbHashSize i        = hash & mask;
+    CbHashSize distance = 0;
+    
+    /*
+     * An item can not be farther away from its home slot than the item in the
+     * current slot, otherwise it would have taken this slot.
+     */
+    while (self->slots[i].key != NULL &&
+           cb_hash_table_get_distance(self, i) >= distance)
+    {
+        /* interned keys are equal, if they are the same pointer */
+        if (self->slots[i].hash == hash &&
+            (self->slots[i].key == key ||
+             (!self->interned_keys && strequ(self->slots[i].key, key))))
+        {
+            *index = i;
+            return true;
+        }
+        
+        i = (i + 1) & mask;
+        distance++;
+    }
+    
+    return false;
+}
+
+static void cb_hash_table_place(CbHashTable* self, CbHashSlot item)
+{
+    CbHashSize current;
+    CbHashSlot temp;
+    CbHashSize mask     = self->capacity - 1;
+    CbHashSize i        = item.hash & mask;
+    CbHashSize distance = 0;
+    
+    while (self->slots[i].key != NULL)
+    {
+        current = cb_hash_table_get_distance(self, i);
+        if (current < distance)
+        {
+            temp            = self->slots[i];
+            self->slots[i]  = item;
+            item            = temp;
+            distance        = current;
+        }
+        
+        i = (i + 1) & mask;
+        distance++;
+    }
+    
+    self->slots[i] = item;
 }
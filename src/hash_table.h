@@ -4,11 +4,11 @@
  * 
  * Implementation of a generic hash table data structure.
  * 
- * IMPORTANT NOTE: All source code (concerning hash_table.h and hash_table.c)
- *                 is retrieved from:
- *                    http://en.literateprograms.org/Hash_table_(C)?oldid=19638
- *                 The source code was slightly modified to fit the projects
- *                 source code style.
+ * The table uses open addressing with robin hood hashing: All items are stored
+ * in a single array of slots, whose size is a power of two. The table grows
+ * automatically, if more than 3/4 of the slots are occupied. By default keys
+ * are hashed with the FNV-1a hash function.
+ * Tables with interned keys compare their keys by pointer.
  ******************************************************************************/
 
 #ifndef HASH_TABLE_H
@@ -34,7 +34,8 @@ typedef void (*CbHashItemDestructor)(void*);
  * @memberof CbHashTable
  * @brief    Constructor
  * 
- * @param size      The initial size of the hash table
+ * @param size            The initial size of the hash table (rounded up to a
+ *                        power of two)
  * @param hash_func       Pointer to a function, that transforms a char array
  *                        into a hash. If NULL is passed, the default hash
  *                        function will be used.
@@ -45,6 +46,21 @@ CbHashTable* cb_hash_table_create(CbHashSize size,
                                   CbHashFunc hash_func,
                                   CbHashItemDestructor item_destructor);
 
+/**
+ * @memberof CbHashTable
+ * @brief    Constructor for a hash table with interned keys
+ * 
+ * All keys must be interned identifiers (see intern.h): They are not copied
+ * and compared by pointer. Their hash is taken from the intern pool.
+ * 
+ * @param size            The initial size of the hash table (rounded up to a
+ *                        power of two)
+ * @param item_destructor Pointer to a function, is will be used as a destructor
+ *                        for items being removed from the hash table
+ */
+CbHashTable* cb_hash_table_create_interned(CbHashSize size,
+                                           CbHashItemDestructor item_destructor);
+
 /**
  * @memberof CbHashTable
  * @brief    Destructor
@@ -57,6 +73,9 @@ void cb_hash_table_destroy(CbHashTable* self);
  * @memberof CbHashTable
  * @brief    Insert an item into the hash table
  * 
+ * If the key already exists, its data is replaced (and destroyed, if the
+ * hash table has an item destructor).
+ * 
  * @param self The hash table instance
  * @param key  The key, the value/data will be mapped to
  * @param data The value/data
@@ -82,14 +101,48 @@ bool cb_hash_table_remove(CbHashTable* self, const char* key);
  */
 void* cb_hash_table_get(const CbHashTable* self, const char* key);
 
+/**
+ * @memberof CbHashTable
+ * @brief    Get an item from the hash table by a precomputed hash
+ * 
+ * Avoids hashing the key again, if it is looked up in several tables.
+ * 
+ * @param self The hash table instance
+ * @param key  The key, the value/data is mapped to
+ * @param hash The hash of the key (i.e. the result of the hash function of the
+ *             table)
+ * @return Returns NULL if there is no item, that is mapped to the given key
+ */
+void* cb_hash_table_get_hashed(const CbHashTable* self,
+                               const char* key,
+                               CbHashSize hash);
+
 /**
  * @memberof CbHashTable
  * @brief    Resize the hash table
  * 
+ * The size is rounded up to a power of two, that is large enough for all
+ * items in the hash table.
+ * 
  * @param self The hash table instance
  * @param size The new hash size
  */
 void cb_hash_table_resize(CbHashTable* self, CbHashSize size);
 
+/**
+ * @memberof CbHashTable
+ * @brief    Get the number of items in the hash table
+ * 
+ * @param self The hash table instance
+ */
+CbHashSize cb_hash_table_get_count(const CbHashTable* self);
+
+/**
+ * @brief Default hash function (FNV-1a)
+ * 
+ * @param key The key to hash
+ */
+CbHashSize cb_hash_table_hash_string(const char* key);
+
 
 #endif /* HASH_TABLE_H */
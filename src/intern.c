@@ -0,0 +1,175 @@
+#include <pthread.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "utils.h"
+#include "arena.h"
+#include "intern.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+typedef struct CbInternEntry
+{
+    CbHashSize hash;
+    char string[]; /* the interned identifier */
+} CbInternEntry;
+
+typedef struct CbInternPool
+{
+    pthread_mutex_t lock;
+    CbArena* arena;         /* owns all entries                       */
+    CbInternEntry** slots;  /* open addressing (linear probing)       */
+    CbHashSize capacity;    /* number of slots (always a power of two) */
+    CbHashSize count;
+} CbInternPool;
+
+static const CbHashSize CB_INTERN_POOL_INITIAL_CAPACITY = 256;
+
+/*
+ * The process wide pool (created on first use)
+ */
+static CbInternPool cb_intern_pool = {
+    PTHREAD_MUTEX_INITIALIZER, NULL, NULL, 0, 0
+};
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Find the slot of the given string (either its entry or an empty slot).
+ * NOTE: The pool must be locked.
+ */
+static CbInternEntry** cb_intern_pool_find(const char* string,
+                                           CbHashSize hash);
+
+/*
+ * Double the number of slots of the pool.
+ * NOTE: The pool must be locked.
+ */
+static void cb_intern_pool_grow();
+
+
+/* -------------------------------------------------------------------------- */
+
+const char* cb_intern(const char* string)
+{
+    size_t length;
+    CbInternEntry** slot;
+    CbInternEntry* entry;
+    CbHashSize hash = cb_hash_table_hash_string(string);
+    
+    pthread_mutex_lock(&cb_intern_pool.lock);
+    
+    if (cb_intern_pool.slots == NULL)
+    {
+        cb_intern_pool.arena    = cb_arena_create();
+        cb_intern_pool.capacity = CB_INTERN_POOL_INITIAL_CAPACITY;
+        cb_intern_pool.slots    = memalloc(cb_intern_pool.capacity *
+                                           sizeof(CbInternEntry*));
+        memclr(cb_intern_pool.slots,
+               cb_intern_pool.capacity * sizeof(CbInternEntry*));
+    }
+    
+    slot = cb_intern_pool_find(string, hash);
+    if (*slot == NULL)
+    {
+        length      = strlen(string) + 1;
+        entry       = cb_arena_alloc(cb_intern_pool.arena,
+                                     offsetof(CbInternEntry, string) + length);
+        entry->hash = hash;
+        memcpy(entry->string, string, length);
+        
+        *slot = entry;
+        cb_intern_pool.count++;
+        
+        /* keep the load factor below 1/2 */
+        if (cb_intern_pool.count * 2 > cb_intern_pool.capacity)
+            cb_intern_pool_grow();
+    }
+    else
+        entry = *slot;
+    
+    pthread_mutex_unlock(&cb_intern_pool.lock);
+    
+    return entry->string;
+}
+
+const char* cb_intern_find(const char* string)
+{
+    const CbInternEntry* entry;
+    CbHashSize hash    = cb_hash_table_hash_string(string);
+    const char* result = NULL;
+    
+    pthread_mutex_lock(&cb_intern_pool.lock);
+    
+    if (cb_intern_pool.slots != NULL)
+    {
+        entry = *cb_intern_pool_find(string, hash);
+        if (entry != NULL)
+            result = entry->string;
+    }
+    
+    pthread_mutex_unlock(&cb_intern_pool.lock);
+    
+    return result;
+}
+
+CbHashSize cb_intern_hash(const char* identifier)
+{
+    const CbInternEntry* entry = (const CbInternEntry*)
+        (identifier - offsetof(CbInternEntry, string));
+    return entry->hash;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static CbInternEntry** cb_intern_pool_find(const char* string,
+                                           CbHashSize hash)
+{
+    const CbInternEntry* entry;
+    CbHashSize mask = cb_intern_pool.capacity - 1;
+    CbHashSize i    = hash & mask;
+    
+    while (cb_intern_pool.slots[i] != NULL)
+    {
+        entry = cb_intern_pool.slots[i];
+        if (entry->hash == hash && strequ(entry->string, string))
+            break;
+        
+        i = (i + 1) & mask;
+    }
+    
+    return &cb_intern_pool.slots[i];
+}
+
+static void cb_intern_pool_grow()
+{
+    CbInternEntry** slots = cb_intern_pool.slots;
+    CbHashSize capacity   = cb_intern_pool.capacity;
+    CbHashSize mask;
+    CbHashSize n;
+    CbHashSize i;
+    
+    cb_intern_pool.capacity = capacity * 2;
+    cb_intern_pool.slots    = memalloc(cb_intern_pool.capacity *
+                                       sizeof(CbInternEntry*));
+    memclr(cb_intern_pool.slots,
+           cb_intern_pool.capacity * sizeof(CbInternEntry*));
+    mask = cb_intern_pool.capacity - 1;
+    
+    for (n = 0; n < capacity; n++)
+    {
+        if (slots[n] == NULL)
+            continue;
+        
+        i = slots[n]->hash & mask;
+        while (cb_intern_pool.slots[i] != NULL)
+            i = (i + 1) & mask;
+        
+        cb_intern_pool.slots[i] = slots[n];
+    }
+    
+    memfree(slots);
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * @file  intern.h
+ * @brief Contains the global identifier intern pool
+ * 
+ * Every distinct identifier is stored exactly once in a process wide pool.
+ * Interning a string returns a pointer to its unique copy, so two interned
+ * identifiers are equal, if (and only if) they are the same pointer. The
+ * hash of each identifier is computed once and stored along with it.
+ * 
+ * Interned identifiers are never released and stay valid until the program
+ * terminates. The pool is thread safe.
+ ******************************************************************************/
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include "cb_utils.h"
+#include "hash_table.h"
+
+
+/**
+ * @brief Intern a string
+ * 
+ * @param string The string to intern
+ * @return Returns the unique copy of the string in the pool
+ */
+const char* cb_intern(const char* string);
+
+/**
+ * @brief Find an already interned string
+ * 
+ * In contrast to cb_intern(), the string is not added to the pool.
+ * 
+ * @param string The string to look for
+ * @return Returns NULL if the string has not been interned yet
+ */
+const char* cb_intern_find(const char* string);
+
+/**
+ * @brief Get the hash of an interned identifier (without rehashing it)
+ * 
+ * The function can be used as a hash function for hash tables, whose keys are
+ * all interned.
+ * 
+ * @param identifier An identifier returned by cb_intern()
+ */
+CbHashSize cb_intern_hash(const char* identifier);
+
+/**
+ * @brief Assert that an identifier was returned by cb_intern()
+ * 
+ * Functions, that store identifiers, which were already interned (e.g. by the
+ * lexer), use it instead of interning them again. The check is only performed
+ * in debug builds, since it looks the identifier up in the pool.
+ * 
+ * @param identifier The identifier to check
+ */
+#ifdef DEBUG
+#define cb_intern_assert(identifier) \
+        cb_assert(cb_intern_find(identifier) == (identifier))
+#else
+#define cb_intern_assert(identifier) do { } while (0)
+#endif
+
+
+#endif /* INTERN_H */
@@ -2,6 +2,9 @@
  * cbc -- Codeblock compiler
  ******************************************************************************/
 
+#include <stdlib.h>
+
+#include "utils.h"
 #include "error_handling.h"
 #include "codeblock.h"
 
@@ -12,6 +15,8 @@ int main(int argc, char* argv[])
 {
     CbCodeblock* cb;
     bool parser_result;
+    const char* engine  = getenv("CBC_ENGINE");
+    const char* profile = getenv("CBC_PROFILE");
     FILE* input     = NULL;
     bool parse_file = argc > 1;
     
@@ -34,6 +39,20 @@ int main(int argc, char* argv[])
     cb_error_initialize(stderr);
     cb = cb_codeblock_create();
     
+    /*
+     * Select execution engine: Set CBC_ENGINE=vm to run the codeblock in the
+     * bytecode VM.
+     */
+    if (engine != NULL && strequ(engine, "vm"))
+        cb_codeblock_set_engine(cb, CB_CODEBLOCK_ENGINE_VM);
+    
+    /*
+     * Enable profiling: Set CBC_PROFILE=text (or csv) to print a hot spot
+     * report of the execution to stderr.
+     */
+    if (profile != NULL)
+        cb_codeblock_set_profiling(cb, true);
+    
     /*
      * Parse input stream:
      * Either stdin or a file specified on the command line.
@@ -49,6 +68,12 @@ int main(int argc, char* argv[])
         cb_variant_print(cb_codeblock_get_result(cb));
         printf("\n");
     }
+    if (cb_codeblock_get_profiler(cb) != NULL)
+        cb_ast_profiler_report(cb_codeblock_get_profiler(cb),
+                               strequ(profile, "csv") ?
+                               CB_AST_PROFILER_FORMAT_CSV :
+                               CB_AST_PROFILER_FORMAT_TEXT,
+                               stderr);
     
     /*
      * Cleanup environment.
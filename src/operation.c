@@ -0,0 +1,363 @@
+#include "utils.h"
+#include "cb_utils.h"
+#include "error_handling.h"
+#include "operation.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Evaluate binary operation (integer)
+ */
+static bool cb_binary_operation_eval_integer(CbBinaryOperatorType operator_type,
+                                             const CbVariant* left,
+                                             const CbVariant* right,
+                                             int line,
+                                             CbVariant* result);
+
+/*
+ * Evaluate binary operation (float)
+ */
+static bool cb_binary_operation_eval_float(CbBinaryOperatorType operator_type,
+                                           const CbVariant* left,
+                                           const CbVariant* right,
+                                           int line,
+                                           CbVariant* result);
+
+/*
+ * Evaluate binary operation (string)
+ */
+static bool cb_binary_operation_eval_string(CbBinaryOperatorType operator_type,
+                                            const CbVariant* left,
+                                            const CbVariant* right,
+                                            CbVariant* result);
+
+/*
+ * Evaluate binary operation (boolean)
+ */
+static bool cb_binary_operation_eval_boolean(CbBinaryOperatorType operator_type,
+                                             const CbVariant* left,
+                                             const CbVariant* right,
+                                             CbVariant* result);
+
+
+/* -------------------------------------------------------------------------- */
+
+bool cb_binary_operation_check(CbBinaryOperatorType operator_type,
+                               CbVariantType lhs,
+                               CbVariantType rhs,
+                               CbErrorType error_type,
+                               int line)
+{
+    bool result = cb_variant_type_is_binary_operation_valid(operator_type,
+                                                            lhs, rhs);
+    if (!result)
+    {
+        cb_error_trigger(
+            error_type, line,
+            "Invalid binary operation: <%s> %s <%s>",
+            cb_variant_type_stringify(lhs),
+            cb_binary_operator_type_stringify(operator_type),
+            cb_variant_type_stringify(rhs)
+        );
+    }
+    
+    return result;
+}
+
+bool cb_binary_operation_eval(CbBinaryOperatorType operator_type,
+                              const CbVariant* left,
+                              const CbVariant* right,
+                              int line,
+                              CbVariant* result)
+{
+    bool success = false;
+    
+    *result = cb_variant_make();
+    
+    if (cb_binary_operation_check(operator_type,
+                                  cb_variant_get_type(left),
+                                  cb_variant_get_type(right),
+                                  CB_ERROR_RUNTIME, line))
+    {
+        if (cb_variant_is_numeric(left))
+        {
+            if (cb_variant_is_float(left) || cb_variant_is_float(right))
+                success = cb_binary_operation_eval_float(operator_type,
+                                                         left, right, line,
+                                                         result);
+            else
+                success = cb_binary_operation_eval_integer(operator_type,
+                                                           left, right, line,
+                                                           result);
+        }
+        else if (cb_variant_is_string(left))
+            success = cb_binary_operation_eval_string(operator_type,
+                                                      left, right, result);
+        else if (cb_variant_is_boolean(left))
+            success = cb_binary_operation_eval_boolean(operator_type,
+                                                       left, right, result);
+        else
+            cb_abort("Invalid binary operation");
+    }
+    
+    return success;
+}
+
+bool cb_unary_operation_check(CbUnaryOperatorType operator_type,
+                              CbVariantType type,
+                              CbErrorType error_type,
+                              int line)
+{
+    bool result = cb_variant_type_is_unary_operation_valid(operator_type,
+                                                           type);
+    if (!result)
+    {
+        cb_error_trigger(
+            error_type, line,
+            "Invalid unary operation: %s <%s>",
+            cb_unary_operator_type_stringify(operator_type),
+            cb_variant_type_stringify(type)
+        );
+    }
+    
+    return result;
+}
+
+bool cb_unary_operation_eval(CbUnaryOperatorType operator_type,
+                             const CbVariant* value,
+                             int line,
+                             CbVariant* result)
+{
+    bool success = false;
+    
+    *result = cb_variant_make();
+    
+    if (cb_unary_operation_check(operator_type, cb_variant_get_type(value),
+                                 CB_ERROR_RUNTIME, line))
+    {
+        success = true;
+        switch (operator_type)
+        {
+            case CB_UNARY_OPERATOR_TYPE_MINUS:
+            {
+                if (cb_variant_is_integer(value))
+                    *result = cb_integer_make( - cb_integer_get_value(value));
+                else if (cb_variant_is_float(value))
+                    *result = cb_float_make( - cb_float_get_value(value));
+                else
+                    /* TODO: handle all compatible AST node types */
+                    cb_abort("Wrong variant type");
+                
+                break;
+            }
+            
+            case CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT:
+                cb_assert(cb_variant_is_boolean(value));
+                *result = cb_boolean_make(!cb_boolean_get_value(value));
+                break;
+            
+            /* invalid unary operator type */
+            default:
+                cb_abort("Invalid unary operator type"); break;
+        }
+    }
+    
+    return success;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static bool cb_binary_operation_eval_integer(CbBinaryOperatorType operator_type,
+                                             const CbVariant* left,
+                                             const CbVariant* right,
+                                             int line,
+                                             CbVariant* result)
+{
+    bool success         = true;
+    CbIntegerDataType v1 = cb_integer_get_value(left);
+    CbIntegerDataType v2 = cb_integer_get_value(right);
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_ADD:
+            *result = cb_integer_make(v1 + v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_SUB:
+            *result = cb_integer_make(v1 - v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_MUL:
+            *result = cb_integer_make(v1 * v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_DIV:
+            if (v2 == 0)
+            {
+                cb_error_trigger(CB_ERROR_RUNTIME, line,
+                                 "Division by zero is not allowed");
+                success = false;
+            }
+            else
+            {
+                if ((v1 % v2) == 0)
+                    /*
+                     * Division does not yield a real number.
+                     * -> Create an integer result.
+                     */
+                    *result = cb_integer_make(v1 / v2);
+                else
+                    /*
+                     * Division yields a real number -> Create a float result.
+                     */
+                    *result = cb_float_make((CbFloatDataType) v1 /
+                                            (CbFloatDataType) v2);
+            }
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GT:
+            *result = cb_boolean_make(v1 > v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GE:
+            *result = cb_boolean_make(v1 >= v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LT:
+            *result = cb_boolean_make(v1 < v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LE:
+            *result = cb_boolean_make(v1 <= v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+            *result = cb_boolean_make(v1 == v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+            *result = cb_boolean_make(v1 != v2); break;
+        
+        /* invalid binary operator type */
+        default: cb_abort("Invalid binary operator type"); break;
+    }
+    
+    return success;
+}
+
+static bool cb_binary_operation_eval_float(CbBinaryOperatorType operator_type,
+                                           const CbVariant* left,
+                                           const CbVariant* right,
+                                           int line,
+                                           CbVariant* result)
+{
+    CbFloatDataType v1;
+    CbFloatDataType v2;
+    bool success = true;
+    
+    v1 = cb_numeric_as_float(left);
+    v2 = cb_numeric_as_float(right);
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_ADD:
+            *result = cb_float_make(v1 + v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_SUB:
+            *result = cb_float_make(v1 - v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_MUL:
+            *result = cb_float_make(v1 * v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_DIV:
+            if (v2 == 0.0)
+            {
+                cb_error_trigger(CB_ERROR_RUNTIME, line,
+                                 "Division by zero is not allowed");
+                success = false;
+            }
+            else
+                *result = cb_float_make(v1 / v2);
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GT:
+            *result = cb_boolean_make(v1 > v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_GE:
+            *result = cb_boolean_make((v1 > v2) || dequal(v1, v2)); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LT:
+            *result = cb_boolean_make(v1 < v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_LE:
+            *result = cb_boolean_make((v1 < v2) || dequal(v1, v2)); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+            *result = cb_boolean_make(dequal(v1, v2)); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+            *result = cb_boolean_make(!dequal(v1, v2)); break;
+        
+        /* invalid binary operator type */
+        default: cb_abort("Invalid binary operator type"); break;
+    }
+    
+    return success;
+}
+
+static bool cb_binary_operation_eval_string(CbBinaryOperatorType operator_type,
+                                            const CbVariant* left,
+                                            const CbVariant* right,
+                                            CbVariant* result)
+{
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_ADD:
+            *result = cb_variant_clone(left);
+            cb_string_concat(result, right);
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+            *result = cb_boolean_make(cb_string_lhs_equal(left, right)); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+            *result = cb_boolean_make(cb_string_equal(left, right)); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+            *result = cb_boolean_make(!cb_string_equal(left, right)); break;
+        
+        /* invalid binary operator type */
+        default: cb_abort("Invalid binary operator type"); break;
+    }
+    
+    return true;
+}
+
+static bool cb_binary_operation_eval_boolean(CbBinaryOperatorType operator_type,
+                                             const CbVariant* left,
+                                             const CbVariant* right,
+                                             CbVariant* result)
+{
+    CbFloatDataType v1;
+    CbFloatDataType v2;
+    
+    v1 = cb_boolean_get_value(left);
+    v2 = cb_boolean_get_value(right);
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_LOGICAL_AND:
+            *result = cb_boolean_make(v1 && v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_LOGICAL_OR:
+            *result = cb_boolean_make(v1 || v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ:
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_SE:
+            *result = cb_boolean_make(v1 == v2); break;
+        
+        case CB_BINARY_OPERATOR_TYPE_COMPARISON_NE:
+            *result = cb_boolean_make(v1 != v2); break;
+        
+        /* invalid binary operator type */
+        default: cb_abort("Invalid binary operator type"); break;
+    }
+    
+    return true;
+}
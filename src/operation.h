@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * @file  operation.h
+ * @brief Evaluation of unary and binary operations on CbVariant values
+ * 
+ * The operations are shared by all execution engines (i.e. the AST evaluation
+ * and the virtual machine), so every engine yields exactly the same results.
+ ******************************************************************************/
+
+#ifndef OPERATION_H
+#define OPERATION_H
+
+#include <stdbool.h>
+
+#include "error_handling.h"
+#include "variant.h"
+
+
+/**
+ * @brief Check if a binary operation is valid. Raise an error if not.
+ * 
+ * @param operator_type The binary operator
+ * @param lhs           Variant type of the left hand side operand
+ * @param rhs           Variant type of the right hand side operand
+ * @param error_type    Type of the error to raise
+ * @param line          Line number to report in case of an error
+ */
+bool cb_binary_operation_check(CbBinaryOperatorType operator_type,
+                               CbVariantType lhs,
+                               CbVariantType rhs,
+                               CbErrorType error_type,
+                               int line);
+
+/**
+ * @brief Evaluate a binary operation.
+ * 
+ * @param operator_type The binary operator
+ * @param left          The left hand side operand
+ * @param right         The right hand side operand
+ * @param line          Line number to report in case of a runtime error
+ * @param result        Receives the result of the operation
+ *                      (undefined, if a runtime error occurred)
+ * 
+ * @return Returns false, if a runtime error occurred (e.g. division by zero).
+ */
+bool cb_binary_operation_eval(CbBinaryOperatorType operator_type,
+                              const CbVariant* left,
+                              const CbVariant* right,
+                              int line,
+                              CbVariant* result);
+
+/**
+ * @brief Check if a unary operation is valid. Raise an error if not.
+ * 
+ * @param operator_type The unary operator
+ * @param type          Variant type of the operand
+ * @param error_type    Type of the error to raise
+ * @param line          Line number to report in case of an error
+ */
+bool cb_unary_operation_check(CbUnaryOperatorType operator_type,
+                              CbVariantType type,
+                              CbErrorType error_type,
+                              int line);
+
+/**
+ * @brief Evaluate a unary operation.
+ * 
+ * @param operator_type The unary operator
+ * @param value         The operand
+ * @param line          Line number to report in case of a runtime error
+ * @param result        Receives the result of the operation
+ *                      (undefined, if a runtime error occurred)
+ * 
+ * @return Returns false, if a runtime error occurred.
+ */
+bool cb_unary_operation_eval(CbUnaryOperatorType operator_type,
+                             const CbVariant* value,
+                             int line,
+                             CbVariant* result);
+
+
+#endif /* OPERATION_H */
@@ -0,0 +1,770 @@
+#include <string.h>
+
+#include "utils.h"
+#include "cb_utils.h"
+#include "error_handling.h"
+#include "operation.h"
+#include "ast.h"
+#include "ast_value.h"
+#include "ast_binary.h"
+#include "ast_logical.h"
+#include "ast_unary.h"
+#include "ast_variable.h"
+#include "ast_assignment.h"
+#include "ast_control_flow.h"
+#include "ast_statement_list.h"
+#include "optimizer.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Optimizer state
+ */
+typedef struct CbOptimizer
+{
+    CbArena* arena;
+    bool success;           /* false, if an error occurred */
+    bool specialize;        /* false, while the types in a loop are inferred */
+    CbVariantType* types;   /* inferred type of each variable (by slot) */
+    size_t variable_count;
+} CbOptimizer;
+
+
+/*
+ * Optimize an AST node and its child nodes.
+ * Returns the node, that replaces the optimized node (might be the node
+ * itself). The inferred type of its value is stored in type
+ * (CB_VARIANT_TYPE_UNDEFINED, if the type is not known).
+ */
+static CbAstNode* cb_optimizer_fold(CbOptimizer* self,
+                                    CbAstNode* node,
+                                    CbVariantType* type);
+
+/*
+ * Fold a binary operation with constant operands
+ */
+static CbAstNode* cb_optimizer_fold_binary(CbOptimizer* self,
+                                           CbAstNode* node,
+                                           CbBinaryOperatorType operator_type);
+
+/*
+ * Fold a logical operation (the right operand is only folded, if the left
+ * operand does not decide the result)
+ */
+static CbAstNode* cb_optimizer_fold_logical(CbOptimizer* self,
+                                            CbAstNode* node);
+
+/*
+ * Fold a control flow statement and remove the branches, that are never
+ * executed due to a constant condition
+ */
+static CbAstNode* cb_optimizer_fold_control_flow(CbOptimizer* self,
+                                                 CbAstNode* node,
+                                                 CbVariantType* type);
+
+/*
+ * Fold a loop. The variable types at the head of the loop are inferred first
+ * (without specializing any nodes), until they do not change anymore.
+ */
+static CbAstNode* cb_optimizer_fold_loop(CbOptimizer* self, CbAstNode* node);
+
+/*
+ * Specialize a binary operation for the inferred types of its operands.
+ * Returns the inferred type of the operation.
+ */
+static CbVariantType cb_optimizer_specialize_binary(CbOptimizer* self,
+                                                    CbAstNode* node,
+                                                    CbVariantType left_type,
+                                                    CbVariantType right_type);
+
+/*
+ * Replace an integer constant by an equal float constant (returns false, if
+ * the node is no integer constant)
+ */
+static bool cb_optimizer_promote_constant(CbOptimizer* self,
+                                          CbAstNode* node,
+                                          bool left);
+
+/*
+ * Check if an assignment has the form "variable := variable + x", where x does
+ * not change the variable (see cb_ast_assignment_node_set_append())
+ */
+static bool cb_optimizer_is_append(const CbAstNode* node);
+
+/*
+ * Get the type of the result of a binary operation
+ */
+static CbVariantType cb_optimizer_get_binary_type(CbBinaryOperatorType operator_type,
+                                                  CbVariantType left_type,
+                                                  CbVariantType right_type);
+
+/*
+ * Get the inferred type of a variable
+ */
+static CbVariantType cb_optimizer_get_variable_type(const CbOptimizer* self,
+                                                    const CbAstNode* node);
+
+/*
+ * Set the inferred type of a variable
+ */
+static void cb_optimizer_set_variable_type(CbOptimizer* self,
+                                           const CbAstNode* node,
+                                           CbVariantType type);
+
+/*
+ * Join the inferred variable types with the types of another control flow
+ * path. Returns true, if the joined types differ from the types of the other
+ * path.
+ */
+static bool cb_optimizer_join_types(CbOptimizer* self,
+                                    const CbVariantType* other);
+
+/*
+ * Join two inferred types
+ */
+static CbVariantType cb_optimizer_join_type(CbVariantType a, CbVariantType b);
+
+/*
+ * Count the variables referenced in an AST
+ */
+static void cb_optimizer_count_variables(CbOptimizer* self,
+                                         const CbAstNode* node);
+
+/*
+ * Create a value node, that replaces the given node
+ */
+static CbAstNode* cb_optimizer_make_value(CbOptimizer* self,
+                                          const CbAstNode* node,
+                                          const CbVariant* value);
+
+/*
+ * Get the value of a constant node or NULL, if the node is not constant
+ */
+static const CbVariant* cb_optimizer_get_constant(const CbAstNode* node);
+
+
+/* -------------------------------------------------------------------------- */
+
+bool cb_optimizer_optimize(CbArena* arena, CbAstNode** ast)
+{
+    size_t i;
+    CbVariantType type;
+    CbOptimizer optimizer;
+    
+    optimizer.arena          = arena;
+    optimizer.success        = true;
+    optimizer.specialize     = true;
+    optimizer.types          = NULL;
+    optimizer.variable_count = 0;
+    
+    if (*ast != NULL)
+    {
+        /*
+         * Variables might be initialized from outside of the codeblock (i.e.
+         * by the inputs of a program), so their initial types are unknown.
+         */
+        cb_optimizer_count_variables(&optimizer, *ast);
+        optimizer.types = memalloc(
+            (optimizer.variable_count + 1) * sizeof(CbVariantType)
+        );
+        for (i = 0; i < optimizer.variable_count; i++)
+            optimizer.types[i] = CB_VARIANT_TYPE_UNDEFINED;
+        
+        *ast = cb_optimizer_fold(&optimizer, *ast, &type);
+        
+        memfree(optimizer.types);
+    }
+    
+    return optimizer.success;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static CbAstNode* cb_optimizer_fold(CbOptimizer* self,
+                                    CbAstNode* node,
+                                    CbVariantType* type)
+{
+    size_t i;
+    CbVariant value;
+    CbVariantType left_type;
+    CbVariantType right_type;
+    const CbVariant* operand;
+    CbAstStatementListNode* list;
+    CbAstNode* result = node;
+    
+    *type = CB_VARIANT_TYPE_UNDEFINED;
+    
+    if (node == NULL || !self->success)
+        return node;
+    
+    switch (cb_ast_node_get_type(node))
+    {
+        case CB_AST_TYPE_BINARY:
+            cb_ast_node_set_left(node, cb_optimizer_fold(
+                self, (CbAstNode*) cb_ast_node_get_left(node), &left_type
+            ));
+            cb_ast_node_set_right(node, cb_optimizer_fold(
+                self, (CbAstNode*) cb_ast_node_get_right(node), &right_type
+            ));
+            result = cb_optimizer_fold_binary(
+                self, node,
+                cb_ast_binary_node_get_operator_type((const CbAstBinaryNode*) node)
+            );
+            if (result == node)
+                *type = cb_optimizer_specialize_binary(self, node, left_type,
+                                                       right_type);
+            break;
+        
+        case CB_AST_TYPE_LOGICAL:
+            result = cb_optimizer_fold_logical(self, node);
+            *type  = CB_VARIANT_TYPE_BOOLEAN;
+            break;
+        
+        case CB_AST_TYPE_UNARY:
+            cb_ast_node_set_left(node, cb_optimizer_fold(
+                self, (CbAstNode*) cb_ast_node_get_left(node), &left_type
+            ));
+            operand = cb_optimizer_get_constant(cb_ast_node_get_left(node));
+            if (self->success && operand != NULL)
+            {
+                if (cb_unary_operation_eval(
+                        cb_ast_unary_node_get_operator_type(
+                            (const CbAstUnaryNode*) node
+                        ),
+                        operand, cb_ast_node_get_line(node), &value))
+                {
+                    result = cb_optimizer_make_value(self, node, &value);
+                    cb_variant_release(&value);
+                }
+                else
+                    self->success = false;
+            }
+            else if (cb_ast_unary_node_get_operator_type(
+                         (const CbAstUnaryNode*) node
+                     ) == CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT)
+                *type = CB_VARIANT_TYPE_BOOLEAN;
+            else if (left_type == CB_VARIANT_TYPE_INTEGER ||
+                     left_type == CB_VARIANT_TYPE_FLOAT)
+                *type = left_type;
+            break;
+        
+        case CB_AST_TYPE_ASSIGNMENT:
+            /* the left node is the assigned variable */
+            cb_ast_node_set_right(node, cb_optimizer_fold(
+                self, (CbAstNode*) cb_ast_node_get_right(node), type
+            ));
+            cb_optimizer_set_variable_type(self, cb_ast_node_get_left(node),
+                                           *type);
+            /* numbers are never appended */
+            if (self->specialize && *type != CB_VARIANT_TYPE_INTEGER &&
+                *type != CB_VARIANT_TYPE_FLOAT && cb_optimizer_is_append(node))
+                cb_ast_assignment_node_set_append((CbAstAssignmentNode*) node);
+            break;
+        
+        case CB_AST_TYPE_STATEMENT_LIST:
+            /* a statement list yields the value of its last statement */
+            list = (CbAstStatementListNode*) node;
+            for (i = 0; i < cb_ast_statement_list_node_get_count(list); i++)
+                cb_ast_statement_list_node_set(list, i, cb_optimizer_fold(
+                    self, (CbAstNode*) cb_ast_statement_list_node_get(list, i),
+                    type
+                ));
+            break;
+        
+        case CB_AST_TYPE_CONTROL_FLOW:
+            result = cb_optimizer_fold_control_flow(self, node, type);
+            break;
+        
+        case CB_AST_TYPE_VARIABLE:
+            *type = cb_optimizer_get_variable_type(self, node);
+            break;
+        
+        /* nodes without any (foldable) child nodes */
+        case CB_AST_TYPE_VALUE:
+        case CB_AST_TYPE_DECLARATION:
+        case CB_AST_TYPE_DECLARATION_BLOCK:
+            break;
+        
+        /* invalid AST node types */
+        case CB_AST_TYPE_NONE:
+        default: cb_abort("Invalid AST node type"); break;
+    }
+    
+    /* the type of a constant is always known */
+    if (result != NULL && cb_ast_node_get_type(result) == CB_AST_TYPE_VALUE)
+        *type = cb_variant_get_type(
+            cb_ast_value_node_get_value((const CbAstValueNode*) result)
+        );
+    
+    return result;
+}
+
+static CbAstNode* cb_optimizer_fold_binary(CbOptimizer* self,
+                                           CbAstNode* node,
+                                           CbBinaryOperatorType operator_type)
+{
+    CbVariant value;
+    const CbAstNode* left_node  = cb_ast_node_get_left(node);
+    const CbAstNode* right_node = cb_ast_node_get_right(node);
+    const CbVariant* left       = cb_optimizer_get_constant(left_node);
+    const CbVariant* right      = cb_optimizer_get_constant(right_node);
+    CbAstNode* result           = node;
+    
+    if (!self->success || left == NULL || right == NULL)
+        return result;
+    
+    /*
+     * A constant division by zero would fail on every execution, so it is
+     * reported right away.
+     */
+    if (operator_type == CB_BINARY_OPERATOR_TYPE_DIV &&
+        cb_variant_is_numeric(right) && cb_numeric_as_float(right) == 0.0)
+    {
+        cb_error_trigger(CB_ERROR_SEMANTIC, cb_ast_node_get_line(node),
+                         "Division by zero is not allowed");
+        self->success = false;
+    }
+    else if (cb_binary_operation_eval(operator_type, left, right,
+                                      cb_ast_node_get_line(node), &value))
+        result = cb_optimizer_make_value(self, node, &value);
+    else
+        self->success = false;
+    
+    if (result != node)
+        cb_variant_release(&value);
+    
+    return result;
+}
+
+static CbAstNode* cb_optimizer_fold_logical(CbOptimizer* self,
+                                            CbAstNode* node)
+{
+    const CbVariant* left;
+    CbVariantType type;
+    bool short_circuit;
+    CbVariantType* types               = NULL;
+    CbAstNode* result                  = node;
+    bool branch_free                   = cb_ast_logical_node_is_branch_free(
+        (const CbAstLogicalNode*) node
+    );
+    CbBinaryOperatorType operator_type = cb_ast_logical_node_get_operator_type(
+        (const CbAstLogicalNode*) node
+    );
+    
+    cb_ast_node_set_left(node, cb_optimizer_fold(
+        self, (CbAstNode*) cb_ast_node_get_left(node), &type
+    ));
+    left          = cb_optimizer_get_constant(cb_ast_node_get_left(node));
+    short_circuit = left != NULL && cb_variant_is_boolean(left) &&
+                    (cb_boolean_get_value(left) != 0) ==
+                        (operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_OR);
+    
+    /*
+     * "False and ..." and "True or ..." never evaluate the right operand, so
+     * it is neither folded nor kept. A value or variable is evaluated anyway
+     * (see cb_ast_logical_node_is_branch_free()), so its type is checked below.
+     */
+    if (short_circuit && !branch_free)
+        return (CbAstNode*) cb_ast_node_get_left(node);
+    
+    /* the right operand might be skipped at runtime */
+    if (left == NULL)
+    {
+        types = memalloc((self->variable_count + 1) * sizeof(CbVariantType));
+        memcpy(types, self->types, self->variable_count * sizeof(CbVariantType));
+    }
+    
+    cb_ast_node_set_right(node, cb_optimizer_fold(
+        self, (CbAstNode*) cb_ast_node_get_right(node), &type
+    ));
+    
+    if (types != NULL)
+    {
+        cb_optimizer_join_types(self, types);
+        memfree(types);
+    }
+    
+    if (left == NULL || !cb_variant_is_boolean(left))
+        result = cb_optimizer_fold_binary(self, node, operator_type);
+    /* a value or variable of unknown or invalid type keeps the type check */
+    else if (short_circuit)
+    {
+        if (type == CB_VARIANT_TYPE_BOOLEAN)
+            result = (CbAstNode*) cb_ast_node_get_left(node);
+        else
+            result = cb_optimizer_fold_binary(self, node, operator_type);
+    }
+    /*
+     * "True and x" and "False or x" yield the value of x, if it is known to
+     * be a boolean value (otherwise the runtime type check is still needed).
+     */
+    else if (cb_ast_node_get_expression_type(cb_ast_node_get_right(node)) ==
+             CB_VARIANT_TYPE_BOOLEAN)
+        result = (CbAstNode*) cb_ast_node_get_right(node);
+    
+    return result;
+}
+
+static CbAstNode* cb_optimizer_fold_control_flow(CbOptimizer* self,
+                                                 CbAstNode* node,
+                                                 CbVariantType* type)
+{
+    CbVariant undefined;
+    CbVariantType left_type;
+    CbVariantType right_type;
+    CbVariantType* types;
+    CbVariantType* swapped;
+    const CbVariant* condition;
+    CbAstNode* result          = node;
+    CbAstControlFlowNode* flow = (CbAstControlFlowNode*) node;
+    
+    /* the condition of a loop is evaluated before each iteration */
+    if (cb_ast_control_flow_node_get_flow_type(flow) ==
+        CB_AST_CONTROL_FLOW_TYPE_WHILE)
+        return cb_optimizer_fold_loop(self, node);
+    
+    cb_ast_control_flow_node_set_condition(flow, cb_optimizer_fold(
+        self, (CbAstNode*) cb_ast_control_flow_node_get_condition(flow), type
+    ));
+    condition = cb_optimizer_get_constant(
+        cb_ast_control_flow_node_get_condition(flow)
+    );
+    *type = CB_VARIANT_TYPE_UNDEFINED;
+    
+    if (condition == NULL || !cb_variant_is_boolean(condition))
+    {
+        /* infer the types of both branches separately and join them */
+        types = memalloc((self->variable_count + 1) * sizeof(CbVariantType));
+        memcpy(types, self->types, self->variable_count * sizeof(CbVariantType));
+        
+        cb_ast_node_set_left(node, cb_optimizer_fold(
+            self, (CbAstNode*) cb_ast_node_get_left(node), &left_type
+        ));
+        swapped     = self->types;
+        self->types = types;
+        types       = swapped;
+        cb_ast_node_set_right(node, cb_optimizer_fold(
+            self, (CbAstNode*) cb_ast_node_get_right(node), &right_type
+        ));
+        cb_optimizer_join_types(self, types);
+        memfree(types);
+        
+        *type = cb_optimizer_join_type(left_type, right_type);
+        return result;
+    }
+    
+    /* NOTE: Branches, that are never executed, are not folded either. */
+    undefined = cb_variant_make();
+    
+    /* keep the taken branch only (a missing branch yields undefined) */
+    result = (CbAstNode*) (cb_boolean_get_value(condition) ?
+                           cb_ast_node_get_left(node) :
+                           cb_ast_node_get_right(node));
+    if (result == NULL)
+        result = cb_optimizer_make_value(self, node, &undefined);
+    else
+        result = cb_optimizer_fold(self, result, type);
+    
+    return result;
+}
+
+static CbAstNode* cb_optimizer_fold_loop(CbOptimizer* self, CbAstNode* node)
+{
+    CbVariant undefined;
+    CbVariantType type;
+    const CbVariant* condition;
+    CbAstControlFlowNode* flow = (CbAstControlFlowNode*) node;
+    bool specialize            = self->specialize;
+    size_t size                = self->variable_count * sizeof(CbVariantType);
+    CbVariantType* entry       = memalloc(size + sizeof(CbVariantType));
+    CbVariantType* head        = memalloc(size + sizeof(CbVariantType));
+    
+    memcpy(entry, self->types, size);
+    self->specialize = false;
+    
+    cb_ast_control_flow_node_set_condition(flow, cb_optimizer_fold(
+        self, (CbAstNode*) cb_ast_control_flow_node_get_condition(flow), &type
+    ));
+    condition = cb_optimizer_get_constant(
+        cb_ast_control_flow_node_get_condition(flow)
+    );
+    
+    /* a loop, that is never entered, yields an undefined value */
+    if (condition != NULL && cb_variant_is_boolean(condition) &&
+        !cb_boolean_get_value(condition))
+    {
+        undefined = cb_variant_make();
+        node      = cb_optimizer_make_value(self, node, &undefined);
+    }
+    else
+    {
+        /*
+         * The types at the head of the loop are the join of the types before
+         * the loop and the types after each iteration. Types are only ever
+         * joined to "unknown", so this terminates after a few iterations.
+         */
+        memcpy(self->types, entry, size);
+        do
+        {
+            memcpy(head, self->types, size);
+            cb_optimizer_fold(
+                self, (CbAstNode*) cb_ast_control_flow_node_get_condition(flow),
+                &type
+            );
+            cb_optimizer_fold(self, (CbAstNode*) cb_ast_node_get_left(node),
+                              &type);
+        } while (self->success && cb_optimizer_join_types(self, head));
+        
+        /* specialize with the types, that hold in every iteration */
+        self->specialize = specialize;
+        cb_ast_control_flow_node_set_condition(flow, cb_optimizer_fold(
+            self, (CbAstNode*) cb_ast_control_flow_node_get_condition(flow),
+            &type
+        ));
+        /* the loop is left after evaluating its condition */
+        memcpy(entry, self->types, size);
+        cb_ast_node_set_left(node, cb_optimizer_fold(
+            self, (CbAstNode*) cb_ast_node_get_left(node), &type
+        ));
+        memcpy(self->types, entry, size);
+    }
+    
+    self->specialize = specialize;
+    memfree(entry);
+    memfree(head);
+    
+    return node;
+}
+
+static CbVariantType cb_optimizer_specialize_binary(CbOptimizer* self,
+                                                    CbAstNode* node,
+                                                    CbVariantType left_type,
+                                                    CbVariantType right_type)
+{
+    CbAstBinaryNode* binary            = (CbAstBinaryNode*) node;
+    CbBinaryOperatorType operator_type = cb_ast_binary_node_get_operator_type(
+        binary
+    );
+    CbVariantType result               = cb_optimizer_get_binary_type(
+        operator_type, left_type, right_type
+    );
+    
+    if (!self->specialize ||
+        operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_AND ||
+        operator_type == CB_BINARY_OPERATOR_TYPE_LOGICAL_OR)
+        return result;
+    
+    /*
+     * Mixed numeric operations are evaluated as float operations anyway, so an
+     * integer constant can be replaced by a float constant.
+     */
+    if (left_type == CB_VARIANT_TYPE_FLOAT &&
+        right_type == CB_VARIANT_TYPE_INTEGER &&
+        cb_optimizer_promote_constant(self, node, false))
+        right_type = CB_VARIANT_TYPE_FLOAT;
+    else if (left_type == CB_VARIANT_TYPE_INTEGER &&
+             right_type == CB_VARIANT_TYPE_FLOAT &&
+             cb_optimizer_promote_constant(self, node, true))
+        left_type = CB_VARIANT_TYPE_FLOAT;
+    
+    if (left_type == right_type)
+        cb_ast_binary_node_specialize(binary, left_type);
+    
+    return result;
+}
+
+static bool cb_optimizer_promote_constant(CbOptimizer* self,
+                                          CbAstNode* node,
+                                          bool left)
+{
+    CbVariant value;
+    const CbAstNode* operand = left ? cb_ast_node_get_left(node) :
+                                      cb_ast_node_get_right(node);
+    const CbVariant* constant = cb_optimizer_get_constant(operand);
+    bool result               = constant != NULL &&
+                                cb_variant_is_integer(constant);
+    
+    if (result)
+    {
+        value = cb_float_make((CbFloatDataType) cb_integer_get_value(constant));
+        if (left)
+            cb_ast_node_set_left(node, cb_optimizer_make_value(self, operand,
+                                                               &value));
+        else
+            cb_ast_node_set_right(node, cb_optimizer_make_value(self, operand,
+                                                                &value));
+    }
+    
+    return result;
+}
+
+static bool cb_optimizer_is_append(const CbAstNode* node)
+{
+    const CbAstNode* operation = cb_ast_node_get_right(node);
+    
+    return cb_ast_node_get_type(operation) == CB_AST_TYPE_BINARY &&
+           cb_ast_binary_node_get_operator_type(
+               (const CbAstBinaryNode*) operation
+           ) == CB_BINARY_OPERATOR_TYPE_ADD &&
+           cb_ast_node_get_type(cb_ast_node_get_left(operation)) ==
+               CB_AST_TYPE_VARIABLE &&
+           cb_ast_variable_node_is_same(
+               (const CbAstVariableNode*) cb_ast_node_get_left(node),
+               (const CbAstVariableNode*) cb_ast_node_get_left(operation)
+           ) &&
+           !cb_ast_node_has_assignment(cb_ast_node_get_right(operation));
+}
+
+static CbVariantType cb_optimizer_get_binary_type(CbBinaryOperatorType operator_type,
+                                                  CbVariantType left_type,
+                                                  CbVariantType right_type)
+{
+    CbVariantType result = CB_VARIANT_TYPE_UNDEFINED;
+    bool numeric         = (left_type == CB_VARIANT_TYPE_INTEGER ||
+                            left_type == CB_VARIANT_TYPE_FLOAT) &&
+                           (right_type == CB_VARIANT_TYPE_INTEGER ||
+                            right_type == CB_VARIANT_TYPE_FLOAT);
+    bool integer         = left_type == CB_VARIANT_TYPE_INTEGER &&
+                           right_type == CB_VARIANT_TYPE_INTEGER;
+    
+    switch (operator_type)
+    {
+        case CB_BINARY_OPERATOR_TYPE_ADD:
+            if (left_type == CB_VARIANT_TYPE_STRING &&
+                right_type == CB_VARIANT_TYPE_STRING)
+            {
+                result = CB_VARIANT_TYPE_STRING;
+                break;
+            }
+            /* fall through */
+        case CB_BINARY_OPERATOR_TYPE_SUB:
+        case CB_BINARY_OPERATOR_TYPE_MUL:
+            if (numeric)
+                result = integer ? CB_VARIANT_TYPE_INTEGER :
+                                   CB_VARIANT_TYPE_FLOAT;
+            break;
+        
+        case CB_BINARY_OPERATOR_TYPE_DIV:
+            /* an integer division yields an integer or a float value */
+            if (numeric && !integer)
+                result = CB_VARIANT_TYPE_FLOAT;
+            break;
+        
+        /* comparisons and logical operations */
+        default: result = CB_VARIANT_TYPE_BOOLEAN; break;
+    }
+    
+    return result;
+}
+
+static CbVariantType cb_optimizer_get_variable_type(const CbOptimizer* self,
+                                                    const CbAstNode* node)
+{
+    const CbAstVariableNode* variable = (const CbAstVariableNode*) node;
+    CbVariantType result              = CB_VARIANT_TYPE_UNDEFINED;
+    
+    if (cb_ast_variable_node_is_resolved(variable) &&
+        cb_ast_variable_node_get_scope_depth(variable) == 0 &&
+        cb_ast_variable_node_get_slot(variable) < self->variable_count)
+        result = self->types[cb_ast_variable_node_get_slot(variable)];
+    
+    return result;
+}
+
+static void cb_optimizer_set_variable_type(CbOptimizer* self,
+                                           const CbAstNode* node,
+                                           CbVariantType type)
+{
+    const CbAstVariableNode* variable = (const CbAstVariableNode*) node;
+    
+    if (cb_ast_variable_node_is_resolved(variable) &&
+        cb_ast_variable_node_get_scope_depth(variable) == 0 &&
+        cb_ast_variable_node_get_slot(variable) < self->variable_count)
+        self->types[cb_ast_variable_node_get_slot(variable)] = type;
+}
+
+static bool cb_optimizer_join_types(CbOptimizer* self,
+                                    const CbVariantType* other)
+{
+    size_t i;
+    bool changed = false;
+    
+    for (i = 0; i < self->variable_count; i++)
+    {
+        self->types[i] = cb_optimizer_join_type(self->types[i], other[i]);
+        if (self->types[i] != other[i])
+            changed = true;
+    }
+    
+    return changed;
+}
+
+static CbVariantType cb_optimizer_join_type(CbVariantType a, CbVariantType b)
+{
+    return a == b ? a : CB_VARIANT_TYPE_UNDEFINED;
+}
+
+static void cb_optimizer_count_variables(CbOptimizer* self,
+                                         const CbAstNode* node)
+{
+    size_t i;
+    const CbAstVariableNode* variable;
+    const CbAstStatementListNode* list;
+    
+    if (node == NULL)
+        return;
+    
+    if (cb_ast_node_get_type(node) == CB_AST_TYPE_VARIABLE)
+    {
+        variable = (const CbAstVariableNode*) node;
+        if (cb_ast_variable_node_is_resolved(variable) &&
+            cb_ast_variable_node_get_slot(variable) >= self->variable_count)
+            self->variable_count = cb_ast_variable_node_get_slot(variable) + 1;
+    }
+    else if (cb_ast_node_get_type(node) == CB_AST_TYPE_STATEMENT_LIST)
+    {
+        list = (const CbAstStatementListNode*) node;
+        for (i = 0; i < cb_ast_statement_list_node_get_count(list); i++)
+            cb_optimizer_count_variables(
+                self, cb_ast_statement_list_node_get(list, i)
+            );
+    }
+    else if (cb_ast_node_get_type(node) == CB_AST_TYPE_CONTROL_FLOW)
+        cb_optimizer_count_variables(
+            self,
+            cb_ast_control_flow_node_get_condition(
+                (const CbAstControlFlowNode*) node
+            )
+        );
+    
+    cb_optimizer_count_variables(self, cb_ast_node_get_left(node));
+    cb_optimizer_count_variables(self, cb_ast_node_get_right(node));
+}
+
+static CbAstNode* cb_optimizer_make_value(CbOptimizer* self,
+                                          const CbAstNode* node,
+                                          const CbVariant* value)
+{
+    CbAstNode* result = (CbAstNode*) cb_ast_value_node_create(self->arena,
+                                                              value);
+    cb_ast_node_set_line(result, cb_ast_node_get_line(node));
+    
+    return result;
+}
+
+static const CbVariant* cb_optimizer_get_constant(const CbAstNode* node)
+{
+    const CbVariant* result = NULL;
+    
+    if (node != NULL && cb_ast_node_get_type(node) == CB_AST_TYPE_VALUE)
+    {
+        result = cb_ast_value_node_get_value((const CbAstValueNode*) node);
+        /* an undefined value is the result of a removed statement */
+        if (cb_variant_is_undefined(result))
+            result = NULL;
+    }
+    
+    return result;
+}
@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * @file  optimizer.h
+ * @brief AST optimizer
+ * 
+ * Rewrites a semantically checked AST before it is executed or compiled:
+ * Operations, whose operands are all constant values, are folded into a single
+ * value and branches of if-statements with a constant condition are removed.
+ * Constant operations are evaluated by the same functions as at runtime (see
+ * operation.h), so folding never changes the result of a codeblock.
+ * The types of variables are inferred along the assignments in the AST. Binary
+ * operations, whose operand types are proven, are specialized for these types
+ * (see cb_ast_binary_node_specialize()). Variables start with an unknown type,
+ * since they might be initialized from outside of the codeblock.
+ ******************************************************************************/
+
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "ast.h"
+#include "arena.h"
+
+
+/**
+ * @brief Optimize an AST
+ * 
+ * Errors, that are detected while folding constants (i.e. a division by zero),
+ * are reported as semantic errors.
+ * 
+ * @param arena The arena, that owns the AST (new nodes are allocated in it)
+ * @param ast   Pointer to the root node of the AST
+ *              (NOTE: The AST must have passed the semantic check. The root
+ *                     node might be replaced.)
+ * 
+ * @return Returns false, if an error occurred.
+ */
+bool cb_optimizer_optimize(CbArena* arena, CbAstNode** ast);
+
+
+#endif /* OPTIMIZER_H */
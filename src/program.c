@@ -0,0 +1,392 @@
+#include <pthread.h>
+
+#include "utils.h"
+#include "cb_utils.h"
+#include "error_handling.h"
+#include "intern.h"
+#include "symbol_variable.h"
+#include "symbol_function.h"
+#include "vm.h"
+#include "worker_pool.h"
+#include "program.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+struct CbProgram
+{
+    CbArena* arena; /* owns the AST */
+    CbAstNode* ast;
+    CbSymbolTable* symbols; /* prototype for the symbols of an environment */
+    CbBytecode* bytecode;
+};
+
+struct CbEnvironment
+{
+    const CbProgram* program;
+    CbSymbolTable* symbols; /* used by the AST evaluation             */
+    CbVariant* registers;   /* used by the VM                         */
+    size_t register_count;
+    CbVariant result;
+    
+    /* bound input values */
+    const size_t* input_slots;
+    const CbVariant* inputs;
+    size_t input_count;
+};
+
+/* records processed at once by a worker of a batch execution */
+static const size_t CB_PROGRAM_BATCH_CHUNK_SIZE = 256;
+
+/*
+ * Shared state of a batch execution
+ */
+typedef struct CbBatch
+{
+    const CbProgram* program;
+    const size_t* input_slots;
+    size_t input_count;
+    const CbVariant* inputs;
+    size_t record_count;
+    CbVariant* results;
+    bool* success; /* per worker */
+    
+    pthread_mutex_t lock;
+    size_t next_record; /* first record of the next unprocessed chunk */
+} CbBatch;
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Create the symbols of the global scope of a program, so that every symbol
+ * occupies the same slot as in the program's symbol table.
+ */
+static CbSymbolTable* cb_environment_create_symbols(const CbProgram* program);
+
+/*
+ * Reset all variables of the environment to undefined and assign the bound
+ * input values.
+ */
+static void cb_environment_reset(CbEnvironment* self);
+
+/*
+ * Get the next chunk of records of a batch.
+ * Returns false, if all records are processed.
+ */
+static bool cb_batch_next_chunk(CbBatch* self, size_t* first, size_t* last);
+
+/*
+ * Process chunks of a batch until all records are processed (worker pool
+ * task).
+ */
+static void cb_batch_run(void* data, size_t worker);
+
+
+/* -------------------------------------------------------------------------- */
+
+CbProgram* cb_program_create(CbArena* arena,
+                             CbAstNode* ast,
+                             CbSymbolTable* symbols,
+                             CbBytecode* bytecode)
+{
+    CbProgram* self = memalloc(sizeof(CbProgram));
+    self->arena     = arena;
+    self->ast       = ast;
+    self->symbols   = symbols;
+    self->bytecode  = bytecode;
+    
+    return self;
+}
+
+void cb_program_destroy(CbProgram* self)
+{
+    if (self->arena != NULL)
+        cb_arena_destroy(self->arena);
+    if (self->bytecode != NULL)
+        cb_bytecode_destroy(self->bytecode);
+    cb_symbol_table_destroy(self->symbols);
+    memfree(self);
+}
+
+const CbAstNode* cb_program_get_ast(const CbProgram* self)
+{
+    return self->ast;
+}
+
+bool cb_program_lookup_variable(const CbProgram* self,
+                                const char* identifier,
+                                size_t* slot)
+{
+    const CbSymbol* symbol = NULL;
+    
+    /*
+     * NOTE: The global scope is searched directly instead of using
+     *       cb_symbol_table_lookup(), since the program might be shared by
+     *       several threads and a lookup updates the cache of the table.
+     */
+    identifier = cb_intern_find(identifier);
+    if (identifier != NULL)
+        symbol = cb_scope_lookup(
+            cb_symbol_table_get_global_scope(self->symbols),
+            identifier, cb_intern_hash(identifier)
+        );
+    
+    if (symbol == NULL || !cb_symbol_is_variable(symbol))
+        return false;
+    
+    *slot = cb_symbol_get_slot(symbol);
+    return true;
+}
+
+bool cb_program_execute(const CbProgram* self, CbEnvironment* environment)
+{
+    bool result;
+    
+    cb_assert(environment->program == self);
+    
+    cb_variant_release(&environment->result);
+    cb_environment_reset(environment);
+    
+    if (self->bytecode != NULL)
+        result = cb_vm_run(self->bytecode, environment->registers,
+                           &environment->result);
+    else
+        result = cb_ast_node_safe_eval_value(self->ast, environment->symbols,
+                                             &environment->result);
+    
+    if (!result)
+        cb_error_process();
+    
+    return result;
+}
+
+CbEnvironment* cb_environment_create(const CbProgram* program)
+{
+    size_t i;
+    CbEnvironment* self = memalloc(sizeof(CbEnvironment));
+    
+    self->program        = program;
+    self->symbols        = NULL;
+    self->registers      = NULL;
+    self->register_count = 0;
+    self->result         = cb_variant_make();
+    self->input_slots    = NULL;
+    self->inputs         = NULL;
+    self->input_count    = 0;
+    
+    if (program->bytecode != NULL)
+    {
+        self->register_count = cb_bytecode_get_register_count(program->bytecode);
+        self->registers      = memalloc(self->register_count * sizeof(CbVariant));
+        for (i = 0; i < self->register_count; i++)
+            self->registers[i] = cb_variant_make();
+    }
+    else
+        self->symbols = cb_environment_create_symbols(program);
+    
+    return self;
+}
+
+void cb_environment_destroy(CbEnvironment* self)
+{
+    size_t i;
+    
+    for (i = 0; i < self->register_count; i++)
+        cb_variant_release(&self->registers[i]);
+    if (self->registers != NULL)
+        memfree(self->registers);
+    if (self->symbols != NULL)
+        cb_symbol_table_destroy(self->symbols);
+    cb_variant_release(&self->result);
+    memfree(self);
+}
+
+bool cb_program_execute_batch(const CbProgram* self,
+                              const size_t* input_slots,
+                              size_t input_count,
+                              const CbVariant* inputs,
+                              size_t record_count,
+                              CbVariant* results,
+                              CbWorkerPool* workers)
+{
+    size_t i;
+    CbBatch batch;
+    bool result         = true;
+    size_t worker_count = (workers != NULL) ?
+                          cb_worker_pool_get_worker_count(workers) : 1;
+    
+    batch.program      = self;
+    batch.input_slots  = input_slots;
+    batch.input_count  = input_count;
+    batch.inputs       = inputs;
+    batch.record_count = record_count;
+    batch.results      = results;
+    batch.success      = memalloc(worker_count * sizeof(bool));
+    batch.next_record  = 0;
+    pthread_mutex_init(&batch.lock, NULL);
+    
+    for (i = 0; i < worker_count; i++)
+        batch.success[i] = true;
+    
+    if (workers != NULL)
+        cb_worker_pool_run(workers, cb_batch_run, &batch);
+    else
+        cb_batch_run(&batch, 0);
+    
+    for (i = 0; i < worker_count; i++)
+        result = result && batch.success[i];
+    
+    memfree(batch.success);
+    pthread_mutex_destroy(&batch.lock);
+    
+    return result;
+}
+
+void cb_environment_bind(CbEnvironment* self,
+                         const size_t* slots,
+                         const CbVariant* values,
+                         size_t count)
+{
+    self->input_slots = slots;
+    self->inputs      = values;
+    self->input_count = count;
+}
+
+const CbVariant* cb_environment_get_result(const CbEnvironment* self)
+{
+    return &self->result;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static CbSymbolTable* cb_environment_create_symbols(const CbProgram* program)
+{
+    size_t i;
+    const CbSymbol* prototype;
+    CbSymbol* symbol;
+    CbSymbolTable* result = cb_symbol_table_create();
+    const CbScope* global = cb_symbol_table_get_global_scope(program->symbols);
+    
+    for (i = 0; i < cb_scope_get_slot_count(global); i++)
+    {
+        prototype = cb_scope_get_slot(global, i);
+        
+        if (cb_symbol_is_function(prototype))
+            symbol = (CbSymbol*) cb_symbol_function_create(
+                cb_symbol_get_identifier(prototype)
+            );
+        else
+            symbol = (CbSymbol*) cb_symbol_variable_create(
+                cb_symbol_get_identifier(prototype)
+            );
+        
+        cb_symbol_table_insert(result, symbol);
+        cb_assert(cb_symbol_get_slot(symbol) == i);
+    }
+    
+    return result;
+}
+
+static void cb_environment_reset(CbEnvironment* self)
+{
+    size_t i;
+    CbSymbol* symbol;
+    const CbScope* global;
+    CbVariant undefined = cb_variant_make();
+    
+    if (self->registers != NULL)
+    {
+        for (i = 0; i < self->register_count; i++)
+            cb_variant_release(&self->registers[i]);
+        
+        /* the register of a variable equals its slot */
+        for (i = 0; i < self->input_count; i++)
+        {
+            cb_assert(self->input_slots[i] < self->register_count);
+            self->registers[self->input_slots[i]] =
+                cb_variant_clone(&self->inputs[i]);
+        }
+    }
+    else
+    {
+        global = cb_symbol_table_get_global_scope(self->symbols);
+        
+        for (i = 0; i < cb_scope_get_slot_count(global); i++)
+        {
+            symbol = cb_scope_get_slot(global, i);
+            if (cb_symbol_is_variable(symbol))
+                cb_symbol_variable_assign((CbSymbolVariable*) symbol,
+                                          &undefined);
+        }
+        
+        for (i = 0; i < self->input_count; i++)
+        {
+            symbol = cb_scope_get_slot(global, self->input_slots[i]);
+            cb_assert(cb_symbol_is_variable(symbol));
+            cb_symbol_variable_assign((CbSymbolVariable*) symbol,
+                                      &self->inputs[i]);
+        }
+    }
+}
+
+static bool cb_batch_next_chunk(CbBatch* self, size_t* first, size_t* last)
+{
+    bool result;
+    
+    pthread_mutex_lock(&self->lock);
+    
+    result = self->next_record < self->record_count;
+    if (result)
+    {
+        *first = self->next_record;
+        *last  = *first + CB_PROGRAM_BATCH_CHUNK_SIZE;
+        if (*last > self->record_count)
+            *last = self->record_count;
+        
+        self->next_record = *last;
+    }
+    
+    pthread_mutex_unlock(&self->lock);
+    
+    return result;
+}
+
+static void cb_batch_run(void* data, size_t worker)
+{
+    size_t i;
+    size_t first;
+    size_t last;
+    CbBatch* self              = data;
+    CbEnvironment* environment = NULL;
+    
+    while (cb_batch_next_chunk(self, &first, &last))
+    {
+        /* workers, that do not get any chunk, need no environment */
+        if (environment == NULL)
+            environment = cb_environment_create(self->program);
+        
+        for (i = first; i < last; i++)
+        {
+            cb_environment_bind(environment, self->input_slots,
+                                &self->inputs[i * self->input_count],
+                                self->input_count);
+            
+            if (cb_program_execute(self->program, environment))
+            {
+                /* move the result into the output buffer */
+                self->results[i]    = environment->result;
+                environment->result = cb_variant_make();
+            }
+            else
+            {
+                self->results[i]      = cb_variant_make();
+                self->success[worker] = false;
+            }
+        }
+    }
+    
+    if (environment != NULL)
+        cb_environment_destroy(environment);
+}
@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * @file  program.h
+ * @brief Compiled codeblocks and their execution environments
+ * 
+ * A CbProgram is a parsed and semantically checked codeblock, which can be
+ * executed many times without parsing or checking it again. All state that
+ * changes during an execution (variable values, VM registers and the result)
+ * lives in a separate CbEnvironment, so a single program can be executed with
+ * several environments.
+ * 
+ * Input values can be bound to variables declared in the codeblock (e.g.
+ * `|price, quantity| price * quantity,`), which allows to evaluate a single
+ * program for many input records (see cb_program_execute_batch()).
+ ******************************************************************************/
+
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "variant.h"
+#include "arena.h"
+#include "ast.h"
+#include "bytecode.h"
+#include "symbol_table.h"
+#include "worker_pool.h"
+
+
+/**
+ * @struct CbProgram
+ * @brief  Immutable, compiled codeblock
+ */
+typedef struct CbProgram CbProgram;
+
+/**
+ * @struct CbEnvironment
+ * @brief  Mutable state of a program execution
+ */
+typedef struct CbEnvironment CbEnvironment;
+
+
+/**
+ * @memberof CbProgram
+ * @brief    Constructor
+ * 
+ * @param arena    The arena, that owns the AST
+ * @param ast      The semantically checked AST (NULL for an empty program)
+ * @param symbols  The symbol table used during the semantic check
+ * @param bytecode The compiled AST or NULL to evaluate the AST directly
+ * 
+ * NOTE: The program takes ownership of all arguments.
+ */
+CbProgram* cb_program_create(CbArena* arena,
+                             CbAstNode* ast,
+                             CbSymbolTable* symbols,
+                             CbBytecode* bytecode);
+
+/**
+ * @memberof CbProgram
+ * @brief    Destructor
+ * 
+ * @param self The CbProgram instance
+ *             (NOTE: All environments of the program must be destroyed first)
+ */
+void cb_program_destroy(CbProgram* self);
+
+/**
+ * @memberof CbProgram
+ * @brief    Get the AST of the program
+ * 
+ * @param self The CbProgram instance
+ * 
+ * @return Returns NULL for an empty program.
+ */
+const CbAstNode* cb_program_get_ast(const CbProgram* self);
+
+/**
+ * @memberof CbProgram
+ * @brief    Lookup a variable declared in the global scope of the program
+ * 
+ * @param self       The CbProgram instance
+ * @param identifier The identifier of the variable
+ * @param slot       Receives the slot of the variable (see cb_environment_bind())
+ * 
+ * @return Returns false, if there is no such variable.
+ */
+bool cb_program_lookup_variable(const CbProgram* self,
+                                const char* identifier,
+                                size_t* slot);
+
+/**
+ * @memberof CbProgram
+ * @brief    Execute the program
+ * 
+ * All variables of the environment are reset to undefined and the bound
+ * input values are assigned before the execution starts. The result of a
+ * previous execution is released.
+ * 
+ * @param self        The CbProgram instance
+ * @param environment An environment created for this program
+ * 
+ * @return Returns false, if a runtime error occurred.
+ */
+bool cb_program_execute(const CbProgram* self, CbEnvironment* environment);
+
+/**
+ * @memberof CbProgram
+ * @brief    Execute the program once for each input record
+ * 
+ * The records are split into chunks, which are processed by the workers of a
+ * pool. Each worker uses a single environment for all of its records.
+ * 
+ * @param self         The CbProgram instance
+ * @param input_slots  Slots of the input variables (input_count items)
+ * @param input_count  Number of input variables per record
+ * @param inputs       Input values (record_count * input_count items): The
+ *                     values of a record are stored one after another in the
+ *                     order of input_slots.
+ * @param record_count Number of records
+ * @param results      Caller provided buffer for the results (record_count
+ *                     items). The results must be released by the caller (see
+ *                     cb_variant_release()). If the execution of a record
+ *                     fails, its result is undefined.
+ * @param workers      The pool of worker threads or NULL to execute all records
+ *                     in the calling thread. The pool is reused by later
+ *                     batches, so no threads are started per batch.
+ * 
+ * NOTE: Worker threads report errors to the error output of the calling
+ *       thread.
+ * 
+ * @return Returns false, if a runtime error occurred for any record.
+ */
+bool cb_program_execute_batch(const CbProgram* self,
+                              const size_t* input_slots,
+                              size_t input_count,
+                              const CbVariant* inputs,
+                              size_t record_count,
+                              CbVariant* results,
+                              CbWorkerPool* workers);
+
+/**
+ * @memberof CbEnvironment
+ * @brief    Constructor
+ * 
+ * @param program The program the environment is created for
+ */
+CbEnvironment* cb_environment_create(const CbProgram* program);
+
+/**
+ * @memberof CbEnvironment
+ * @brief    Destructor
+ * 
+ * @param self The CbEnvironment instance
+ */
+void cb_environment_destroy(CbEnvironment* self);
+
+/**
+ * @memberof CbEnvironment
+ * @brief    Bind input values to variables
+ * 
+ * The values are assigned to the variables at the beginning of each
+ * execution. Previously bound values are discarded.
+ * 
+ * @param self   The CbEnvironment instance
+ * @param slots  Slots of the variables (see cb_program_lookup_variable())
+ * @param values Values of the variables
+ * @param count  Number of variables
+ * 
+ * NOTE: Both arrays are not copied and must stay valid until the next
+ *       execution.
+ */
+void cb_environment_bind(CbEnvironment* self,
+                         const size_t* slots,
+                         const CbVariant* values,
+                         size_t count);
+
+/**
+ * @memberof CbEnvironment
+ * @brief    Get the result of the last successful execution
+ * 
+ * @param self The CbEnvironment instance
+ * 
+ * @return Returns the result, which is valid until the next execution.
+ */
+const CbVariant* cb_environment_get_result(const CbEnvironment* self);
+
+
+#endif /* PROGRAM_H */
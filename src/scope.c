@@ -1,6 +1,8 @@
 #include <stdlib.h>
 
 #include "utils.h"
+#include "cb_utils.h"
+#include "hash_table.h"
 #include "symbol.h"
 #include "scope.h"
 
@@ -10,26 +12,128 @@
 struct CbScope
 {
     const CbScope* parent;
-    CbHashTable* symbols;
+    size_t depth;
+    CbHashTable* symbols; /* index of the frame (NULL for small frames) */
+    
+    /* frame: symbols in order of declaration, indexed by slot */
+    CbScopeFrames* frames;
+    size_t base;          /* index of the first slot in frames */
+    size_t slot_count;
 };
 
+/*
+ * Number of scope records per block: The records are allocated in blocks,
+ * which never move, so the addresses of the scopes stay valid.
+ */
+#define CB_SCOPE_FRAMES_BLOCK_SIZE 16
+
+typedef struct CbScopeBlock
+{
+    CbScope scopes[CB_SCOPE_FRAMES_BLOCK_SIZE];
+} CbScopeBlock;
+
+struct CbScopeFrames
+{
+    CbSymbol** slots; /* frames of all scopes, the innermost one on top */
+    size_t count;
+    size_t capacity;
+    
+    CbScopeBlock** blocks; /* records of all scopes, the innermost one on top */
+    size_t block_count;
+    size_t scope_count;
+};
+
+static const size_t CB_SCOPE_FRAMES_INITIAL_CAPACITY = 32;
+
+/*
+ * Maximum number of symbols, that are searched linearly (larger frames are
+ * indexed by a hash table)
+ */
+static const size_t CB_SCOPE_LINEAR_LOOKUP_LIMIT = 8;
+
 
 /* -------------------------------------------------------------------------- */
 
-CbScope* cb_scope_create(const CbScope* parent)
+CbScopeFrames* cb_scope_frames_create()
+{
+    CbScopeFrames* self = memalloc(sizeof(CbScopeFrames));
+    self->count         = 0;
+    self->capacity      = CB_SCOPE_FRAMES_INITIAL_CAPACITY;
+    self->slots         = memalloc(self->capacity * sizeof(CbSymbol*));
+    self->blocks        = NULL;
+    self->block_count   = 0;
+    self->scope_count   = 0;
+    
+    return self;
+}
+
+void cb_scope_frames_destroy(CbScopeFrames* self)
+{
+    size_t i;
+    
+    cb_assert(self->count == 0 && self->scope_count == 0);
+    
+    for (i = 0; i < self->block_count; i++)
+        memfree(self->blocks[i]);
+    if (self->blocks != NULL)
+        memfree(self->blocks);
+    memfree(self->slots);
+    memfree(self);
+}
+
+CbScope* cb_scope_frames_get_current(const CbScopeFrames* self)
+{
+    size_t top;
+    
+    if (self->scope_count == 0)
+        return NULL;
+    
+    top = self->scope_count - 1;
+    return &self->blocks[top / CB_SCOPE_FRAMES_BLOCK_SIZE]
+        ->scopes[top % CB_SCOPE_FRAMES_BLOCK_SIZE];
+}
+
+CbScope* cb_scope_create(const CbScope* parent, CbScopeFrames* frames)
 {
-    CbScope* self = (CbScope*) memalloc(sizeof(CbScope));
+    CbScope* self;
+    
+    /* all blocks are in use -> add another one */
+    if (frames->scope_count == frames->block_count * CB_SCOPE_FRAMES_BLOCK_SIZE)
+    {
+        frames->blocks = memrealloc(frames->blocks, (frames->block_count + 1) *
+                                    sizeof(CbScopeBlock*));
+        cb_assert(frames->blocks != NULL);
+        frames->blocks[frames->block_count++] = memalloc(sizeof(CbScopeBlock));
+    }
+    frames->scope_count++;
+    
+    self          = cb_scope_frames_get_current(frames);
     self->parent  = parent;
-    self->symbols =
-        cb_hash_table_create(16, NULL, (CbHashItemDestructor) cb_symbol_destroy);
+    self->depth   = (parent == NULL) ? 0 : parent->depth + 1;
+    self->symbols = NULL;
+    
+    /* the frame starts empty on top of the stack */
+    self->frames     = frames;
+    self->base       = frames->count;
+    self->slot_count = 0;
     
     return self;
 }
 
 void cb_scope_destroy(CbScope* self)
 {
-    cb_hash_table_destroy(self->symbols);
-    memfree(self);
+    size_t i;
+    
+    cb_assert(self == cb_scope_frames_get_current(self->frames));
+    cb_assert(self->base + self->slot_count == self->frames->count);
+    
+    for (i = 0; i < self->slot_count; i++)
+        cb_symbol_destroy(self->frames->slots[self->base + i]);
+    self->frames->count = self->base;
+    
+    if (self->symbols != NULL)
+        cb_hash_table_destroy(self->symbols);
+    self->frames->scope_count--;
 }
 
 const CbScope* cb_scope_get_parent(const CbScope* self)
@@ -37,7 +141,79 @@ const CbScope* cb_scope_get_parent(const CbScope* self)
     return self->parent;
 }
 
-CbHashTable* cb_scope_get_symbols(const CbScope* self)
+size_t cb_scope_get_depth(const CbScope* self)
+{
+    return self->depth;
+}
+
+size_t cb_scope_add_slot(CbScope* self, CbSymbol* symbol)
+{
+    size_t i;
+    CbScopeFrames* frames = self->frames;
+    
+    /* only the innermost frame can grow */
+    cb_assert(self->base + self->slot_count == frames->count);
+    
+    if (frames->count == frames->capacity)
+    {
+        frames->capacity *= 2;
+        frames->slots     = memrealloc(frames->slots,
+                                       frames->capacity * sizeof(CbSymbol*));
+        cb_assert(frames->slots != NULL);
+    }
+    
+    frames->slots[frames->count++] = symbol;
+    self->slot_count++;
+    
+    /* index the frame, once it gets too large to be searched linearly */
+    if (self->symbols != NULL)
+        cb_hash_table_insert(self->symbols, cb_symbol_get_identifier(symbol),
+                             symbol);
+    else if (self->slot_count > CB_SCOPE_LINEAR_LOOKUP_LIMIT)
+    {
+        self->symbols = cb_hash_table_create_interned(2 * self->slot_count,
+                                                      NULL);
+        for (i = 0; i < self->slot_count; i++)
+            cb_hash_table_insert(self->symbols,
+                                 cb_symbol_get_identifier(
+                                     frames->slots[self->base + i]
+                                 ),
+                                 frames->slots[self->base + i]);
+    }
+    
+    return self->slot_count - 1;
+}
+
+CbSymbol* cb_scope_get_slot(const CbScope* self, size_t slot)
 {
-    return self->symbols;
+    cb_assert(slot < self->slot_count);
+    return self->frames->slots[self->base + slot];
+}
+
+size_t cb_scope_get_slot_count(const CbScope* self)
+{
+    return self->slot_count;
+}
+
+CbSymbol* cb_scope_lookup(const CbScope* self,
+                          const char* identifier,
+                          CbHashSize hash)
+{
+    size_t i;
+    CbSymbol* result = NULL;
+    
+    if (self->symbols != NULL)
+        result = cb_hash_table_get_hashed(self->symbols, identifier, hash);
+    else
+    {
+        /* interned identifiers are equal, if their addresses are equal */
+        for (i = 0; i < self->slot_count && result == NULL; i++)
+        {
+            if (cb_symbol_get_identifier(self->frames->slots[self->base + i]) ==
+                identifier)
+                result = self->frames->slots[self->base + i];
+        }
+    }
+    
+    return result;
 }
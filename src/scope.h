@@ -3,14 +3,23 @@
  * @brief Contains the CbScope structure
  * 
  * Representation of a scope in Codeblock source code.
+ * The symbols of a scope are stored in a frame: A contiguous range of slots on
+ * a stack, that is shared by all nested scopes (see CbScopeFrames). The slots
+ * hold pointers to the symbols, which are separate objects. The records of the
+ * scopes (parent, frame base and slot count) are kept on a second stack of
+ * CbScopeFrames, whose memory is reused: Once the stacks are deep enough,
+ * entering and leaving a scope does not allocate anything. Small scopes are
+ * searched linearly, larger ones are indexed by a hash table.
  ******************************************************************************/
 
 #ifndef SCOPE_H
 #define SCOPE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "hash_table.h"
+#include "symbol.h"
 
 
 /**
@@ -19,20 +28,59 @@
  */
 typedef struct CbScope CbScope;
 
+/**
+ * @struct CbScopeFrames
+ * @brief  Stack of the records and slots of nested scopes
+ */
+typedef struct CbScopeFrames CbScopeFrames;
+
+/**
+ * @memberof CbScopeFrames
+ * @brief Constructor
+ */
+CbScopeFrames* cb_scope_frames_create();
+
+/**
+ * @memberof CbScopeFrames
+ * @brief Destructor
+ * 
+ * @param self The frames instance (NOTE: All scopes must be destroyed before.)
+ */
+void cb_scope_frames_destroy(CbScopeFrames* self);
+
+/**
+ * @memberof CbScopeFrames
+ * @brief Get the scope created last (i.e. the innermost scope)
+ * 
+ * @param self The frames instance
+ * 
+ * @return Returns NULL, if there is no scope.
+ */
+CbScope* cb_scope_frames_get_current(const CbScopeFrames* self);
+
 /**
  * @memberof CbScope
  * @brief Constructor
  * 
+ * Takes the next record from the frames. Its address does not change until
+ * the scope is destroyed.
+ * 
  * @param parent The parent scope
  *               If parent is NULL, the created scope is treated as gloabal
  *               scope.
+ * @param frames The stack, that holds the frame of the scope
+ *               (NOTE: Scopes sharing the same frames must be destroyed in
+ *                      reverse order of their creation.)
  */
-CbScope* cb_scope_create(const CbScope* parent);
+CbScope* cb_scope_create(const CbScope* parent, CbScopeFrames* frames);
 
 /**
  * @memberof CbScope
  * @brief Destructor
  * 
+ * Destroys the symbols in the frame of the scope as well and returns its record
+ * to the frames.
+ * 
  * @param self The scope instance
  */
 void cb_scope_destroy(CbScope* self);
@@ -47,11 +95,55 @@ const CbScope* cb_scope_get_parent(const CbScope* self);
 
 /**
  * @memberof CbScope
- * @brief Get hash table with symbols
+ * @brief Get the depth of the scope (0 = global scope)
  * 
  * @param self The scope instance
  */
-CbHashTable* cb_scope_get_symbols(const CbScope* self);
+size_t cb_scope_get_depth(const CbScope* self);
+
+/**
+ * @memberof CbScope
+ * @brief Append a symbol to the frame of the scope
+ * 
+ * @param self   The scope instance
+ *               (NOTE: Only the scope created last can grow its frame.)
+ * @param symbol The symbol (NOTE: The scope takes ownership)
+ * 
+ * @return Returns the slot index of the symbol.
+ */
+size_t cb_scope_add_slot(CbScope* self, CbSymbol* symbol);
+
+/**
+ * @memberof CbScope
+ * @brief Get the symbol stored in a slot of the scope's frame
+ * 
+ * @param self The scope instance
+ * @param slot The slot index
+ */
+CbSymbol* cb_scope_get_slot(const CbScope* self, size_t slot);
+
+/**
+ * @memberof CbScope
+ * @brief Get the number of slots in the scope's frame
+ * 
+ * @param self The scope instance
+ */
+size_t cb_scope_get_slot_count(const CbScope* self);
+
+/**
+ * @memberof CbScope
+ * @brief Find a symbol declared in the scope (not in its parents)
+ * 
+ * @param self       The scope instance
+ * @param identifier The interned identifier of the symbol
+ * @param hash       The hash of the identifier (see cb_intern_hash()), so it
+ *                   is not computed again for each scope
+ * 
+ * @return Returns NULL, if there is no such symbol in the scope.
+ */
+CbSymbol* cb_scope_lookup(const CbScope* self,
+                          const char* identifier,
+                          CbHashSize hash);
 
 
 #endif /* SCOPE_H */
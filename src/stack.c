@@ -1,67 +1,65 @@
 #include <stdlib.h>
 
+#include "utils.h"
+#include "cb_utils.h"
 #include "stack.h"
 
 
 /* -------------------------------------------------------------------------- */
 
-typedef struct CbStackItem CbStackItem;
-struct CbStackItem
-{
-    CbStackItem* prior;
-    const void* data;
-};
-
 struct CbStack
 {
-    CbStackItem* top;
+    const void** items; /* items[count - 1] is the top item */
     size_t count;
+    size_t capacity;
 };
 
+static const size_t CB_STACK_INITIAL_CAPACITY = 8;
+
 
 /* -------------------------------------------------------------------------- */
 
 CbStack* cb_stack_create()
 {
-    CbStack* self = (CbStack*) malloc(sizeof(CbStack));
-    self->top     = NULL;
-    self->count   = 0;
+    CbStack* self  = (CbStack*) memalloc(sizeof(CbStack));
+    self->count    = 0;
+    self->capacity = CB_STACK_INITIAL_CAPACITY;
+    self->items    = memalloc(self->capacity * sizeof(void*));
     
     return self;
 }
 
 void cb_stack_destroy(CbStack* self)
 {
-    free(self);
+    memfree(self->items);
+    memfree(self);
 }
 
 void cb_stack_push(CbStack* self, const void* item)
 {
-    CbStackItem* stack_item = (CbStackItem*) malloc(sizeof(CbStackItem));
-    stack_item->data        = item;
-    stack_item->prior       = self->top;
+    /* grow geometrically, so pushing takes amortized constant time */
+    if (self->count == self->capacity)
+    {
+        self->capacity *= 2;
+        self->items     = memrealloc(self->items,
+                                     self->capacity * sizeof(void*));
+        cb_assert(self->items != NULL);
+    }
     
-    self->top = stack_item;
-    self->count++;
+    self->items[self->count++] = item;
 }
 
 bool cb_stack_pop(CbStack* self, void** dest)
 {
-    CbStackItem* temp;
-    
     /* check for stack-underflow */
     if (cb_stack_is_empty(self))
         return false;
     
+    self->count--;
+    
     /* only set destinaion, if it's a valid memory-address */
     if (dest != NULL)
-        *dest = (void*) self->top->data;
-    
-    temp      = self->top;
-    self->top = self->top->prior; /* move top to prior item */
-    free(temp);                   /* free former top item */
-    
-    self->count--;
+        *dest = (void*) self->items[self->count];
     
     return true;
 }
@@ -69,8 +67,8 @@ bool cb_stack_pop(CbStack* self, void** dest)
 const void* cb_stack_get_top_item(const CbStack* self)
 {
     const void* result = NULL;
-    if (self->top)
-        result = self->top->data;
+    if (self->count > 0)
+        result = self->items[self->count - 1];
     
     return result;
 }
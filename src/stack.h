@@ -2,7 +2,9 @@
  * @file  stack.h
  * @brief Contains the CbStack structure
  * 
- * Implementation of a simple generic stack data structure
+ * Implementation of a simple generic stack data structure. The items are
+ * stored in an array, that grows geometrically (i.e. pushing and popping items
+ * does not allocate memory in general).
  ******************************************************************************/
 
 #ifndef STACK_H
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 
 #include "utils.h"
+#include "intern.h"
 #include "symbol.h"
 #include "symbol_internal.h"
 
@@ -35,15 +36,19 @@ void cb_symbol_init(CbSymbol* self,
                     CbSymbolDestructorFunc destructor,
                     CbSymbolGetDataTypeFunc get_data_type)
 {
+    /* already interned by the caller (e.g. the lexer) */
+    cb_intern_assert(identifier);
+    
     self->type          = type;
-    self->identifier    = strdup(identifier);
+    self->identifier    = identifier;
+    self->scope_depth   = 0;
+    self->slot          = 0;
     self->destructor    = destructor;
     self->get_data_type = get_data_type;
 }
 
 void cb_symbol_destroy(CbSymbol* self)
 {
-    memfree(self->identifier);
     self->destructor(self);
 }
 
@@ -52,6 +57,22 @@ const char* cb_symbol_get_identifier(const CbSymbol* self)
     return self->identifier;
 }
 
+void cb_symbol_set_slot(CbSymbol* self, size_t scope_depth, size_t slot)
+{
+    self->scope_depth = scope_depth;
+    self->slot        = slot;
+}
+
+size_t cb_symbol_get_scope_depth(const CbSymbol* self)
+{
+    return self->scope_depth;
+}
+
+size_t cb_symbol_get_slot(const CbSymbol* self)
+{
+    return self->slot;
+}
+
 CbSymbolType cb_symbol_get_type(const CbSymbol* self)
 {
     return self->type;
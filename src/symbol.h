@@ -11,6 +11,7 @@
 #define SYMBOL_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "variant.h"
 
@@ -48,10 +49,39 @@ void cb_symbol_destroy(CbSymbol* self);
  * @memberof CbSymbol
  * @brief    Get the symbol identifier
  * 
+ * The identifier is interned (see intern.h).
+ * 
  * @param self The CbSymbol instance
  */
 const char* cb_symbol_get_identifier(const CbSymbol* self);
 
+/**
+ * @memberof CbSymbol
+ * @brief    Set the location of the symbol (i.e. its slot in the frame of the
+ *           declaring scope)
+ * 
+ * @param self        The CbSymbol instance
+ * @param scope_depth Depth of the declaring scope (0 = global scope)
+ * @param slot        Slot index within the declaring scope
+ */
+void cb_symbol_set_slot(CbSymbol* self, size_t scope_depth, size_t slot);
+
+/**
+ * @memberof CbSymbol
+ * @brief    Get the depth of the declaring scope
+ * 
+ * @param self The CbSymbol instance
+ */
+size_t cb_symbol_get_scope_depth(const CbSymbol* self);
+
+/**
+ * @memberof CbSymbol
+ * @brief    Get the slot index within the declaring scope
+ * 
+ * @param self The CbSymbol instance
+ */
+size_t cb_symbol_get_slot(const CbSymbol* self);
+
 /**
  * @memberof CbSymbol
  * @brief    Get the symbol type
@@ -22,6 +22,7 @@ typedef struct CbSymbolFunction CbSymbolFunction;
 
 /*
  * Create a CbSymbolFunction object.
+ * NOTE: The identifier must be interned (see cb_intern()).
  */
 CbSymbolFunction* cb_symbol_function_create(const char* identifier);
 
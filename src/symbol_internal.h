@@ -22,7 +22,9 @@ typedef CbVariantType (*CbSymbolGetDataTypeFunc) (const CbSymbol*);
 struct CbSymbol
 {
     CbSymbolType type;
-    char* identifier;
+    const char* identifier; /* interned (see intern.h) */
+    size_t scope_depth; /* depth of the declaring scope (0 = global scope) */
+    size_t slot;        /* slot index within the declaring scope          */
     
     CbSymbolDestructorFunc  destructor;
     CbSymbolGetDataTypeFunc get_data_type;
@@ -34,6 +36,7 @@ struct CbSymbol
 
 /*
  * Initialize a CbSymbol object.
+ * NOTE: The identifier must be interned (see cb_intern()).
  */
 void cb_symbol_init(CbSymbol* self,
                     CbSymbolType type,
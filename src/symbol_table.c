@@ -2,21 +2,52 @@
 
 #include "utils.h"
 #include "cb_utils.h"
-#include "stack.h"
-#include "hash_table.h"
+#include "intern.h"
 #include "symbol_table.h"
 
 
 /* -------------------------------------------------------------------------- */
 
+#define CB_SYMBOL_TABLE_CACHE_SIZE 32 /* must be a power of two */
+
+typedef struct CbSymbolCacheEntry
+{
+    const char* identifier; /* interned identifier */
+    CbSymbol* symbol;
+    size_t generation;
+} CbSymbolCacheEntry;
+
+/*
+ * Cache of recently resolved symbols, indexed by the hash of the identifier.
+ * Entries of an older generation are invalid, so the whole cache is
+ * invalidated in constant time.
+ */
+typedef struct CbSymbolCache
+{
+    size_t generation;
+    CbSymbolCacheEntry entries[CB_SYMBOL_TABLE_CACHE_SIZE];
+} CbSymbolCache;
+
 struct CbSymbolTable
 {
-    CbStack* scope_stack;
     CbScope* global_scope;
+    CbScopeFrames* frames; /* records and frames of all scopes */
+    
+    /*
+     * NOTE: The cache is allocated separately, since lookups update it through
+     *       a const symbol table.
+     */
+    CbSymbolCache* cache;
 };
 
 
-static CbHashTable* cb_symbol_table_get_current_symbols(const CbSymbolTable* self);
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Invalidate all cached lookups (e.g. if a symbol might be shadowed or
+ * destroyed).
+ */
+static void cb_symbol_table_invalidate_cache(const CbSymbolTable* self);
 
 
 /* -------------------------------------------------------------------------- */
@@ -24,36 +55,48 @@ static CbHashTable* cb_symbol_table_get_current_symbols(const CbSymbolTable* sel
 CbSymbolTable* cb_symbol_table_create()
 {
     CbSymbolTable* self = (CbSymbolTable*) memalloc(sizeof(CbSymbolTable));
-    self->scope_stack   = cb_stack_create();
-    self->global_scope  = cb_scope_create(NULL); /* create global scope */
+    self->frames        = cb_scope_frames_create();
+    /* create global scope */
+    self->global_scope  = cb_scope_create(NULL, self->frames);
     
-    cb_stack_push(self->scope_stack, self->global_scope);
+    self->cache             = memalloc(sizeof(CbSymbolCache));
+    memclr(self->cache, sizeof(CbSymbolCache));
+    self->cache->generation = 1; /* entries of generation 0 are unused */
     
     return self;
 }
 
 void cb_symbol_table_destroy(CbSymbolTable* self)
 {
-    cb_assert(cb_stack_pop(self->scope_stack, NULL));
-    cb_stack_destroy(self->scope_stack);
-    cb_scope_destroy(self->global_scope); /* destroy global scope separately */
+    cb_assert(cb_scope_frames_get_current(self->frames) == self->global_scope);
+    cb_scope_destroy(self->global_scope);
+    cb_scope_frames_destroy(self->frames);
+    memfree(self->cache);
     memfree(self);
 }
 
 const CbSymbol* cb_symbol_table_insert(const CbSymbolTable* self,
                                        CbSymbol* symbol)
 {
-    CbHashTable* symbols   = cb_symbol_table_get_current_symbols(self);
+    CbScope* current       = cb_scope_frames_get_current(self->frames);
     const char* identifier = cb_symbol_get_identifier(symbol);
     CbSymbol* result       = NULL;
     
-    result = cb_hash_table_get(symbols, identifier);
+    cb_assert(current != NULL);
+    
+    result = cb_scope_lookup(current, identifier, cb_intern_hash(identifier));
     if (result == NULL)
+    {
         /*
          * Insert symbol only if there isn't already  any symbol with the same
-         * identifier in the current scope.
+         * identifier in the current scope. It gets a slot in the frame of the
+         * current scope.
          */
-        cb_hash_table_insert(symbols, identifier, symbol);
+        cb_symbol_set_slot(symbol, cb_scope_get_depth(current),
+                           cb_scope_add_slot(current, symbol));
+        /* the symbol might shadow a cached symbol of a parent scope */
+        cb_symbol_table_invalidate_cache(self);
+    }
     
     return result;
 }
@@ -61,52 +104,97 @@ const CbSymbol* cb_symbol_table_insert(const CbSymbolTable* self,
 CbSymbol* cb_symbol_table_lookup(const CbSymbolTable* self,
                                  const char* identifier)
 {
-    CbSymbol* result       = NULL;
-    const CbScope* current = cb_stack_get_top_item(self->scope_stack);
-    const CbScope* parent  = cb_scope_get_parent(current);
-    CbHashTable* symbols   = cb_scope_get_symbols(current);
+    /* an identifier, that was never interned, can not be declared */
+    identifier = cb_intern_find(identifier);
+    if (identifier == NULL)
+        return NULL;
+    
+    return cb_symbol_table_lookup_interned(self, identifier);
+}
+
+CbSymbol* cb_symbol_table_lookup_interned(const CbSymbolTable* self,
+                                          const char* identifier)
+{
+    CbSymbol* result          = NULL;
+    const CbScope* current    = cb_scope_frames_get_current(self->frames);
+    const CbScope* parent     = cb_scope_get_parent(current);
+    CbHashSize hash           = cb_intern_hash(identifier);
+    CbSymbolCacheEntry* entry =
+        &self->cache->entries[hash & (CB_SYMBOL_TABLE_CACHE_SIZE - 1)];
     
-    result = cb_hash_table_get(symbols, identifier);
-    while (result == NULL && parent != NULL)
+    if (entry->generation == self->cache->generation &&
+        entry->identifier == identifier)
+        result = entry->symbol;
+    else
     {
-        symbols = cb_scope_get_symbols(parent);
-        result  = cb_hash_table_get(symbols, identifier);
-        parent  = cb_scope_get_parent(parent);
+        /* the hash is computed once and reused for each scope */
+        result = cb_scope_lookup(current, identifier, hash);
+        while (result == NULL && parent != NULL)
+        {
+            result = cb_scope_lookup(parent, identifier, hash);
+            parent = cb_scope_get_parent(parent);
+        }
+        
+        if (result != NULL)
+        {
+            entry->identifier = identifier;
+            entry->symbol     = result;
+            entry->generation = self->cache->generation;
+        }
     }
     
     return result;
 }
 
+CbSymbol* cb_symbol_table_get_slot(const CbSymbolTable* self,
+                                   size_t scope_depth,
+                                   size_t slot)
+{
+    const CbScope* scope = cb_scope_frames_get_current(self->frames);
+    
+    /* walk up to the declaring scope */
+    while (cb_scope_get_depth(scope) > scope_depth)
+        scope = cb_scope_get_parent(scope);
+    
+    cb_assert(scope != NULL && cb_scope_get_depth(scope) == scope_depth);
+    
+    return cb_scope_get_slot(scope, slot);
+}
+
+const CbScope* cb_symbol_table_get_global_scope(const CbSymbolTable* self)
+{
+    return self->global_scope;
+}
+
 void cb_symbol_table_enter_scope(CbSymbolTable* self)
 {
-    const CbScope* parent = cb_stack_get_top_item(self->scope_stack);
+    const CbScope* parent = cb_scope_frames_get_current(self->frames);
     cb_symbol_table_switch_scope(self, parent);
 }
 
 void cb_symbol_table_switch_scope(CbSymbolTable* self, const CbScope* parent)
 {
-    CbScope* new_scope;
-    
     if (parent == NULL)
         parent = self->global_scope;
     
-    new_scope = cb_scope_create(parent);
-    cb_stack_push(self->scope_stack, new_scope);
+    cb_scope_create(parent, self->frames);
+    cb_symbol_table_invalidate_cache(self);
 }
 
 void cb_symbol_table_leave_scope(CbSymbolTable* self)
 {
-    CbScope* current;
-    cb_assert(cb_stack_pop(self->scope_stack, (void**) &current));
+    CbScope* current = cb_scope_frames_get_current(self->frames);
+    
+    /* the global scope can not be left */
+    cb_assert(current != self->global_scope);
     cb_scope_destroy(current);
+    cb_symbol_table_invalidate_cache(self);
 }
 
 
 /* -------------------------------------------------------------------------- */
 
-static CbHashTable* cb_symbol_table_get_current_symbols(const CbSymbolTable* self)
+static void cb_symbol_table_invalidate_cache(const CbSymbolTable* self)
 {
-    const CbScope* current = cb_stack_get_top_item(self->scope_stack);
-    cb_assert(current != NULL);
-    return  cb_scope_get_symbols(current);
+    self->cache->generation++;
 }
@@ -10,6 +10,7 @@
 #define SYMBOL_TABLE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "scope.h"
 #include "symbol.h"
@@ -57,6 +58,12 @@ const CbSymbol* cb_symbol_table_insert(const CbSymbolTable* self,
  * @memberof CbSymbolTable
  * @brief    Lookup a symbol by its identifier
  * 
+ * The identifier is hashed once for all scopes. Resolved symbols are cached
+ * until a scope is entered or left or a symbol is inserted, so repeated
+ * lookups take constant time regardless of the nesting depth.
+ * NOTE: Since lookups update the cache, a symbol table must not be used by
+ *       several threads at the same time.
+ * 
  * @param self       The CbSymbolTable instance
  * @param identifier The identifier of the symbol
  * 
@@ -65,6 +72,45 @@ const CbSymbol* cb_symbol_table_insert(const CbSymbolTable* self,
 CbSymbol* cb_symbol_table_lookup(const CbSymbolTable* self,
                                  const char* identifier);
 
+/**
+ * @memberof CbSymbolTable
+ * @brief    Lookup a symbol by its interned identifier
+ * 
+ * Same as cb_symbol_table_lookup(), but the identifier does not need to be
+ * looked up in the intern pool first.
+ * 
+ * @param self       The CbSymbolTable instance
+ * @param identifier The identifier of the symbol (see cb_intern())
+ * 
+ * @return Returns NULL if there is no symbol declared with the given identifier
+ */
+CbSymbol* cb_symbol_table_lookup_interned(const CbSymbolTable* self,
+                                          const char* identifier);
+
+/**
+ * @memberof CbSymbolTable
+ * @brief    Get a symbol by its location (without any identifier lookup)
+ * 
+ * @param self        The CbSymbolTable instance
+ * @param scope_depth Depth of the declaring scope
+ *                    (see cb_symbol_get_scope_depth())
+ * @param slot        Slot index within the declaring scope
+ *                    (see cb_symbol_get_slot())
+ * 
+ * NOTE: The declaring scope must be the current scope or one of its parents.
+ */
+CbSymbol* cb_symbol_table_get_slot(const CbSymbolTable* self,
+                                   size_t scope_depth,
+                                   size_t slot);
+
+/**
+ * @memberof CbSymbolTable
+ * @brief    Get the global scope
+ * 
+ * @param self The CbSymbolTable instance
+ */
+const CbScope* cb_symbol_table_get_global_scope(const CbSymbolTable* self);
+
 /**
  * @memberof CbSymbolTable
  * @brief    Enter a new scope
@@ -8,7 +8,7 @@
 struct CbSymbolVariable
 {
     CbSymbol base;
-    CbVariant* value;
+    CbVariant value;
 };
 
 
@@ -24,37 +24,47 @@ static CbVariantType cb_symbol_variable_get_data_type(const CbSymbolVariable* se
 
 CbSymbolVariable* cb_symbol_variable_create(const char* identifier)
 {
-    CbSymbolVariable* self = memalloc(sizeof(CbSymbolVariable));
+    CbSymbolVariable* self = mempool_alloc(sizeof(CbSymbolVariable));
     cb_symbol_init(
         &self->base, CB_SYMBOL_TYPE_VARIABLE, identifier,
         (CbSymbolDestructorFunc)  cb_symbol_variable_destroy,
         (CbSymbolGetDataTypeFunc) cb_symbol_variable_get_data_type
     );
-    self->value = cb_variant_create();
+    self->value = cb_variant_make();
     
     return self;
 }
 
 void cb_symbol_variable_destroy(CbSymbolVariable* self)
 {
-    cb_variant_destroy(self->value);
-    memfree(self);
+    cb_variant_release(&self->value);
+    mempool_free(self, sizeof(CbSymbolVariable));
 }
 
 void cb_symbol_variable_assign(CbSymbolVariable* self, const CbVariant* value)
 {
-    /*
-     * TODO: Implement cb_variant_assign(...) to avoid free()-ing and allocating
-     *       a new CbVariant object each time.
-     */
+    cb_variant_assign(&self->value, value);
+}
+
+void cb_symbol_variable_move(CbSymbolVariable* self, CbVariant* value)
+{
+    cb_variant_move(&self->value, value);
+}
+
+bool cb_symbol_variable_append(CbSymbolVariable* self, const CbVariant* value)
+{
+    bool result = cb_variant_is_string(&self->value) &&
+                  cb_variant_is_string(value);
+    
+    if (result)
+        cb_string_concat(&self->value, value);
     
-    cb_variant_destroy(self->value);
-    self->value = cb_variant_copy(value);
+    return result;
 }
 
 const CbVariant* cb_symbol_variable_get_value(const CbSymbolVariable* self)
 {
-    return self->value;
+    return &self->value;
 }
 
 
@@ -62,5 +72,5 @@ const CbVariant* cb_symbol_variable_get_value(const CbSymbolVariable* self)
 
 static CbVariantType cb_symbol_variable_get_data_type(const CbSymbolVariable* self)
 {
-    return cb_variant_get_type(self->value);
+    return cb_variant_get_type(&self->value);
 }
@@ -21,6 +21,7 @@ typedef struct CbSymbolVariable CbSymbolVariable;
 
 /*
  * Create a CbSymbolVariable object.
+ * NOTE: The identifier must be interned (see cb_intern()).
  */
 CbSymbolVariable* cb_symbol_variable_create(const char* identifier);
 
@@ -34,6 +35,18 @@ void cb_symbol_variable_destroy(CbSymbolVariable* self);
  */
 void cb_symbol_variable_assign(CbSymbolVariable* self, const CbVariant* value);
 
+/*
+ * Move a value into a variable (value becomes undefined).
+ */
+void cb_symbol_variable_move(CbSymbolVariable* self, CbVariant* value);
+
+/*
+ * Append a string to the value of a variable in place.
+ * Returns false, if either the value of the variable or the appended value is
+ * not a string (the variable is not changed in this case).
+ */
+bool cb_symbol_variable_append(CbSymbolVariable* self, const CbVariant* value);
+
 /*
  * Get the current value.
  */
@@ -4,10 +4,87 @@
 #include <math.h>
 #include <float.h>
 #include <errno.h>
+#include <pthread.h>
 
+#include "cb_utils.h"
 #include "utils.h"
 
 
+/* -------------------------------------------------------------------------- */
+
+#define MEMPOOL_CLASS_COUNT 8 /* size classes of 16, 32, ..., 128 bytes */
+
+static const size_t MEMPOOL_GRANULARITY = 16;
+static const size_t MEMPOOL_SLAB_SIZE   = 16384;
+
+typedef struct MemPoolBlock MemPoolBlock;
+struct MemPoolBlock
+{
+    MemPoolBlock* next;
+};
+
+/*
+ * Slabs are never returned to the system. They are linked in a global list
+ * instead, so they stay reachable after the thread, that allocated them,
+ * terminated. The blocks of a terminated thread are handed over to the global
+ * orphan pools, which are adopted by the next thread, that needs to grow its
+ * pool (see mempool_release_thread()). The header is as large as the
+ * granularity to keep blocks aligned.
+ */
+typedef union MemPoolSlab MemPoolSlab;
+union MemPoolSlab
+{
+    MemPoolSlab* next;
+    char alignment[16];
+};
+
+typedef struct MemPoolClass
+{
+    MemPoolBlock* free; /* freelist of blocks                  */
+    char* next;         /* next unused block of the last slab  */
+    char* end;          /* end of the last slab                */
+} MemPoolClass;
+
+#ifndef NO_MEMPOOL
+static CB_THREAD_LOCAL MemPoolClass mempool_classes[MEMPOOL_CLASS_COUNT];
+#endif
+static CB_THREAD_LOCAL MemPoolStats mempool_stats;
+static CB_THREAD_LOCAL bool mempool_registered = false;
+
+/* shared by all threads (protected by mempool_slabs_lock) */
+static MemPoolSlab* mempool_slabs         = NULL;
+static size_t mempool_slab_count          = 0;
+static MemPoolBlock* mempool_orphans[MEMPOOL_CLASS_COUNT];
+static pthread_mutex_t mempool_slabs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* calls mempool_release_thread(), when a thread terminates */
+static pthread_key_t mempool_thread_key;
+static pthread_once_t mempool_thread_key_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Get the pool of the calling thread for blocks of the given size.
+ * Returns NULL, if blocks of this size are allocated with memalloc().
+ */
+static MemPoolClass* mempool_get_class(size_t size);
+
+/*
+ * Refill the given pool, if it has no free block of block_size bytes left:
+ * Adopt the orphaned blocks of its size class or allocate a new slab.
+ */
+static void mempool_refill(MemPoolClass* pool, size_t block_size);
+
+/*
+ * Hand the blocks of a terminating thread over to the orphan pools
+ * (destructor of mempool_thread_key).
+ */
+static void mempool_release_thread(void* classes);
+
+/*
+ * Create mempool_thread_key (once).
+ */
+static void mempool_create_thread_key();
+
+
 /* -------------------------------------------------------------------------- */
 
 void memclr(void* memory, size_t length)
@@ -44,6 +121,77 @@ void* memrealloc(void* memory, size_t size)
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+void* mempool_alloc(size_t size)
+{
+    void* memory;
+    MemPoolClass* pool = mempool_get_class(size);
+    size_t block_size  = (size + MEMPOOL_GRANULARITY - 1) /
+                         MEMPOOL_GRANULARITY * MEMPOOL_GRANULARITY;
+    
+    mempool_stats.allocations++;
+    
+    if (pool != NULL)
+        mempool_refill(pool, block_size);
+    
+    if (pool != NULL && pool->free != NULL)
+    {
+        /* reuse a block, that was freed before */
+        memory     = pool->free;
+        pool->free = pool->free->next;
+    }
+    else if (pool != NULL)
+    {
+        memory      = pool->next;
+        pool->next += block_size;
+    }
+    else
+    {
+        mempool_stats.system_allocations++;
+        memory = memalloc(size);
+    }
+    
+    return memory;
+}
+
+void mempool_free(void* memory, size_t size)
+{
+    MemPoolBlock* block;
+    MemPoolClass* pool = mempool_get_class(size);
+    
+    if (memory == NULL)
+        return;
+    
+    mempool_stats.frees++;
+    
+    if (pool != NULL)
+    {
+        block       = (MemPoolBlock*) memory;
+        block->next = pool->free;
+        pool->free  = block;
+    }
+    else
+        memfree(memory);
+}
+
+MemPoolStats mempool_get_stats()
+{
+    return mempool_stats;
+}
+
+size_t mempool_get_slab_count()
+{
+    size_t count;
+    
+    pthread_mutex_lock(&mempool_slabs_lock);
+    count = mempool_slab_count;
+    pthread_mutex_unlock(&mempool_slabs_lock);
+    
+    return count;
+}
+
+
 /* -------------------------------------------------------------------------- */
 
 bool strequ(const char* str1, const char* str2)
@@ -121,3 +269,119 @@ char* strdup(const char* s)
     return p;
 }
 #endif /* __STDC__ */
+
+
+/* -------------------------------------------------------------------------- */
+
+static MemPoolClass* mempool_get_class(size_t size)
+{
+    MemPoolClass* pool = NULL;
+    
+#ifndef NO_MEMPOOL
+    if (size > 0 && size <= MEMPOOL_CLASS_COUNT * MEMPOOL_GRANULARITY)
+        pool = &mempool_classes[(size - 1) / MEMPOOL_GRANULARITY];
+#endif
+    
+    return pool;
+}
+
+static void mempool_refill(MemPoolClass* pool, size_t block_size)
+{
+    MemPoolSlab* slab;
+    MemPoolBlock* last;
+    size_t count;
+    size_t index = (block_size - 1) / MEMPOOL_GRANULARITY;
+    
+    if (pool->free != NULL ||
+        (pool->next != NULL && (size_t) (pool->end - pool->next) >= block_size))
+        return;
+    
+    /* make sure the blocks of this thread are not lost, once it terminates */
+    if (!mempool_registered)
+    {
+        pthread_once(&mempool_thread_key_once, mempool_create_thread_key);
+        pthread_setspecific(mempool_thread_key, pool - index);
+        mempool_registered = true;
+    }
+    
+    /*
+     * Adopt at most a slab worth of orphaned blocks, so that other threads
+     * find orphaned blocks as well.
+     */
+    pthread_mutex_lock(&mempool_slabs_lock);
+    pool->free = mempool_orphans[index];
+    last       = NULL;
+    for (count = 0; count < MEMPOOL_SLAB_SIZE / block_size &&
+                    mempool_orphans[index] != NULL; count++)
+    {
+        last                   = mempool_orphans[index];
+        mempool_orphans[index] = last->next;
+    }
+    if (last != NULL)
+        last->next = NULL;
+    pthread_mutex_unlock(&mempool_slabs_lock);
+    
+    if (pool->free != NULL)
+        return;
+    
+    slab = memalloc(MEMPOOL_SLAB_SIZE);
+    mempool_stats.system_allocations++;
+    
+    pthread_mutex_lock(&mempool_slabs_lock);
+    slab->next    = mempool_slabs;
+    mempool_slabs = slab;
+    mempool_slab_count++;
+    pthread_mutex_unlock(&mempool_slabs_lock);
+    
+    /* the remainder of the former slab is too small for a block */
+    pool->next = (char*) (slab + 1);
+    pool->end  = (char*) slab + MEMPOOL_SLAB_SIZE;
+}
+
+static void mempool_release_thread(void* classes)
+{
+    size_t i;
+    size_t block_size;
+    MemPoolBlock* block;
+    MemPoolClass* pool;
+    
+    pthread_mutex_lock(&mempool_slabs_lock);
+    for (i = 0; i < MEMPOOL_CLASS_COUNT; i++)
+    {
+        pool       = &((MemPoolClass*) classes)[i];
+        block_size = (i + 1) * MEMPOOL_GRANULARITY;
+        
+        /* the unused remainder of the last slab is split into blocks */
+        while (pool->next != NULL &&
+               (size_t) (pool->end - pool->next) >= block_size)
+        {
+            block       = (MemPoolBlock*) pool->next;
+            block->next = pool->free;
+            pool->free  = block;
+            pool->next += block_size;
+        }
+        
+        if (pool->free != NULL)
+        {
+            block = pool->free;
+            while (block->next != NULL)
+                block = block->next;
+            block->next        = mempool_orphans[i];
+            mempool_orphans[i] = pool->free;
+        }
+        
+        memclr(pool, sizeof(MemPoolClass));
+    }
+    pthread_mutex_unlock(&mempool_slabs_lock);
+    
+    /*
+     * The destructor runs in the terminating thread: If a later destructor
+     * allocates again, the pools have to be registered again.
+     */
+    mempool_registered = false;
+}
+
+static void mempool_create_thread_key()
+{
+    pthread_key_create(&mempool_thread_key, mempool_release_thread);
+}
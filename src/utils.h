@@ -39,6 +39,51 @@ void memfree(void* memory);
 void* memrealloc(void* memory, size_t size);
 
 
+/* -------------------------------------------------------------------------- */
+/* Pool allocator */
+
+/*
+ * Allocation counters of the pool allocator (per thread)
+ */
+typedef struct MemPoolStats
+{
+    size_t allocations;        /* calls of mempool_alloc()                 */
+    size_t frees;              /* calls of mempool_free()                  */
+    size_t system_allocations; /* blocks allocated with memalloc() instead */
+} MemPoolStats;
+
+/*
+ * Allocate a small block of memory of a fixed size (e.g. an object).
+ * Blocks are carved from slabs of blocks of the same size class and recycled
+ * through a thread local freelist, instead of being returned to the system.
+ * Larger blocks are allocated with memalloc().
+ * The pools back the boxed variants (cb_variant_box()) and the variable
+ * symbols (CbSymbolVariable).
+ * NOTE: Defining NO_MEMPOOL at build time disables the pools (e.g. to check for
+ *       memory errors with valgrind): All blocks are allocated with memalloc()
+ *       then.
+ */
+void* mempool_alloc(size_t size);
+
+/*
+ * Return a block of memory to the pool (of the calling thread).
+ * NOTE: The size must be the same as passed to mempool_alloc().
+ */
+void mempool_free(void* memory, size_t size);
+
+/*
+ * Get the allocation counters of the calling thread.
+ */
+MemPoolStats mempool_get_stats();
+
+/*
+ * Get the number of slabs allocated by all threads so far.
+ * NOTE: The blocks of terminated threads are reused by other threads, so this
+ *       number does not grow, if threads are started over and over again.
+ */
+size_t mempool_get_slab_count();
+
+
 /* -------------------------------------------------------------------------- */
 /* String functions */
 
@@ -7,19 +7,6 @@
 
 /* -------------------------------------------------------------------------- */
 
-struct CbVariant
-{
-    CbVariantType type;
-    
-    union
-    {
-        CbIntegerDataType integer;
-        CbFloatDataType   decimal;
-        CbBooleanDataType boolean;
-        CbStringDataType  string;
-    } v;
-};
-
 static const char* const CB_VARIANT_TYPE_STRINGS[] = {
     "undefined", /* CB_VARIANT_TYPE_UNDEFINED */
     "integer",   /* CB_VARIANT_TYPE_INTEGER   */
@@ -38,6 +25,89 @@ static const char* const CB_UNARY_OPERATOR_TYPE_STRINGS[] = {
     "not"  /* CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT */
 };
 
+/*
+ * The characters of a string value, that is not stored inline, are preceded by
+ * a header, that stores the length of the string and the capacity of its buffer
+ * (the terminating NUL character is not included in either). The variant points
+ * to the characters, so they can be used as a plain C string.
+ * The hash of the characters is kept up to date on every change, so it is
+ * available for comparisons without another pass over the string. Inline
+ * strings are short enough to hash them on demand.
+ * Heap buffers are reference counted and shared between copies of a string
+ * (copy-on-write): A buffer is only modified in place, if a single variant
+ * refers to it. Otherwise it is copied before the modification.
+ */
+typedef struct CbStringHeader
+{
+    size_t length;
+    size_t capacity;
+    unsigned long long hash;    /* 64 bit FNV-1a hash of the characters */
+    long references;            /* number of variants sharing the buffer
+                                   (accessed atomically)                */
+    bool borrowed;              /* the buffer is owned by someone else  */
+} CbStringHeader;
+
+static const unsigned long long CB_STRING_HASH_OFFSET = 14695981039346656037ULL;
+static const unsigned long long CB_STRING_HASH_PRIME  = 1099511628211ULL;
+
+/*
+ * Get the header of a string value (NOTE: The string must not be inline.)
+ */
+static CbStringHeader* cb_string_get_header(const CbVariant* self);
+
+/*
+ * Constructor (String, by value, inline)
+ */
+static CbVariant cb_string_make_inline(const char* characters, size_t length);
+
+/*
+ * Check if the variant holds a reference to a heap allocated string buffer
+ * (i.e. the string is neither inline nor borrowed)
+ */
+static bool cb_string_is_owned(const CbVariant* self);
+
+/*
+ * Check if the variant is the only owner of its string buffer, which means the
+ * buffer can be modified in place
+ */
+static bool cb_string_is_unique(const CbVariant* self);
+
+/*
+ * Drop the reference of the variant to its string buffer and free the buffer,
+ * if it was the last reference
+ */
+static void cb_string_unref(CbVariant* self);
+
+/*
+ * Get the number of characters, that fit into the buffer of a string
+ */
+static size_t cb_string_get_capacity(const CbVariant* self);
+
+/*
+ * Get the 64 bit hash of a string (inline strings are hashed on demand)
+ */
+static unsigned long long cb_string_get_full_hash(const CbVariant* self);
+
+/*
+ * Allocate a string buffer with the given capacity.
+ * Returns a pointer to its characters (the length is set to 0).
+ */
+static char* cb_string_alloc(size_t capacity);
+
+/*
+ * Make sure the variant is the only owner of a heap allocated string buffer
+ * with at least the given capacity (inline, borrowed and shared strings are
+ * copied into a new buffer).
+ */
+static void cb_string_reserve(CbVariant* self, size_t capacity);
+
+/*
+ * Continue a FNV-1a hash with the given characters
+ */
+static unsigned long long cb_string_hash_update(unsigned long long hash,
+                                                const char* characters,
+                                                size_t length);
+
 static const char* CB_BINARY_OPERATOR_TYPE_STRINGS[] = {
     "+",   /* CB_BINARY_OPERATOR_TYPE_ADD           */
     "-",   /* CB_BINARY_OPERATOR_TYPE_SUB           */
@@ -172,66 +242,26 @@ bool cb_variant_type_is_binary_operation_valid(const CbBinaryOperatorType operat
 
 CbVariant* cb_variant_create()
 {
-    CbVariant* self = (CbVariant*) memalloc(sizeof(CbVariant));
-    self->type      = CB_VARIANT_TYPE_UNDEFINED;
-    
-    return self;
+    return cb_variant_box(cb_variant_make());
 }
 
 void cb_variant_destroy(CbVariant* self)
 {
-    switch (self->type)
-    {
-        case CB_VARIANT_TYPE_FLOAT:
-        case CB_VARIANT_TYPE_INTEGER:
-        case CB_VARIANT_TYPE_BOOLEAN:
-            /* TODO: currently there is no action requiered */
-            break;
-        
-        case CB_VARIANT_TYPE_STRING:
-            memfree(self->v.string); break;
-        
-        case CB_VARIANT_TYPE_UNDEFINED:
-            /* undefined variant does not requiere any additional action */
-            break;
-        
-        /* invalid variant type */
-        default: cb_abort("Invalid variant type"); break;
-    }
-    
-    memfree(self);
+    cb_variant_release(self);
+    mempool_free(self, sizeof(CbVariant));
 }
 
 CbVariant* cb_variant_copy(const CbVariant* variant)
 {
-    CbVariant* copy = NULL;
-    
-    cb_assert(cb_variant_type_is_valid(variant->type));
-    
-    copy       = cb_variant_create();
-    copy->type = variant->type;
-    
-    switch (variant->type)
-    {
-        case CB_VARIANT_TYPE_INTEGER:
-            copy->v.integer = variant->v.integer; break;
-        
-        case CB_VARIANT_TYPE_FLOAT:
-            copy->v.decimal = variant->v.decimal; break;
-        
-        case CB_VARIANT_TYPE_BOOLEAN:
-            copy->v.boolean = variant->v.boolean; break;
-        
-        case CB_VARIANT_TYPE_STRING:
-            copy->v.string = strdup(variant->v.string); break;
-        
-        /* No action requiered -> break */
-        case CB_VARIANT_TYPE_UNDEFINED: break;
-        
-        default: cb_abort("Invalid variant type"); break;
-    }
+    return cb_variant_box(cb_variant_clone(variant));
+}
+
+CbVariant* cb_variant_box(CbVariant value)
+{
+    CbVariant* self = (CbVariant*) mempool_alloc(sizeof(CbVariant));
+    *self           = value;
     
-    return copy;
+    return self;
 }
 
 CbVariantType cb_variant_get_type(const CbVariant* self)
@@ -271,8 +301,9 @@ char* cb_variant_to_string(const CbVariant* self)
             break;
         
         case CB_VARIANT_TYPE_STRING:
-            result = memalloc(strlen(self->v.string) + 1);
-            sprintf(result, "%s", self->v.string);
+            result = memalloc(cb_string_get_length(self) + 1);
+            memcpy(result, cb_string_get_value(self),
+                   cb_string_get_length(self) + 1);
             break;
         
         default: cb_abort("Invalid variant type"); break;
@@ -327,6 +358,218 @@ bool cb_variant_is_string(const CbVariant* self)
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+CbVariant cb_variant_make()
+{
+    CbVariant self;
+    self.type = CB_VARIANT_TYPE_UNDEFINED;
+    
+    return self;
+}
+
+CbVariant cb_variant_clone(const CbVariant* variant)
+{
+    CbVariant copy;
+    
+    cb_assert(cb_variant_type_is_valid(variant->type));
+    
+    switch (variant->type)
+    {
+        case CB_VARIANT_TYPE_STRING:
+            if (cb_string_get_length(variant) <= CB_STRING_INLINE_CAPACITY)
+            {
+                /* short strings are copied without any allocation */
+                copy = cb_string_make_inline(cb_string_get_value(variant),
+                                             cb_string_get_length(variant));
+            }
+            else if (cb_string_is_owned(variant))
+            {
+                /* long strings share their buffer until either is modified */
+                cb_atomic_increment(&cb_string_get_header(variant)->references);
+                copy = *variant;
+            }
+            else
+            {
+                copy.type          = CB_VARIANT_TYPE_STRING;
+                copy.inline_string = false;
+                copy.v.string      = cb_string_alloc(
+                    cb_string_get_length(variant)
+                );
+                cb_string_get_header(&copy)->length =
+                    cb_string_get_length(variant);
+                cb_string_get_header(&copy)->hash   =
+                    cb_string_get_header(variant)->hash;
+                memcpy(copy.v.string, variant->v.string,
+                       cb_string_get_length(variant) + 1);
+            }
+            break;
+        
+        case CB_VARIANT_TYPE_INTEGER:
+        case CB_VARIANT_TYPE_FLOAT:
+        case CB_VARIANT_TYPE_BOOLEAN:
+        case CB_VARIANT_TYPE_UNDEFINED:
+            /* no payload -> plain copy */
+            copy = *variant;
+            break;
+        
+        default: cb_abort("Invalid variant type"); break;
+    }
+    
+    return copy;
+}
+
+void cb_variant_release(CbVariant* self)
+{
+    switch (self->type)
+    {
+        case CB_VARIANT_TYPE_FLOAT:
+        case CB_VARIANT_TYPE_INTEGER:
+        case CB_VARIANT_TYPE_BOOLEAN:
+            /* TODO: currently there is no action requiered */
+            break;
+        
+        case CB_VARIANT_TYPE_STRING:
+            if (cb_string_is_owned(self))
+                cb_string_unref(self);
+            break;
+        
+        case CB_VARIANT_TYPE_UNDEFINED:
+            /* undefined variant does not requiere any additional action */
+            break;
+        
+        /* invalid variant type */
+        default: cb_abort("Invalid variant type"); break;
+    }
+    
+    self->type = CB_VARIANT_TYPE_UNDEFINED;
+}
+
+void cb_variant_assign(CbVariant* self, const CbVariant* value)
+{
+    size_t length;
+    
+    if (self == value)
+        return;
+    
+    /*
+     * Strings, that cannot be shared, are copied into the buffer of the variant
+     * (if it is not shared itself). Others are shared by cloning them.
+     */
+    if (cb_variant_is_string(self) && cb_string_is_unique(self) &&
+        cb_variant_is_string(value) && !cb_string_is_owned(value))
+    {
+        length = cb_string_get_length(value);
+        cb_string_reserve(self, length);
+        memcpy(self->v.string, cb_string_get_value(value), length + 1);
+        cb_string_get_header(self)->length = length;
+        cb_string_get_header(self)->hash   = cb_string_get_full_hash(value);
+    }
+    else
+    {
+        cb_variant_release(self);
+        *self = cb_variant_clone(value);
+    }
+}
+
+void cb_variant_move(CbVariant* self, CbVariant* value)
+{
+    if (self == value)
+        return;
+    
+    cb_variant_release(self);
+    *self  = *value;
+    *value = cb_variant_make();
+}
+
+CbVariant cb_integer_make(const CbIntegerDataType value)
+{
+    CbVariant self;
+    self.type      = CB_VARIANT_TYPE_INTEGER;
+    self.v.integer = value;
+    
+    return self;
+}
+
+CbVariant cb_float_make(const CbFloatDataType value)
+{
+    CbVariant self;
+    self.type      = CB_VARIANT_TYPE_FLOAT;
+    self.v.decimal = value;
+    
+    return self;
+}
+
+CbVariant cb_boolean_make(const CbBooleanDataType value)
+{
+    CbVariant self;
+    self.type      = CB_VARIANT_TYPE_BOOLEAN;
+    self.v.boolean = value;
+    
+    return self;
+}
+
+CbVariant cb_string_make(CbConstStringDataType value)
+{
+    CbVariant self;
+    size_t length = strlen(value);
+    
+    if (length <= CB_STRING_INLINE_CAPACITY)
+    {
+        self = cb_string_make_inline(value, length);
+    }
+    else
+    {
+        self.type          = CB_VARIANT_TYPE_STRING;
+        self.inline_string = false;
+        self.v.string      = cb_string_alloc(length);
+        memcpy(self.v.string, value, length + 1);
+        cb_string_get_header(&self)->length = length;
+        cb_string_get_header(&self)->hash   = cb_string_hash_update(
+            CB_STRING_HASH_OFFSET, value, length
+        );
+    }
+    
+    return self;
+}
+
+CbVariant cb_string_make_borrowed(void* storage,
+                                  CbConstStringDataType value,
+                                  size_t length)
+{
+    CbVariant self;
+    CbStringHeader* header = (CbStringHeader*) storage;
+    
+    if (length <= CB_STRING_INLINE_CAPACITY)
+    {
+        /* short strings do not need any storage */
+        self = cb_string_make_inline(value, length);
+    }
+    else
+    {
+        header->length   = length;
+        header->capacity = length;
+        header->hash     = cb_string_hash_update(CB_STRING_HASH_OFFSET, value,
+                                                 length);
+        header->borrowed = true;
+        
+        self.type          = CB_VARIANT_TYPE_STRING;
+        self.inline_string = false;
+        self.v.string      = (char*) (header + 1);
+        memcpy(self.v.string, value, length);
+        self.v.string[length] = '\0';
+    }
+    
+    return self;
+}
+
+size_t cb_string_get_storage_size(size_t length)
+{
+    return length <= CB_STRING_INLINE_CAPACITY ?
+           0 : sizeof(CbStringHeader) + length + 1;
+}
+
+
 /* -------------------------------------------------------------------------- */
 
 CbIntegerDataType cb_numeric_as_integer(const CbVariant* self)
@@ -360,11 +603,7 @@ CbFloatDataType cb_numeric_as_float(const CbVariant* self)
 
 CbVariant* cb_integer_create(const CbIntegerDataType value)
 {
-    CbVariant* self = cb_variant_create();
-    self->type      = CB_VARIANT_TYPE_INTEGER;
-    self->v.integer = value;
-    
-    return self;
+    return cb_variant_box(cb_integer_make(value));
 }
 
 CbIntegerDataType cb_integer_get_value(const CbVariant* self)
@@ -379,11 +618,7 @@ CbIntegerDataType cb_integer_get_value(const CbVariant* self)
 
 CbVariant* cb_float_create(const CbFloatDataType value)
 {
-    CbVariant* self = cb_variant_create();
-    self->type      = CB_VARIANT_TYPE_FLOAT;
-    self->v.decimal = value;
-    
-    return self;
+    return cb_variant_box(cb_float_make(value));
 }
 
 CbFloatDataType cb_float_get_value(const CbVariant* self)
@@ -398,11 +633,7 @@ CbFloatDataType cb_float_get_value(const CbVariant* self)
 
 CbVariant* cb_boolean_create(const CbBooleanDataType value)
 {
-    CbVariant* self = cb_variant_create();
-    self->type      = CB_VARIANT_TYPE_BOOLEAN;
-    self->v.boolean = value;
-    
-    return self;
+    return cb_variant_box(cb_boolean_make(value));
 }
 
 CbFloatDataType cb_boolean_get_value(const CbVariant* self)
@@ -417,49 +648,220 @@ CbFloatDataType cb_boolean_get_value(const CbVariant* self)
 
 CbVariant* cb_string_create(CbConstStringDataType value)
 {
-    CbVariant* self = cb_variant_create();
-    self->type      = CB_VARIANT_TYPE_STRING;
-    self->v.string  = strdup(value);
-    
-    return self;
+    return cb_variant_box(cb_string_make(value));
 }
 
 CbConstStringDataType cb_string_get_value(const CbVariant* self)
 {
     cb_assert(cb_variant_is_string(self));
     
-    return self->v.string;
+    return self->inline_string ? self->v.characters : self->v.string;
 }
 
-void cb_string_concat(CbVariant* self, const CbVariant* source)
+size_t cb_string_get_length(const CbVariant* self)
 {
-    char* buffer;
+    cb_assert(cb_variant_is_string(self));
     
-    CbConstStringDataType v1 = cb_string_get_value(self);
-    CbConstStringDataType v2 = cb_string_get_value(source);
+    return self->inline_string ? self->inline_length :
+                                 cb_string_get_header(self)->length;
+}
+
+void cb_string_concat(CbVariant* self, const CbVariant* source)
+{
+    size_t capacity;
+    CbStringHeader* header;
+    size_t length        = cb_string_get_length(self);
+    size_t source_length = cb_string_get_length(source);
     
-    buffer = memalloc(strlen(v1) + strlen(v2) + 1);
-    strcpy(buffer, v1);
-    strcat(buffer, v2);
+    if (self->inline_string &&
+        length + source_length <= CB_STRING_INLINE_CAPACITY)
+    {
+        /* NOTE: source might be self, so the characters are moved */
+        memmove(self->v.characters + length, cb_string_get_value(source),
+                source_length + 1);
+        self->inline_length = (unsigned char) (length + source_length);
+    }
+    else
+    {
+        /*
+         * The capacity grows geometrically, so appending to the same string
+         * over and over again takes amortized constant time per character.
+         */
+        if (!cb_string_is_unique(self) ||
+            cb_string_get_capacity(self) < length + source_length)
+        {
+            capacity = 2 * cb_string_get_capacity(self);
+            if (capacity < length + source_length)
+                capacity = length + source_length;
+            cb_string_reserve(self, capacity);
+        }
+        
+        /* NOTE: source might be self, so it is accessed after reallocating */
+        memmove(self->v.string + length, cb_string_get_value(source),
+                source_length + 1);
+        header         = cb_string_get_header(self);
+        header->length = length + source_length;
+        header->hash   = cb_string_hash_update(header->hash,
+                                               self->v.string + length,
+                                               source_length);
+    }
+}
+
+size_t cb_string_get_hash(const CbVariant* self)
+{
+    cb_assert(cb_variant_is_string(self));
     
-    memfree(self->v.string); /* free old string            */
-    self->v.string = buffer; /* assign concatenated string */
+    return (size_t) cb_string_get_full_hash(self);
 }
 
 CbBooleanDataType cb_string_equal(const CbVariant* lhs, const CbVariant* rhs)
 {
-    return strequ(cb_string_get_value(lhs), cb_string_get_value(rhs));
+    size_t length = cb_string_get_length(lhs);
+    
+    cb_assert(cb_variant_is_string(lhs) && cb_variant_is_string(rhs));
+    
+    /*
+     * Strings of different length or hash are never equal (only the hashes of
+     * long strings are cached, short strings are compared right away).
+     */
+    if (length != cb_string_get_length(rhs))
+        return false;
+    else if (!lhs->inline_string && !rhs->inline_string &&
+             cb_string_get_header(lhs)->hash != cb_string_get_header(rhs)->hash)
+        return false;
+    else
+        return memcmp(cb_string_get_value(lhs), cb_string_get_value(rhs),
+                      length) == 0;
 }
 
 CbBooleanDataType cb_string_lhs_equal(const CbVariant* lhs, const CbVariant* rhs)
 {
-    CbConstStringDataType lhs_string = cb_string_get_value(lhs);
-    CbConstStringDataType rhs_string = cb_string_get_value(rhs);
-    size_t lhs_length                = strlen(lhs_string);
-    size_t rhs_length                = strlen(rhs_string);
+    size_t lhs_length = cb_string_get_length(lhs);
+    size_t rhs_length = cb_string_get_length(rhs);
     
+    /* the left string must be a prefix of the right one */
     if (lhs_length > rhs_length)
         return false;
+    else if (lhs_length == rhs_length)
+        return cb_string_equal(lhs, rhs);
     else
-        return strnequ(lhs_string, rhs_string, lhs_length);
+        return memcmp(cb_string_get_value(lhs), cb_string_get_value(rhs),
+                      lhs_length) == 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static CbStringHeader* cb_string_get_header(const CbVariant* self)
+{
+    cb_assert(!self->inline_string);
+    
+    return ((CbStringHeader*) self->v.string) - 1;
+}
+
+static CbVariant cb_string_make_inline(const char* characters, size_t length)
+{
+    CbVariant self;
+    
+    cb_assert(length <= CB_STRING_INLINE_CAPACITY);
+    
+    self.type          = CB_VARIANT_TYPE_STRING;
+    self.inline_string = true;
+    self.inline_length = (unsigned char) length;
+    memcpy(self.v.characters, characters, length);
+    self.v.characters[length] = '\0';
+    
+    return self;
+}
+
+static bool cb_string_is_owned(const CbVariant* self)
+{
+    return !self->inline_string && !cb_string_get_header(self)->borrowed;
+}
+
+static bool cb_string_is_unique(const CbVariant* self)
+{
+    return cb_string_is_owned(self) &&
+           cb_atomic_load(&cb_string_get_header(self)->references) == 1;
+}
+
+static void cb_string_unref(CbVariant* self)
+{
+    CbStringHeader* header = cb_string_get_header(self);
+    
+    if (cb_atomic_decrement(&header->references) == 0)
+        memfree(header);
+}
+
+static size_t cb_string_get_capacity(const CbVariant* self)
+{
+    return self->inline_string ? CB_STRING_INLINE_CAPACITY :
+                                 cb_string_get_header(self)->capacity;
+}
+
+static unsigned long long cb_string_get_full_hash(const CbVariant* self)
+{
+    return self->inline_string ?
+           cb_string_hash_update(CB_STRING_HASH_OFFSET, self->v.characters,
+                                 self->inline_length) :
+           cb_string_get_header(self)->hash;
+}
+
+static char* cb_string_alloc(size_t capacity)
+{
+    CbStringHeader* header = memalloc(sizeof(CbStringHeader) + capacity + 1);
+    
+    header->length   = 0;
+    header->capacity = capacity;
+    header->hash       = CB_STRING_HASH_OFFSET;
+    header->references = 1;
+    header->borrowed   = false;
+    
+    return (char*) (header + 1);
+}
+
+static void cb_string_reserve(CbVariant* self, size_t capacity)
+{
+    char* buffer;
+    CbStringHeader* header;
+    size_t length = cb_string_get_length(self);
+    
+    if (!cb_string_is_unique(self))
+    {
+        /*
+         * Never modify a borrowed or shared buffer, copy it instead (same for
+         * inline strings).
+         */
+        buffer = cb_string_alloc(capacity > length ? capacity : length);
+        memcpy(buffer, cb_string_get_value(self), length + 1);
+        ((CbStringHeader*) buffer - 1)->length = length;
+        ((CbStringHeader*) buffer - 1)->hash   = cb_string_get_full_hash(self);
+        if (cb_string_is_owned(self))
+            cb_string_unref(self);
+        self->inline_string = false;
+        self->v.string      = buffer;
+    }
+    else if (cb_string_get_capacity(self) < capacity)
+    {
+        header = memrealloc(cb_string_get_header(self),
+                            sizeof(CbStringHeader) + capacity + 1);
+        header->capacity = capacity;
+        self->v.string   = (char*) (header + 1);
+    }
+}
+
+static unsigned long long cb_string_hash_update(unsigned long long hash,
+                                                const char* characters,
+                                                size_t length)
+{
+    size_t i;
+    
+    /* NOTE: Same hash function as cb_hash_table_hash_string(). */
+    for (i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char) characters[i];
+        hash *= CB_STRING_HASH_PRIME;
+    }
+    
+    return hash;
 }
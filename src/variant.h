@@ -7,6 +7,7 @@
 #define VARIANT_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 
 /* -------------------------------------------------------------------------- */
@@ -54,6 +55,33 @@ typedef enum
     CB_BINARY_OPERATOR_TYPE_COMPARISON_NE  /* not equal             */
 } CbBinaryOperatorType;
 
+/* maximum length of a string, that is stored inside of the variant itself */
+#define CB_STRING_INLINE_CAPACITY 15
+
+/*
+ * NOTE: The structure is public, so that variants can be passed and stored by
+ *       value (e.g. during evaluation) without any heap allocation. Only string
+ *       values, that are longer than CB_STRING_INLINE_CAPACITY, own heap
+ *       memory. Shorter strings are stored inline, so copying them never
+ *       allocates. Do not access the members directly, use the functions below
+ *       instead.
+ */
+struct CbVariant
+{
+    CbVariantType type;
+    bool          inline_string; /* string is stored in v.characters */
+    unsigned char inline_length; /* length of an inline string       */
+    
+    union
+    {
+        CbIntegerDataType integer;
+        CbFloatDataType   decimal;
+        CbBooleanDataType boolean;
+        CbStringDataType  string;
+        char              characters[CB_STRING_INLINE_CAPACITY + 1];
+    } v;
+};
+
 
 /* -------------------------------------------------------------------------- */
 
@@ -114,6 +142,13 @@ void cb_variant_destroy(CbVariant* self);
  */
 CbVariant* cb_variant_copy(const CbVariant* variant);
 
+/*
+ * Move a variant value to the heap.
+ * NOTE: The returned object takes ownership of the value (i.e. the string
+ *       payload), so the value must not be released afterwards.
+ */
+CbVariant* cb_variant_box(CbVariant value);
+
 /*
  * Variant type (Getter)
  */
@@ -166,6 +201,80 @@ bool cb_variant_is_boolean(const CbVariant* self);
 bool cb_variant_is_string(const CbVariant* self);
 
 
+/* -------------------------------------------------------------------------- */
+/* variant value functions (no heap allocation except for string payloads) */
+
+/*
+ * Constructor (default, by value)
+ */
+CbVariant cb_variant_make();
+
+/*
+ * Constructor (Copy, by value)
+ * Long strings share their buffer with the copy (reference counted), so copying
+ * them takes constant time. The buffer is copied on the first modification.
+ */
+CbVariant cb_variant_clone(const CbVariant* variant);
+
+/*
+ * Free the payload of a variant value and make it undefined.
+ */
+void cb_variant_release(CbVariant* self);
+
+/*
+ * Assign a copy of a value to a variant in place.
+ * Long strings are shared (see cb_variant_clone()). Other strings are copied
+ * into the string buffer of the variant, if it is not shared (it is only
+ * reallocated, if the new string does not fit into it).
+ * NOTE: The variant must own its payload (i.e. no borrowed string).
+ */
+void cb_variant_assign(CbVariant* self, const CbVariant* value);
+
+/*
+ * Move a value into a variant (the old value of the variant is released).
+ * The variant takes ownership of the payload and value becomes undefined.
+ */
+void cb_variant_move(CbVariant* self, CbVariant* value);
+
+/*
+ * Constructor (Integer, by value)
+ */
+CbVariant cb_integer_make(const CbIntegerDataType value);
+
+/*
+ * Constructor (Float, by value)
+ */
+CbVariant cb_float_make(const CbFloatDataType value);
+
+/*
+ * Constructor (Boolean, by value)
+ */
+CbVariant cb_boolean_make(const CbBooleanDataType value);
+
+/*
+ * Constructor (String, by value)
+ */
+CbVariant cb_string_make(CbConstStringDataType value);
+
+/*
+ * Constructor (String, by value, borrowed)
+ * The string is copied into storage owned by someone else (e.g. an arena),
+ * that holds at least cb_string_get_storage_size(length) bytes (short strings
+ * are stored inline and require no storage, so it might be NULL). The variant
+ * must never be released. Use cb_variant_clone() to get a variant, that owns
+ * its string.
+ */
+CbVariant cb_string_make_borrowed(void* storage,
+                                  CbConstStringDataType value,
+                                  size_t length);
+
+/*
+ * Get the size of the storage required for a string of the given length
+ * (0 for strings, that are stored inline)
+ */
+size_t cb_string_get_storage_size(size_t length);
+
+
 /* -------------------------------------------------------------------------- */
 /* numeric variant type functions */
 
@@ -232,11 +341,24 @@ CbVariant* cb_string_create(CbConstStringDataType value);
 
 /*
  * String value (Getter)
+ * NOTE: Short strings are stored inside of the variant, so the returned
+ *       pointer is invalidated, if the variant is moved or copied by value.
  */
 CbConstStringDataType cb_string_get_value(const CbVariant* self);
 
 /*
- * Compare two strings
+ * Get the length of a string (in bytes, without calling strlen())
+ */
+size_t cb_string_get_length(const CbVariant* self);
+
+/*
+ * Get the hash of a string (cached, equals cb_hash_table_hash_string())
+ */
+size_t cb_string_get_hash(const CbVariant* self);
+
+/*
+ * Compare two strings (strings of different length or hash are rejected
+ * without comparing their characters)
  */
 CbBooleanDataType cb_string_equal(const CbVariant* lhs, const CbVariant* rhs);
 
@@ -246,7 +368,10 @@ CbBooleanDataType cb_string_equal(const CbVariant* lhs, const CbVariant* rhs);
 CbBooleanDataType cb_string_lhs_equal(const CbVariant* lhs, const CbVariant* rhs);
 
 /*
- * Concatenate two strings together
+ * Concatenate two strings together: The source string is appended to the
+ * string in self. The buffer of self is reused, if its capacity allows and it
+ * is not shared, and grows geometrically otherwise (i.e. repeated appends take
+ * amortized constant time per character).
  */
 void cb_string_concat(CbVariant* self, const CbVariant* source);
 
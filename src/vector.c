@@ -7,19 +7,16 @@
 struct Vector
 {
     size_t count;
+    size_t capacity;
     VectorItem* elements;
-    size_t element_size;
-    size_t block_size;
-    size_t alloc_size;
 };
 
-static const int ITEMS_PER_BLOCK = 16;
+static const size_t VECTOR_INITIAL_CAPACITY = 16;
 
 
 /* -------------------------------------------------------------------------- */
 
-static bool vector_is_full(const Vector* self);
-static bool vector_increase_size(Vector* self, unsigned int blocks);
+static bool vector_resize(Vector* self, size_t capacity);
 static bool vector_check_bounds(const Vector* self, int index);
 
 
@@ -27,12 +24,10 @@ static bool vector_check_bounds(const Vector* self, int index);
 
 Vector* vector_create()
 {
-    Vector* self       = memalloc(sizeof(Vector));
-    self->count        = 0;
-    self->element_size = sizeof(VectorItem);
-    self->block_size   = self->element_size * ITEMS_PER_BLOCK;
-    self->elements     = memalloc(self->block_size);
-    self->alloc_size   = self->block_size;
+    Vector* self   = memalloc(sizeof(Vector));
+    self->count    = 0;
+    self->capacity = VECTOR_INITIAL_CAPACITY;
+    self->elements = memalloc(self->capacity * sizeof(VectorItem));
     
     return self;
 }
@@ -43,43 +38,80 @@ void vector_destroy(Vector* self)
     memfree(self);
 }
 
+bool vector_reserve(Vector* self, size_t capacity)
+{
+    if (self->capacity >= capacity)
+        return true;
+    
+    return vector_resize(self, capacity);
+}
+
+void vector_shrink_to_fit(Vector* self)
+{
+    /* keep at least one item, since reallocating 0 bytes might free memory */
+    vector_resize(self, self->count > 0 ? self->count : 1);
+}
+
 int vector_append(Vector* self, VectorItem item)
 {
-    int index;
+    /*
+     * The capacity grows geometrically, so appending an item takes amortized
+     * constant time.
+     */
+    if (self->count == self->capacity &&
+        !vector_resize(self, 2 * self->capacity))
+        return -1;
     
-    if (vector_is_full(self))
-        vector_increase_size(self, 1);
+    self->elements[self->count] = item;
     
-    self->count++;
-    index = self->count - 1;      /* index is the last item */
-    self->elements[index] = NULL; /* clear allocated memory (TODO: remove!) */
+    return self->count++;
+}
+
+bool vector_extend(Vector* self, const VectorItem* items, size_t count)
+{
+    size_t capacity = self->capacity;
     
-    if (vector_set(self, index, item))
-        return index;
-    else
-        return -1;
+    while (capacity < self->count + count)
+        capacity *= 2;
+    
+    if (!vector_reserve(self, capacity))
+        return false;
+    
+    memcpy(self->elements + self->count, items, count * sizeof(VectorItem));
+    self->count += count;
+    
+    return true;
 }
 
 VectorItem vector_remove(Vector* self, int index)
 {
     VectorItem removed_item;
-    VectorItem source;
-    VectorItem destination;
-    size_t size;
     
-    /*
-     * TODO: Check bounds, when accessing elements via index.
-     */
+    if (!vector_check_bounds(self, index))
+        return NULL;
+    
     removed_item = self->elements[index];
-    if (!vector_set(self, index, NULL))
+    
+    /* move the following items one slot ahead to keep their order */
+    memmove(self->elements + index, self->elements + index + 1,
+            (self->count - (index + 1)) * sizeof(VectorItem));
+    self->count--;
+    
+    return removed_item;
+}
+
+VectorItem vector_swap_remove(Vector* self, int index)
+{
+    VectorItem removed_item;
+    
+    if (!vector_check_bounds(self, index))
         return NULL;
     
-    source      = self->elements + index + 1;
-    destination = self->elements + index;
-    size        = (self->count - (index + 1)) * self->element_size;
-    memmove(destination, source, size);
+    removed_item = self->elements[index];
     
+    /* the last item takes the place of the removed one */
     self->count--;
+    self->elements[index] = self->elements[self->count];
     
     return removed_item;
 }
@@ -87,7 +119,6 @@ VectorItem vector_remove(Vector* self, int index)
 void vector_clear(Vector* self)
 {
     self->count = 0;
-    memclr(self->elements, self->alloc_size);
 }
 
 bool vector_get(const Vector* self, int index, VectorItem* destination)
@@ -113,28 +144,28 @@ size_t vector_get_count(const Vector* self)
     return self->count;
 }
 
-
-/* -------------------------------------------------------------------------- */
-
-static bool vector_is_full(const Vector* self)
+size_t vector_get_capacity(const Vector* self)
 {
-    return ((self->count * self->element_size) >= self->alloc_size);
+    return self->capacity;
 }
 
-static bool vector_increase_size(Vector* self, unsigned int blocks)
+
+/* -------------------------------------------------------------------------- */
+
+static bool vector_resize(Vector* self, size_t capacity)
 {
-    size_t new_size  = self->alloc_size + (self->block_size * blocks);
-    VectorItem* temp = memrealloc(self->elements, new_size);
+    VectorItem* temp = memrealloc(self->elements,
+                                  capacity * sizeof(VectorItem));
     if (temp == NULL)
         return false;
     
-    self->elements   = temp;
-    self->alloc_size = new_size;
+    self->elements = temp;
+    self->capacity = capacity;
     
     return true;
 }
 
 static bool vector_check_bounds(const Vector* self, int index)
 {
-    return (self->count > 0) && (index < self->count) && (index >= 0);
+    return (index >= 0) && ((size_t) index < self->count);
 }
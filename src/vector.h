@@ -1,5 +1,7 @@
 /*******************************************************************************
  * Implementation of a simple dynamic vector data structure.
+ * The capacity grows geometrically, so appending items takes amortized constant
+ * time.
  ******************************************************************************/
 
 #ifndef VECTOR_H
@@ -25,6 +27,17 @@ Vector* vector_create();
  */
 void vector_destroy(Vector* self);
 
+/*
+ * Make sure the vector can hold the given number of items without growing.
+ * @result Returns false if an error occurred.
+ */
+bool vector_reserve(Vector* self, size_t capacity);
+
+/*
+ * Release unused capacity of the vector.
+ */
+void vector_shrink_to_fit(Vector* self);
+
 /*
  * Append an item to the vector.
  * @result Returns index of the appended item. Returns -1 if an error occurred.
@@ -32,11 +45,24 @@ void vector_destroy(Vector* self);
 int vector_append(Vector* self, VectorItem item);
 
 /*
- * Remove an item from the vector.
- * @result Returns the removed item.
+ * Append several items to the vector at once.
+ * @result Returns false if an error occurred.
+ */
+bool vector_extend(Vector* self, const VectorItem* items, size_t count);
+
+/*
+ * Remove an item from the vector (the order of the remaining items is kept).
+ * @result Returns the removed item (NULL, if the index is out of bounds).
  */
 VectorItem vector_remove(Vector* self, int index);
 
+/*
+ * Remove an item from the vector in constant time by moving the last item to
+ * its index (i.e. the order of the remaining items is not kept).
+ * @result Returns the removed item (NULL, if the index is out of bounds).
+ */
+VectorItem vector_swap_remove(Vector* self, int index);
+
 /*
  * Remove all items from the vector.
  */
@@ -57,5 +83,10 @@ bool vector_set(Vector* self, int index, VectorItem item);
  */
 size_t vector_get_count(const Vector* self);
 
+/*
+ * Get the number of items, the vector can hold without growing.
+ */
+size_t vector_get_capacity(const Vector* self);
+
 
 #endif /* VECTOR_H */
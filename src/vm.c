@@ -0,0 +1,144 @@
+#include "utils.h"
+#include "cb_utils.h"
+#include "operation.h"
+#include "vm.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Replace the value of a register (takes ownership of value)
+ */
+static void cb_vm_set_register(CbVariant* registers,
+                               unsigned int index,
+                               CbVariant value);
+
+
+/* -------------------------------------------------------------------------- */
+
+CbVariant* cb_vm_execute(const CbBytecode* code)
+{
+    size_t i;
+    CbVariant value;
+    CbVariant* result     = NULL;
+    size_t register_count = cb_bytecode_get_register_count(code);
+    CbVariant* registers  = memalloc(register_count * sizeof(CbVariant));
+    
+    for (i = 0; i < register_count; i++)
+        registers[i] = cb_variant_make();
+    
+    if (cb_vm_run(code, registers, &value))
+        result = cb_variant_box(value);
+    
+    for (i = 0; i < register_count; i++)
+        cb_variant_release(&registers[i]);
+    memfree(registers);
+    
+    return result;
+}
+
+bool cb_vm_run(const CbBytecode* code, CbVariant* registers, CbVariant* result)
+{
+    CbVariant value;
+    size_t pc                        = 0;
+    bool running                     = true;
+    bool success                     = false;
+    const CbInstruction* instruction = NULL;
+    const CbInstruction* program     = cb_bytecode_get_instructions(code);
+    
+    *result = cb_variant_make();
+    
+    while (running)
+    {
+        cb_assert(pc < cb_bytecode_get_count(code));
+        instruction = &program[pc++];
+        
+        switch ((CbOpcode) instruction->opcode)
+        {
+            case CB_OPCODE_LOAD_UNDEFINED:
+                cb_vm_set_register(registers, instruction->a,
+                                   cb_variant_make());
+                break;
+            
+            /* copies reuse the (string) payload of the destination register */
+            case CB_OPCODE_LOAD_CONSTANT:
+                cb_variant_assign(&registers[instruction->a],
+                                  cb_bytecode_get_constant(code,
+                                                           instruction->b));
+                break;
+            
+            case CB_OPCODE_MOVE:
+                cb_variant_assign(&registers[instruction->a],
+                                  &registers[instruction->b]);
+                break;
+            
+            case CB_OPCODE_BINARY:
+                /* "s := s + x" appends to the string in place */
+                if (instruction->a == instruction->b &&
+                    instruction->operator_type == CB_BINARY_OPERATOR_TYPE_ADD &&
+                    cb_variant_is_string(&registers[instruction->a]) &&
+                    cb_variant_is_string(&registers[instruction->c]))
+                    cb_string_concat(&registers[instruction->a],
+                                     &registers[instruction->c]);
+                else if (cb_binary_operation_eval(
+                        (CbBinaryOperatorType) instruction->operator_type,
+                        &registers[instruction->b], &registers[instruction->c],
+                        cb_bytecode_get_line(code, pc - 1), &value))
+                    cb_vm_set_register(registers, instruction->a, value);
+                else
+                    running = false; /* runtime error */
+                break;
+            
+            case CB_OPCODE_UNARY:
+                if (cb_unary_operation_eval(
+                        (CbUnaryOperatorType) instruction->operator_type,
+                        &registers[instruction->b],
+                        cb_bytecode_get_line(code, pc - 1), &value))
+                    cb_vm_set_register(registers, instruction->a, value);
+                else
+                    running = false; /* runtime error */
+                break;
+            
+            case CB_OPCODE_JUMP:
+                pc = instruction->b;
+                break;
+            
+            case CB_OPCODE_JUMP_IF_FALSE:
+                if (!cb_boolean_get_value(&registers[instruction->a]))
+                    pc = instruction->b;
+                break;
+            
+            case CB_OPCODE_JUMP_IF_BOOLEAN:
+                /* values of any other type never jump */
+                if (cb_variant_is_boolean(&registers[instruction->a]) &&
+                    cb_boolean_get_value(&registers[instruction->a]) ==
+                        (instruction->c != 0))
+                    pc = instruction->b;
+                break;
+            
+            case CB_OPCODE_RETURN:
+                /* move the value out of the register */
+                *result                   = registers[instruction->a];
+                registers[instruction->a] = cb_variant_make();
+                running                   = false;
+                success                   = true;
+                break;
+            
+            /* invalid opcode */
+            default: cb_abort("Invalid opcode"); break;
+        }
+    }
+    
+    return success;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void cb_vm_set_register(CbVariant* registers,
+                               unsigned int index,
+                               CbVariant value)
+{
+    cb_variant_release(&registers[index]);
+    registers[index] = value;
+}
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * @file  vm.h
+ * @brief Register based virtual machine
+ * 
+ * Executes bytecode produced by the bytecode compiler (see compiler.h).
+ * Evaluation results are identical to those of the AST evaluation.
+ ******************************************************************************/
+
+#ifndef VM_H
+#define VM_H
+
+#include "variant.h"
+#include "bytecode.h"
+
+
+/**
+ * @brief Execute bytecode
+ * 
+ * @param code The bytecode to execute
+ * 
+ * @return Returns the result of the execution, which must be destroyed by the
+ *         caller. If a runtime error occurred, NULL is returned.
+ */
+CbVariant* cb_vm_execute(const CbBytecode* code);
+
+/**
+ * @brief Execute bytecode using a caller provided register file
+ * 
+ * This allows to execute the same bytecode many times without allocating the
+ * registers for each execution.
+ * 
+ * @param code      The bytecode to execute
+ * @param registers The register file (at least cb_bytecode_get_register_count()
+ *                  initialized values). The registers of the variables
+ *                  (i.e. the register with the same index as the variable's
+ *                  slot) must hold their initial values.
+ * @param result    Receives the result of the execution
+ * 
+ * @return Returns false, if a runtime error occurred.
+ */
+bool cb_vm_run(const CbBytecode* code, CbVariant* registers, CbVariant* result);
+
+
+#endif /* VM_H */
@@ -0,0 +1,167 @@
+#include <pthread.h>
+
+#include "utils.h"
+#include "cb_utils.h"
+#include "error_handling.h"
+#include "worker_pool.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Worker thread of a pool
+ */
+typedef struct CbWorker
+{
+    CbWorkerPool* pool;
+    size_t index;
+    pthread_t thread;
+} CbWorker;
+
+struct CbWorkerPool
+{
+    CbWorker* workers; /* spawned workers (worker_count - 1 items) */
+    size_t worker_count;
+    
+    pthread_mutex_t lock;
+    pthread_cond_t task_posted;   /* a task was posted or the pool stops */
+    pthread_cond_t task_finished; /* the last worker finished the task   */
+    
+    /* current task */
+    CbWorkerPoolTask task;
+    void* data;
+    FILE* error_output;
+    size_t generation; /* number of tasks posted so far          */
+    size_t running;    /* spawned workers still running the task */
+    bool stopping;
+};
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Wait for tasks and run them until the pool stops.
+ */
+static void* cb_worker_run(void* data);
+
+
+/* -------------------------------------------------------------------------- */
+
+CbWorkerPool* cb_worker_pool_create(size_t worker_count)
+{
+    size_t i;
+    CbWorkerPool* self = memalloc(sizeof(CbWorkerPool));
+    
+    cb_assert(worker_count > 0);
+    
+    self->workers      = memalloc(worker_count * sizeof(CbWorker));
+    self->worker_count = worker_count;
+    self->task         = NULL;
+    self->data         = NULL;
+    self->error_output = cb_error_get_output();
+    self->generation   = 0;
+    self->running      = 0;
+    self->stopping     = false;
+    pthread_mutex_init(&self->lock, NULL);
+    pthread_cond_init(&self->task_posted, NULL);
+    pthread_cond_init(&self->task_finished, NULL);
+    
+    /* the calling thread is the first worker */
+    for (i = 0; i < worker_count - 1; i++)
+    {
+        self->workers[i].pool  = self;
+        self->workers[i].index = i + 1;
+        
+        if (pthread_create(&self->workers[i].thread, NULL, cb_worker_run,
+                           &self->workers[i]) != 0)
+            cb_abort("Failed to create worker thread");
+    }
+    
+    return self;
+}
+
+void cb_worker_pool_destroy(CbWorkerPool* self)
+{
+    size_t i;
+    
+    pthread_mutex_lock(&self->lock);
+    self->stopping = true;
+    pthread_cond_broadcast(&self->task_posted);
+    pthread_mutex_unlock(&self->lock);
+    
+    for (i = 0; i < self->worker_count - 1; i++)
+        pthread_join(self->workers[i].thread, NULL);
+    
+    pthread_cond_destroy(&self->task_finished);
+    pthread_cond_destroy(&self->task_posted);
+    pthread_mutex_destroy(&self->lock);
+    memfree(self->workers);
+    memfree(self);
+}
+
+size_t cb_worker_pool_get_worker_count(const CbWorkerPool* self)
+{
+    return self->worker_count;
+}
+
+void cb_worker_pool_run(CbWorkerPool* self, CbWorkerPoolTask task, void* data)
+{
+    pthread_mutex_lock(&self->lock);
+    cb_assert(self->running == 0);
+    self->task         = task;
+    self->data         = data;
+    self->error_output = cb_error_get_output();
+    self->running      = self->worker_count - 1;
+    self->generation++;
+    pthread_cond_broadcast(&self->task_posted);
+    pthread_mutex_unlock(&self->lock);
+    
+    task(data, 0);
+    
+    pthread_mutex_lock(&self->lock);
+    while (self->running > 0)
+        pthread_cond_wait(&self->task_finished, &self->lock);
+    pthread_mutex_unlock(&self->lock);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void* cb_worker_run(void* data)
+{
+    CbWorkerPoolTask task;
+    void* task_data;
+    CbWorker* self     = data;
+    CbWorkerPool* pool = self->pool;
+    size_t generation  = 0;
+    
+    pthread_mutex_lock(&pool->lock);
+    
+    /* error handling is thread local */
+    cb_error_initialize(pool->error_output);
+    
+    for (;;)
+    {
+        while (!pool->stopping && pool->generation == generation)
+            pthread_cond_wait(&pool->task_posted, &pool->lock);
+        if (pool->stopping)
+            break;
+        
+        generation = pool->generation;
+        task       = pool->task;
+        task_data  = pool->data;
+        cb_error_set_output(pool->error_output);
+        pthread_mutex_unlock(&pool->lock);
+        
+        task(task_data, self->index);
+        
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0)
+            pthread_cond_signal(&pool->task_finished);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    
+    cb_error_finalize();
+    
+    return NULL;
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * @file  worker_pool.h
+ * @brief Pool of persistent worker threads
+ * 
+ * The worker threads are started once and wait for tasks, so running a task
+ * on all workers does not create any threads. The calling thread takes part in
+ * each task as the first worker.
+ ******************************************************************************/
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <stddef.h>
+
+
+/**
+ * @struct CbWorkerPool
+ * @brief  Pool of worker threads
+ */
+typedef struct CbWorkerPool CbWorkerPool;
+
+/**
+ * @brief Task executed by each worker of a pool
+ * 
+ * @param data   The data passed to cb_worker_pool_run()
+ * @param worker Index of the worker (0 is the calling thread)
+ */
+typedef void (*CbWorkerPoolTask)(void* data, size_t worker);
+
+
+/**
+ * @memberof CbWorkerPool
+ * @brief    Constructor
+ * 
+ * Starts worker_count - 1 threads, which initialize their error handling
+ * right away.
+ * 
+ * @param worker_count Number of workers including the calling thread
+ */
+CbWorkerPool* cb_worker_pool_create(size_t worker_count);
+
+/**
+ * @memberof CbWorkerPool
+ * @brief    Destructor
+ * 
+ * Stops and joins all worker threads.
+ * 
+ * @param self The CbWorkerPool instance
+ */
+void cb_worker_pool_destroy(CbWorkerPool* self);
+
+/**
+ * @memberof CbWorkerPool
+ * @brief    Get the number of workers including the calling thread
+ * 
+ * @param self The CbWorkerPool instance
+ */
+size_t cb_worker_pool_get_worker_count(const CbWorkerPool* self);
+
+/**
+ * @memberof CbWorkerPool
+ * @brief    Run a task on all workers and wait until all of them finished
+ * 
+ * The workers report errors to the error output of the calling thread.
+ * 
+ * @param self The CbWorkerPool instance
+ * @param task The task to run
+ * @param data Data passed to the task
+ * 
+ * NOTE: A pool must only be used by one thread at a time.
+ */
+void cb_worker_pool_run(CbWorkerPool* self, CbWorkerPoolTask task, void* data);
+
+
+#endif /* WORKER_POOL_H */
@@ -3,12 +3,15 @@
  ******************************************************************************/
 
 #include "../src/error_handling.h"
+#include "../src/intern.h"
 #include "../src/symbol_table.h"
 #include "../src/symbol_variable.h"
 #include "../src/symbol_function.h"
+#include "../src/arena.h"
 #include "../src/ast.h"
 #include "../src/ast_value.h"
 #include "../src/ast_binary.h"
+#include "../src/ast_logical.h"
 #include "../src/ast_unary.h"
 #include "../src/ast_variable.h"
 #include "../src/ast_declaration.h"
@@ -23,44 +26,54 @@ static void test_ast_binary_node_eval(const CbBinaryOperatorType operator,
                                       CbVariant* value1,
                                       CbVariant* value2,
                                       CbVariant* expected_result);
-static CbAstValueNode* test_create_ast_value_integer_node(const CbIntegerDataType value);
-static CbAstValueNode* test_create_ast_value_float_node(const CbFloatDataType value);
-static CbAstValueNode* test_create_ast_value_boolean_node(const CbBooleanDataType value);
+static CbAstValueNode* test_create_ast_value_integer_node(CbArena* arena,
+                                                          const CbIntegerDataType value);
+static CbAstValueNode* test_create_ast_value_float_node(CbArena* arena,
+                                                        const CbFloatDataType value);
+static CbAstValueNode* test_create_ast_value_boolean_node(CbArena* arena,
+                                                          const CbBooleanDataType value);
 
 
 /* -------------------------------------------------------------------------- */
 
 /*
- * Test constructors and destructors of all AST node types
+ * Test constructors of all AST node types
  */
 void ast_alloc_test(void** state)
 {
+    CbArena* arena               = cb_arena_create();
     CbAstBinaryNode* binary_node = NULL;
     CbAstValueNode* value_node   = NULL;
     CbAstUnaryNode* unary_node   = NULL;
     CbAstVariableNode* var_node  = NULL;
     
-    value_node = test_create_ast_value_integer_node(123);
-    cb_ast_node_destroy((CbAstNode*) value_node);
+    value_node = test_create_ast_value_integer_node(arena, 123);
+    assert_non_null(value_node);
     
-    value_node = test_create_ast_value_float_node(123.00123);
-    cb_ast_node_destroy((CbAstNode*) value_node);
+    value_node = test_create_ast_value_float_node(arena, 123.00123);
+    assert_non_null(value_node);
     
     binary_node = cb_ast_binary_node_create(
+        arena,
         CB_BINARY_OPERATOR_TYPE_ADD,
-        (CbAstNode*) test_create_ast_value_integer_node(123),
-        (CbAstNode*) test_create_ast_value_integer_node(77)
+        (CbAstNode*) test_create_ast_value_integer_node(arena, 123),
+        (CbAstNode*) test_create_ast_value_integer_node(arena, 77)
     );
-    cb_ast_node_destroy((CbAstNode*) binary_node);
+    assert_non_null(binary_node);
     
     unary_node = cb_ast_unary_node_create(
+        arena,
         CB_UNARY_OPERATOR_TYPE_MINUS,
-        (CbAstNode*) test_create_ast_value_integer_node(123)
+        (CbAstNode*) test_create_ast_value_integer_node(arena, 123)
     );
-    cb_ast_node_destroy((CbAstNode*) unary_node);
+    assert_non_null(unary_node);
     
-    var_node = cb_ast_variable_node_create("test_var");
-    cb_ast_node_destroy((CbAstNode*) var_node);
+    var_node = cb_ast_variable_node_create(arena, cb_intern("test_var"));
+    assert_non_null(var_node);
+    
+    /* all nodes are released at once */
+    assert_true(cb_arena_get_size(arena) > 0);
+    cb_arena_destroy(arena);
 }
 
 /*
@@ -68,6 +81,7 @@ void ast_alloc_test(void** state)
  */
 void ast_eval_test(void** state)
 {
+    CbArena* arena             = cb_arena_create();
     CbAstUnaryNode* unary_node = NULL;
     CbVariant* result          = NULL;
     
@@ -267,40 +281,40 @@ void ast_eval_test(void** state)
     
     /* unary AST node (expression: - <integer>) */
     unary_node = cb_ast_unary_node_create(
+        arena,
         CB_UNARY_OPERATOR_TYPE_MINUS,
-        (CbAstNode*) test_create_ast_value_integer_node(123)
+        (CbAstNode*) test_create_ast_value_integer_node(arena, 123)
     );
     result = cb_ast_node_eval((CbAstNode*) unary_node, NULL);
     assert_cb_integer_equal(-123, result);
     cb_variant_destroy(result);
-    cb_ast_node_destroy((CbAstNode*) unary_node);
     /* unary AST node (expression: - <float>) */
     unary_node = cb_ast_unary_node_create(
+        arena,
         CB_UNARY_OPERATOR_TYPE_MINUS,
-        (CbAstNode*) test_create_ast_value_float_node(321.00123)
+        (CbAstNode*) test_create_ast_value_float_node(arena, 321.00123)
     );
     result = cb_ast_node_eval((CbAstNode*) unary_node, NULL);
     assert_cb_float_equal(-321.00123, result);
     cb_variant_destroy(result);
-    cb_ast_node_destroy((CbAstNode*) unary_node);
     /* unary AST node (expression: not <boolean>) */
     unary_node = cb_ast_unary_node_create(
+        arena,
         CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT,
-        (CbAstNode*) test_create_ast_value_boolean_node(true)
+        (CbAstNode*) test_create_ast_value_boolean_node(arena, true)
     );
     result = cb_ast_node_eval((CbAstNode*) unary_node, NULL);
     assert_cb_boolean_equal(false, result);
     cb_variant_destroy(result);
-    cb_ast_node_destroy((CbAstNode*) unary_node);
     /* unary AST node (expression: not <boolean>) */
     unary_node = cb_ast_unary_node_create(
+        arena,
         CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT,
-        (CbAstNode*) test_create_ast_value_boolean_node(false)
+        (CbAstNode*) test_create_ast_value_boolean_node(arena, false)
     );
     result = cb_ast_node_eval((CbAstNode*) unary_node, NULL);
     assert_cb_boolean_equal(true, result);
     cb_variant_destroy(result);
-    cb_ast_node_destroy((CbAstNode*) unary_node);
     
     /*
      * variable AST node (expression: <variable>)
@@ -313,13 +327,13 @@ void ast_eval_test(void** state)
         
         /* prepare symbol and symbol table */
         symbols  = cb_symbol_table_create();
-        variable = cb_symbol_variable_create("test_var");
+        variable = cb_symbol_variable_create(cb_intern("test_var"));
         temp     = cb_integer_create(123);
         cb_symbol_variable_assign(variable, temp);
         cb_variant_destroy(temp);
         assert_null(cb_symbol_table_insert(symbols, (CbSymbol*) variable));
         /* prepare AST node */
-        node = (CbAstNode*) cb_ast_variable_node_create("test_var");
+        node = (CbAstNode*) cb_ast_variable_node_create(arena, cb_intern("test_var"));
         
         result = cb_ast_node_eval(node, symbols);
         assert_non_null(result);
@@ -327,7 +341,6 @@ void ast_eval_test(void** state)
         
         /* clean up */
         cb_variant_destroy(result);
-        cb_ast_node_destroy(node);
         cb_symbol_table_destroy(symbols);
     }
     
@@ -338,7 +351,8 @@ void ast_eval_test(void** state)
         CbVariant* result = NULL;
         CbVariant* temp   = cb_variant_create();
         CbAstNode* node   = (CbAstNode*) cb_ast_declaration_node_create(
-            CB_AST_DECLARATION_TYPE_VARIABLE, "test_var"
+            arena,
+            CB_AST_DECLARATION_TYPE_VARIABLE, cb_intern("test_var")
         );
         
         result = cb_ast_node_eval(node, NULL);
@@ -346,7 +360,6 @@ void ast_eval_test(void** state)
         
         cb_variant_destroy(result);
         cb_variant_destroy(temp);
-        cb_ast_node_destroy(node);
     }
     
     /*
@@ -361,9 +374,10 @@ void ast_eval_test(void** state)
         
         /* Case 1: Condition is false */
         node = (CbAstNode*) cb_ast_if_node_create(
-            (CbAstNode*) cb_ast_value_node_create(condition),
-            (CbAstNode*) cb_ast_value_node_create(value_true),
-            (CbAstNode*) cb_ast_value_node_create(value_false)
+            arena,
+            (CbAstNode*) cb_ast_value_node_create(arena, condition),
+            (CbAstNode*) cb_ast_value_node_create(arena, value_true),
+            (CbAstNode*) cb_ast_value_node_create(arena, value_false)
         );
         
         result = cb_ast_node_eval(node, NULL);
@@ -371,14 +385,14 @@ void ast_eval_test(void** state)
         
         cb_variant_destroy(result);
         cb_variant_destroy(condition);
-        cb_ast_node_destroy(node);
         condition = cb_boolean_create(true);
         
         /* Case 2: Condition is true */
         node = (CbAstNode*) cb_ast_if_node_create(
-            (CbAstNode*) cb_ast_value_node_create(condition),
-            (CbAstNode*) cb_ast_value_node_create(value_true),
-            (CbAstNode*) cb_ast_value_node_create(value_false)
+            arena,
+            (CbAstNode*) cb_ast_value_node_create(arena, condition),
+            (CbAstNode*) cb_ast_value_node_create(arena, value_true),
+            (CbAstNode*) cb_ast_value_node_create(arena, value_false)
         );
         
         result = cb_ast_node_eval(node, NULL);
@@ -386,13 +400,13 @@ void ast_eval_test(void** state)
         
         cb_variant_destroy(result);
         cb_variant_destroy(condition);
-        cb_ast_node_destroy(node);
         condition = cb_boolean_create(false);
         
         /* Case 3: Condition is false, no false-branch */
         node = (CbAstNode*) cb_ast_if_node_create(
-            (CbAstNode*) cb_ast_value_node_create(condition),
-            (CbAstNode*) cb_ast_value_node_create(value_true),
+            arena,
+            (CbAstNode*) cb_ast_value_node_create(arena, condition),
+            (CbAstNode*) cb_ast_value_node_create(arena, value_true),
             NULL
         );
         
@@ -401,11 +415,12 @@ void ast_eval_test(void** state)
         
         cb_variant_destroy(result);
         cb_variant_destroy(condition);
-        cb_ast_node_destroy(node);
         
         cb_variant_destroy(value_true);
         cb_variant_destroy(value_false);
     }
+    
+    cb_arena_destroy(arena);
 }
 
 /*
@@ -413,59 +428,59 @@ void ast_eval_test(void** state)
  */
 void ast_check_semantic_test(void** state)
 {
+    CbArena* arena = cb_arena_create();
     CbAstNode* node;
     CbSymbolTable* symbols;
     
     /* expression: <numeric> + ( - <numeric> ) */
     node = (CbAstNode*) cb_ast_binary_node_create(
+        arena,
         CB_BINARY_OPERATOR_TYPE_ADD,
-        (CbAstNode*) test_create_ast_value_integer_node(123),
+        (CbAstNode*) test_create_ast_value_integer_node(arena, 123),
         (CbAstNode*) cb_ast_unary_node_create(
+            arena,
             CB_UNARY_OPERATOR_TYPE_MINUS,
-            (CbAstNode*) test_create_ast_value_integer_node(321)
+            (CbAstNode*) test_create_ast_value_integer_node(arena, 321)
         )
     );
     assert_true(cb_ast_node_check_semantic(node, NULL));
-    cb_ast_node_destroy(node);
     
     /* expression: <numeric> + <float> */
     node = (CbAstNode*) cb_ast_binary_node_create(
+        arena,
         CB_BINARY_OPERATOR_TYPE_ADD,
-        (CbAstNode*) test_create_ast_value_integer_node(123),
-        (CbAstNode*) test_create_ast_value_float_node(321.00123)
+        (CbAstNode*) test_create_ast_value_integer_node(arena, 123),
+        (CbAstNode*) test_create_ast_value_float_node(arena, 321.00123)
     );
     assert_true(cb_ast_node_check_semantic(node, NULL));
-    cb_ast_node_destroy(node);
     
     /* expression: - <float> */
     node = (CbAstNode*) cb_ast_unary_node_create(
+        arena,
         CB_UNARY_OPERATOR_TYPE_MINUS,
-        (CbAstNode*) test_create_ast_value_float_node(321.00123)
+        (CbAstNode*) test_create_ast_value_float_node(arena, 321.00123)
     );
     assert_true(cb_ast_node_check_semantic(node, NULL));
-    cb_ast_node_destroy(node);
     
     /* variable "test_var" */
     symbols = cb_symbol_table_create();
     assert_null(cb_symbol_table_insert(
-        symbols, (CbSymbol*) cb_symbol_variable_create("test_var")
+        symbols, (CbSymbol*) cb_symbol_variable_create(cb_intern("test_var"))
     ));
-    node = (CbAstNode*) cb_ast_variable_node_create("test_var");
+    node = (CbAstNode*) cb_ast_variable_node_create(arena, cb_intern("test_var"));
     assert_true(cb_ast_node_check_semantic(node, symbols));
-    cb_ast_node_destroy(node);
     cb_symbol_table_destroy(symbols);
     
     /* declaring variable "test_var" */
     symbols = cb_symbol_table_create();
     node    = (CbAstNode*) cb_ast_declaration_node_create(
-        CB_AST_DECLARATION_TYPE_VARIABLE, "test_var"
+        arena,
+        CB_AST_DECLARATION_TYPE_VARIABLE, cb_intern("test_var")
     );
     assert_true(cb_ast_node_check_semantic(node, symbols));
-    cb_ast_node_destroy(node);
     /* additional test for accessing variable in symbol table */
-    node = (CbAstNode*) cb_ast_variable_node_create("test_var");
+    node = (CbAstNode*) cb_ast_variable_node_create(arena, cb_intern("test_var"));
     assert_true(cb_ast_node_check_semantic(node, symbols));
-    cb_ast_node_destroy(node);
     cb_symbol_table_destroy(symbols);
     
     /* statement: if */
@@ -475,36 +490,38 @@ void ast_check_semantic_test(void** state)
         CbVariant* dummy3 = cb_integer_create(321);
         
         node = (CbAstNode*) cb_ast_if_node_create(
-            (CbAstNode*) cb_ast_value_node_create(dummy1),
-            (CbAstNode*) cb_ast_value_node_create(dummy2),
-            (CbAstNode*) cb_ast_value_node_create(dummy3)
+            arena,
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy1),
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy2),
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy3)
         );
         
         assert_true(cb_ast_node_check_semantic(node, NULL));
-        cb_ast_node_destroy(node);
         
         node = (CbAstNode*) cb_ast_if_node_create(
-            (CbAstNode*) cb_ast_value_node_create(dummy1),
-            (CbAstNode*) cb_ast_value_node_create(dummy2),
+            arena,
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy1),
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy2),
             NULL
         );
         
         assert_true(cb_ast_node_check_semantic(node, NULL));
-        cb_ast_node_destroy(node);
         
         node = (CbAstNode*) cb_ast_if_node_create(
-            (CbAstNode*) cb_ast_value_node_create(dummy1),
+            arena,
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy1),
             NULL,
             NULL
         );
         
         assert_true(cb_ast_node_check_semantic(node, NULL));
-        cb_ast_node_destroy(node);
         
         cb_variant_destroy(dummy1);
         cb_variant_destroy(dummy2);
         cb_variant_destroy(dummy3);
     }
+    
+    cb_arena_destroy(arena);
 }
 
 /*
@@ -512,6 +529,7 @@ void ast_check_semantic_test(void** state)
  */
 void ast_check_semantic_error_test(void** state)
 {
+    CbArena* arena = cb_arena_create();
     CbAstNode* node;
     CbSymbolTable* symbols;
     CbVariant* v1;
@@ -525,15 +543,15 @@ void ast_check_semantic_error_test(void** state)
     v1      = cb_integer_create(100);
     v2      = cb_boolean_create(false);
     node    = (CbAstNode*) cb_ast_binary_node_create(
+        arena,
         CB_BINARY_OPERATOR_TYPE_DIV,
-        (CbAstNode*) cb_ast_value_node_create(v1),
-        (CbAstNode*) cb_ast_value_node_create(v2)
+        (CbAstNode*) cb_ast_value_node_create(arena, v1),
+        (CbAstNode*) cb_ast_value_node_create(arena, v2)
     );
     cb_variant_destroy(v1);
     cb_variant_destroy(v2);
     cb_ast_node_set_line(node, 1);
     assert_false(cb_ast_node_check_semantic(node, symbols));
-    cb_ast_node_destroy(node);
     assert_true(cb_error_occurred());
     cb_error_process();
     assert_false(cb_error_occurred());
@@ -544,17 +562,41 @@ void ast_check_semantic_error_test(void** state)
     /* discard stream content */
     resetup_error_handling(state);
     
+    /*
+     * Test: Invalid logical operation (the right operand is checked, even
+     *       though it would never be evaluated)
+     */
+    v1   = cb_boolean_create(false);
+    v2   = cb_integer_create(1);
+    node = (CbAstNode*) cb_ast_logical_node_create(
+        arena,
+        CB_BINARY_OPERATOR_TYPE_LOGICAL_AND,
+        (CbAstNode*) cb_ast_value_node_create(arena, v1),
+        (CbAstNode*) cb_ast_value_node_create(arena, v2)
+    );
+    cb_variant_destroy(v1);
+    cb_variant_destroy(v2);
+    cb_ast_node_set_line(node, 1);
+    assert_false(cb_ast_node_check_semantic(node, symbols));
+    assert_true(cb_error_occurred());
+    cb_error_process();
+    stream_to_string(*state, stream_content, true);
+    assert_string_equal("semantic error: line 1: Invalid binary operation: "\
+                        "<boolean> and <integer>", stream_content);
+    
+    /* discard stream content */
+    resetup_error_handling(state);
+    
     /*
      * Test: Expected identifier is declared as a function
      */
     symbols = cb_symbol_table_create();
     assert_null(cb_symbol_table_insert(
-        symbols, (CbSymbol*) cb_symbol_function_create("test_var")
+        symbols, (CbSymbol*) cb_symbol_function_create(cb_intern("test_var"))
     ));
-    node = (CbAstNode*) cb_ast_variable_node_create("test_var");
+    node = (CbAstNode*) cb_ast_variable_node_create(arena, cb_intern("test_var"));
     cb_ast_node_set_line(node, 1);
     assert_false(cb_ast_node_check_semantic(node, symbols));
-    cb_ast_node_destroy(node);
     assert_true(cb_error_occurred());
     cb_error_process();
     assert_false(cb_error_occurred());
@@ -571,10 +613,9 @@ void ast_check_semantic_error_test(void** state)
      * Test: Expected identifier is not declared at all
      */
     symbols = cb_symbol_table_create();
-    node = (CbAstNode*) cb_ast_variable_node_create("test_var");
+    node = (CbAstNode*) cb_ast_variable_node_create(arena, cb_intern("test_var"));
     cb_ast_node_set_line(node, 1);
     assert_false(cb_ast_node_check_semantic(node, symbols));
-    cb_ast_node_destroy(node);
     assert_true(cb_error_occurred());
     cb_error_process();
     assert_false(cb_error_occurred());
@@ -591,14 +632,14 @@ void ast_check_semantic_error_test(void** state)
      */
     symbols = cb_symbol_table_create();
     assert_null(cb_symbol_table_insert(
-        symbols, (CbSymbol*) cb_symbol_variable_create("test_var")
+        symbols, (CbSymbol*) cb_symbol_variable_create(cb_intern("test_var"))
     ));
     node = (CbAstNode*) cb_ast_declaration_node_create(
-        CB_AST_DECLARATION_TYPE_VARIABLE, "test_var"
+        arena,
+        CB_AST_DECLARATION_TYPE_VARIABLE, cb_intern("test_var")
     );
     cb_ast_node_set_line(node, 1);
     assert_false(cb_ast_node_check_semantic(node, symbols));
-    cb_ast_node_destroy(node);
     assert_true(cb_error_occurred());
     cb_error_process();
     assert_false(cb_error_occurred());
@@ -617,13 +658,13 @@ void ast_check_semantic_error_test(void** state)
     {
         CbVariant* dummy = cb_integer_create(123);
         node             = (CbAstNode*) cb_ast_if_node_create(
-            (CbAstNode*) cb_ast_value_node_create(dummy),
-            (CbAstNode*) cb_ast_value_node_create(dummy),
-            (CbAstNode*) cb_ast_value_node_create(dummy)
+            arena,
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy),
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy),
+            (CbAstNode*) cb_ast_value_node_create(arena, dummy)
         );
         cb_ast_node_set_line(node, 1);
         assert_false(cb_ast_node_check_semantic(node, NULL));
-        cb_ast_node_destroy(node);
         assert_true(cb_error_occurred());
         cb_error_process();
         assert_false(cb_error_occurred());
@@ -632,6 +673,8 @@ void ast_check_semantic_error_test(void** state)
                             "boolean expression", stream_content);
         cb_variant_destroy(dummy);
     }
+    
+    cb_arena_destroy(arena);
 }
 
 /*
@@ -639,6 +682,7 @@ void ast_check_semantic_error_test(void** state)
  */
 void ast_eval_error_test(void** state)
 {
+    CbArena* arena = cb_arena_create();
     CbAstNode* node;
     CbVariant* left;
     CbVariant* right;
@@ -650,15 +694,15 @@ void ast_eval_error_test(void** state)
     left    = cb_integer_create(100);
     right   = cb_boolean_create(false);
     node    = (CbAstNode*) cb_ast_binary_node_create(
+        arena,
         CB_BINARY_OPERATOR_TYPE_DIV,
-        (CbAstNode*) cb_ast_value_node_create(left),
-        (CbAstNode*) cb_ast_value_node_create(right)
+        (CbAstNode*) cb_ast_value_node_create(arena, left),
+        (CbAstNode*) cb_ast_value_node_create(arena, right)
     );
     cb_variant_destroy(left);
     cb_variant_destroy(right);
     cb_ast_node_set_line(node, 1);
     assert_false(cb_ast_node_eval(node, NULL));
-    cb_ast_node_destroy(node);
     assert_true(cb_error_occurred());
     cb_error_process();
     assert_false(cb_error_occurred());
@@ -675,9 +719,10 @@ void ast_eval_error_test(void** state)
     left   = cb_integer_create(3);
     right  = cb_integer_create(0);
     node   = (CbAstNode*) cb_ast_binary_node_create(
+        arena,
         CB_BINARY_OPERATOR_TYPE_DIV,
-        (CbAstNode*) cb_ast_value_node_create(left),
-        (CbAstNode*) cb_ast_value_node_create(right)
+        (CbAstNode*) cb_ast_value_node_create(arena, left),
+        (CbAstNode*) cb_ast_value_node_create(arena, right)
     );
     cb_ast_node_set_line(node, 1);
     
@@ -691,7 +736,7 @@ void ast_eval_error_test(void** state)
     assert_string_equal("runtime error: line 1: Division by zero is not allowed",
                         buffer);
     
-    cb_ast_node_destroy(node);
+    cb_arena_destroy(arena);
 }
 
 
@@ -705,17 +750,19 @@ static void test_ast_binary_node_eval(const CbBinaryOperatorType operator,
                                       CbVariant* value2,
                                       CbVariant* expected_result)
 {
+    CbArena* arena        = cb_arena_create();
     CbAstBinaryNode* node = cb_ast_binary_node_create(
+        arena,
         operator,
-        (CbAstNode*) cb_ast_value_node_create(value1),
-        (CbAstNode*) cb_ast_value_node_create(value2)
+        (CbAstNode*) cb_ast_value_node_create(arena, value1),
+        (CbAstNode*) cb_ast_value_node_create(arena, value2)
     );
     CbVariant* result = cb_ast_node_eval((CbAstNode*) node, NULL);
     
     assert_cb_variant_equal(expected_result, result);
     
     cb_variant_destroy(result);
-    cb_ast_node_destroy((CbAstNode*) node);
+    cb_arena_destroy(arena);
     
     cb_variant_destroy(value1);
     cb_variant_destroy(value2);
@@ -725,10 +772,11 @@ static void test_ast_binary_node_eval(const CbBinaryOperatorType operator,
 /*
  * Create an integer value node (internal)
  */
-static CbAstValueNode* test_create_ast_value_integer_node(const CbIntegerDataType value)
+static CbAstValueNode* test_create_ast_value_integer_node(CbArena* arena,
+                                                          const CbIntegerDataType value)
 {
     CbVariant* variant         = cb_integer_create(value);
-    CbAstValueNode* value_node = cb_ast_value_node_create(variant);
+    CbAstValueNode* value_node = cb_ast_value_node_create(arena, variant);
     cb_variant_destroy(variant);
     
     return value_node;
@@ -737,10 +785,11 @@ static CbAstValueNode* test_create_ast_value_integer_node(const CbIntegerDataTyp
 /*
  * Create a float value node (internal)
  */
-static CbAstValueNode* test_create_ast_value_float_node(const CbFloatDataType value)
+static CbAstValueNode* test_create_ast_value_float_node(CbArena* arena,
+                                                        const CbFloatDataType value)
 {
     CbVariant* variant         = cb_float_create(value);
-    CbAstValueNode* value_node = cb_ast_value_node_create(variant);
+    CbAstValueNode* value_node = cb_ast_value_node_create(arena, variant);
     cb_variant_destroy(variant);
     
     return value_node;
@@ -749,10 +798,11 @@ static CbAstValueNode* test_create_ast_value_float_node(const CbFloatDataType va
 /*
  * Create a boolean value node (internal)
  */
-static CbAstValueNode* test_create_ast_value_boolean_node(const CbBooleanDataType value)
+static CbAstValueNode* test_create_ast_value_boolean_node(CbArena* arena,
+                                                          const CbBooleanDataType value)
 {
     CbVariant* variant         = cb_boolean_create(value);
-    CbAstValueNode* value_node = cb_ast_value_node_create(variant);
+    CbAstValueNode* value_node = cb_ast_value_node_create(arena, variant);
     cb_variant_destroy(variant);
     
     return value_node;
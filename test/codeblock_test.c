@@ -2,6 +2,11 @@
  * Tests for the CbCodeblock structure
  ******************************************************************************/
 
+#include <pthread.h>
+#include <string.h>
+
+#include "../src/utils.h"
+#include "../src/error_handling.h"
 #include "../src/codeblock.h"
 #include "test.h"
 
@@ -10,6 +15,11 @@
 
 static FILE* write_temp_file(const char* content);
 
+/*
+ * Thread routine: Parse and execute codeblocks repeatedly
+ */
+static void* codeblock_thread_run(void* data);
+
 
 /* -------------------------------------------------------------------------- */
 
@@ -49,6 +59,297 @@ void codeblock_common_test(void** state)
     cb_codeblock_destroy(cb);
 }
 
+/*
+ * Compile a codeblock once and execute it several times
+ */
+void codeblock_program_test(void** state)
+{
+    const char* const TEST_STRING =
+        "|a, b| b := 0, a := 4, while a > 0 do b := b + a, a := a - 1, end, b,";
+    const char* const FAIL_STRING = "|a, b| a := 1, b := 0, a / b,";
+    const CbCodeblockEngine ENGINES[] = {
+        CB_CODEBLOCK_ENGINE_AST, CB_CODEBLOCK_ENGINE_VM
+    };
+    const int TEST_RESULT = 10;
+    size_t i;
+    int run;
+    CbProgram* program;
+    CbEnvironment* env1;
+    CbEnvironment* env2;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    for (i = 0; i < sizeof(ENGINES) / sizeof(ENGINES[0]); i++)
+    {
+        cb_codeblock_set_engine(cb, ENGINES[i]);
+        
+        assert_true(cb_codeblock_parse_string(cb, TEST_STRING));
+        program = cb_codeblock_compile(cb);
+        assert_non_null(program);
+        
+        /* variables are reset for each execution */
+        env1 = cb_environment_create(program);
+        env2 = cb_environment_create(program);
+        for (run = 0; run < 3; run++)
+        {
+            assert_true(cb_program_execute(program, env1));
+            assert_cb_integer_equal(TEST_RESULT, cb_environment_get_result(env1));
+            assert_true(cb_program_execute(program, env2));
+            assert_cb_integer_equal(TEST_RESULT, cb_environment_get_result(env2));
+        }
+        cb_environment_destroy(env1);
+        cb_environment_destroy(env2);
+        cb_program_destroy(program);
+        
+        /* runtime error */
+        assert_true(cb_codeblock_parse_string(cb, FAIL_STRING));
+        program = cb_codeblock_compile(cb);
+        assert_non_null(program);
+        env1 = cb_environment_create(program);
+        assert_false(cb_program_execute(program, env1));
+        assert_false(cb_program_execute(program, env1));
+        cb_environment_destroy(env1);
+        cb_program_destroy(program);
+        
+        /* semantic error */
+        assert_true(cb_codeblock_parse_string(cb, "undefined_var,"));
+        assert_null(cb_codeblock_compile(cb));
+        
+        /* empty codeblock */
+        assert_true(cb_codeblock_parse_string(cb, ""));
+        program = cb_codeblock_compile(cb);
+        assert_non_null(program);
+        env1 = cb_environment_create(program);
+        assert_true(cb_program_execute(program, env1));
+        assert_true(cb_variant_is_undefined(cb_environment_get_result(env1)));
+        cb_environment_destroy(env1);
+        cb_program_destroy(program);
+    }
+    
+    cb_codeblock_destroy(cb);
+}
+
+/*
+ * Parse and execute codeblocks in several threads at the same time
+ */
+void codeblock_thread_test(void** state)
+{
+    const size_t THREAD_COUNT = 4;
+    pthread_t threads[4];
+    bool results[4];
+    size_t i;
+    
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        results[i] = false;
+        assert_int_equal(0, pthread_create(&threads[i], NULL,
+                                           codeblock_thread_run, &results[i]));
+    }
+    
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        assert_int_equal(0, pthread_join(threads[i], NULL));
+        assert_true(results[i]);
+    }
+}
+/*
+ * Execute a codeblock for many input records
+ */
+void codeblock_batch_test(void** state)
+{
+    const char* const TEST_STRING  = "|price, quantity| price * quantity,";
+    const char* const FAIL_STRING  = "|price, quantity| price / price,";
+    const char* const INPUT_NAMES[] = { "quantity", "price" };
+    const CbCodeblockEngine ENGINES[] = {
+        CB_CODEBLOCK_ENGINE_AST, CB_CODEBLOCK_ENGINE_VM
+    };
+    const size_t THREAD_COUNTS[] = { 1, 4 };
+    const size_t RECORD_COUNT    = 1000;
+    size_t i;
+    size_t engine;
+    size_t threads;
+    CbVariant* inputs  = memalloc(2 * RECORD_COUNT * sizeof(CbVariant));
+    CbVariant* results = memalloc(RECORD_COUNT * sizeof(CbVariant));
+    CbCodeblock* cb    = cb_codeblock_create();
+    
+    for (i = 0; i < RECORD_COUNT; i++)
+    {
+        inputs[i * 2]     = cb_integer_make(i);     /* quantity */
+        inputs[i * 2 + 1] = cb_integer_make(i % 7); /* price    */
+    }
+    
+    for (engine = 0; engine < 2; engine++)
+    {
+        cb_codeblock_set_engine(cb, ENGINES[engine]);
+        
+        for (threads = 0; threads < 2; threads++)
+        {
+            cb_codeblock_set_thread_count(cb, THREAD_COUNTS[threads]);
+            
+            assert_true(cb_codeblock_parse_string(cb, TEST_STRING));
+            assert_true(cb_codeblock_execute_batch(cb, INPUT_NAMES, 2, inputs,
+                                                   RECORD_COUNT, results));
+            for (i = 0; i < RECORD_COUNT; i++)
+            {
+                assert_cb_integer_equal((int) (i * (i % 7)), &results[i]);
+                cb_variant_release(&results[i]);
+            }
+            
+            /* runtime error for a single record (division by zero) */
+            assert_true(cb_codeblock_parse_string(cb, FAIL_STRING));
+            assert_false(cb_codeblock_execute_batch(cb, INPUT_NAMES, 2,
+                                                    inputs + 2, 10, results));
+            for (i = 0; i < 10; i++)
+            {
+                if ((i + 1) % 7 == 0)
+                    assert_true(cb_variant_is_undefined(&results[i]));
+                else
+                    assert_cb_integer_equal(1, &results[i]);
+                cb_variant_release(&results[i]);
+            }
+        }
+    }
+    
+    /* undeclared input variable */
+    assert_true(cb_codeblock_parse_string(cb, "|price| price,"));
+    assert_false(cb_codeblock_execute_batch(cb, INPUT_NAMES, 2, inputs,
+                                            RECORD_COUNT, results));
+    
+    memfree(inputs);
+    memfree(results);
+    cb_codeblock_destroy(cb);
+}
+
+/*
+ * Execute threaded batches with new codeblocks over and over again: The pool
+ * memory of the terminated worker threads must be reused by the next workers.
+ */
+void codeblock_batch_memory_test(void** state)
+{
+    const char* const TEST_STRING   = "|price, quantity| price * quantity,";
+    const char* const INPUT_NAMES[] = { "quantity", "price" };
+    const size_t RECORD_COUNT       = 2048;
+    const int WARMUP_BATCHES        = 3;
+    const int BATCHES               = 50;
+    size_t i;
+    int n;
+    size_t slab_count  = 0;
+    CbVariant* inputs  = memalloc(2 * RECORD_COUNT * sizeof(CbVariant));
+    CbVariant* results = memalloc(RECORD_COUNT * sizeof(CbVariant));
+    CbCodeblock* cb;
+    
+    for (i = 0; i < RECORD_COUNT; i++)
+    {
+        inputs[i * 2]     = cb_integer_make(i);
+        inputs[i * 2 + 1] = cb_integer_make(i % 7);
+    }
+    
+    for (n = 0; n < WARMUP_BATCHES + BATCHES; n++)
+    {
+        if (n == WARMUP_BATCHES)
+            slab_count = mempool_get_slab_count();
+        
+        /* destroying the codeblock terminates its worker threads */
+        cb = cb_codeblock_create();
+        cb_codeblock_set_thread_count(cb, 4);
+        assert_true(cb_codeblock_parse_string(cb, TEST_STRING));
+        assert_true(cb_codeblock_execute_batch(cb, INPUT_NAMES, 2, inputs,
+                                               RECORD_COUNT, results));
+        for (i = 0; i < RECORD_COUNT; i++)
+            cb_variant_release(&results[i]);
+        cb_codeblock_destroy(cb);
+    }
+    assert_int_equal(slab_count, mempool_get_slab_count());
+    
+    memfree(inputs);
+    memfree(results);
+}
+
+/*
+ * Parse and execute a codeblock with a very long statement list
+ */
+void codeblock_long_test(void** state)
+{
+    const char* const HEADER    = "|a| a := 0, ";
+    const char* const STATEMENT = "a := a + 1, ";
+    const char* const FOOTER    = "a,";
+    const CbCodeblockEngine ENGINES[] = {
+        CB_CODEBLOCK_ENGINE_AST, CB_CODEBLOCK_ENGINE_VM
+    };
+    const int STATEMENT_COUNT = 100000;
+    size_t length = strlen(HEADER) + strlen(FOOTER) +
+                    STATEMENT_COUNT * strlen(STATEMENT) + 1;
+    char* source  = memalloc(length);
+    char* end     = source;
+    size_t i;
+    int n;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    end += sprintf(end, "%s", HEADER);
+    for (n = 0; n < STATEMENT_COUNT; n++)
+        end += sprintf(end, "%s", STATEMENT);
+    sprintf(end, "%s", FOOTER);
+    
+    for (i = 0; i < sizeof(ENGINES) / sizeof(ENGINES[0]); i++)
+    {
+        cb_codeblock_set_engine(cb, ENGINES[i]);
+        assert_true(cb_codeblock_parse_string(cb, source));
+        assert_true(cb_codeblock_execute(cb));
+        assert_cb_integer_equal(STATEMENT_COUNT, cb_codeblock_get_result(cb));
+    }
+    
+    memfree(source);
+    cb_codeblock_destroy(cb);
+}
+
+/*
+ * Execute a codeblock with profiling enabled
+ */
+void codeblock_profiler_test(void** state)
+{
+    const char* const TEST_STRING =
+        "|a, b| b := 0, a := 4,\n"
+        "while a > 0 do b := b + a, a := a - 1, end,\n"
+        "b * 2,";
+    const int TEST_RESULT = 20;
+    const CbAstProfiler* profiler;
+    FILE* report;
+    char line[64];
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    assert_true(cb_codeblock_parse_string(cb, TEST_STRING));
+    assert_true(cb_codeblock_execute(cb));
+    assert_null(cb_codeblock_get_profiler(cb));
+    
+    cb_codeblock_set_profiling(cb, true);
+    assert_true(cb_codeblock_parse_string(cb, TEST_STRING));
+    assert_true(cb_codeblock_execute(cb));
+    assert_cb_integer_equal(TEST_RESULT, cb_codeblock_get_result(cb));
+    
+    profiler = cb_codeblock_get_profiler(cb);
+    assert_non_null(profiler);
+    assert_int_equal(2, cb_ast_profiler_get_count(profiler, 1,
+                                                  CB_AST_TYPE_ASSIGNMENT));
+    assert_int_equal(1, cb_ast_profiler_get_count(profiler, 2,
+                                                  CB_AST_TYPE_CONTROL_FLOW));
+    assert_int_equal(8, cb_ast_profiler_get_count(profiler, 2,
+                                                  CB_AST_TYPE_ASSIGNMENT));
+    /* "a > 0" is evaluated once more than the loop body */
+    assert_int_equal(13, cb_ast_profiler_get_count(profiler, 2,
+                                                   CB_AST_TYPE_BINARY));
+    
+    report = tmpfile();
+    cb_ast_profiler_report(profiler, CB_AST_PROFILER_FORMAT_CSV, report);
+    fseek(report, 0, SEEK_SET);
+    assert_non_null(fgets(line, sizeof(line), report));
+    assert_string_equal("line,kind,count,inclusive_ns,exclusive_ns\n", line);
+    fclose(report);
+    
+    /* the profile is released along with the AST */
+    assert_true(cb_codeblock_parse_string(cb, TEST_STRING));
+    assert_null(cb_codeblock_get_profiler(cb));
+    
+    cb_codeblock_destroy(cb);
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -62,3 +363,49 @@ static FILE* write_temp_file(const char* content)
     
     return f;
 }
+
+static void* codeblock_thread_run(void* data)
+{
+    const char* const TEST_STRING =
+        "|a, b| b := 0, a := 4,\n"
+        "while a > 0 do b := b + a, a := a - 1, end,\n"
+        "b * 2,";
+    const int ITERATIONS  = 200;
+    const int TEST_RESULT = 20;
+    int i;
+    const CbVariant* result;
+    bool* success   = data;
+    FILE* errors    = tmpfile();
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    /* error handling needs to be initialized in each thread */
+    cb_error_initialize(errors);
+    
+    *success = true;
+    for (i = 0; i < ITERATIONS && *success; i++)
+    {
+        cb_codeblock_set_engine(cb, (i % 2) ? CB_CODEBLOCK_ENGINE_VM :
+                                              CB_CODEBLOCK_ENGINE_AST);
+        *success = cb_codeblock_parse_string(cb, TEST_STRING) &&
+                   cb_codeblock_execute(cb);
+        
+        if (*success)
+        {
+            result   = cb_codeblock_get_result(cb);
+            *success = cb_variant_is_integer(result) &&
+                       cb_integer_get_value(result) == TEST_RESULT;
+        }
+        
+        /* errors must be reported in the thread they occur */
+        if (*success)
+            *success = cb_codeblock_parse_string(cb, "undefined_var,") &&
+                       !cb_codeblock_execute(cb) &&
+                       !cb_error_occurred();
+    }
+    
+    cb_error_finalize();
+    cb_codeblock_destroy(cb);
+    fclose(errors);
+    
+    return NULL;
+}
@@ -0,0 +1,205 @@
+/*******************************************************************************
+ * Tests for the columnar evaluation of pure expressions
+ ******************************************************************************/
+
+#include "../src/utils.h"
+#include "../src/codeblock.h"
+#include "../src/columnar.h"
+#include "test.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+static const char* const INPUT_NAMES[] = { "a", "b", "x", "flag" };
+
+#define ROW_COUNT 3000 /* more than a single block of rows */
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Evaluate a codeblock in columnar mode and row by row and compare the results.
+ */
+static void assert_columnar_equal(const char* source,
+                                  const CbColumn* columns,
+                                  size_t row_count);
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Compare the columnar evaluation with the row by row evaluation
+ */
+void columnar_common_test(void** state)
+{
+    const char* const SOURCES[] = {
+        "|a, b, x, flag| a * b - 3,",
+        "|a, b, x, flag| a / b,",           /* integer and float results */
+        "|a, b, x, flag| (a * 2) / 2,",     /* integer results only      */
+        "|a, b, x, flag| a / (b * 1000),",  /* float results only        */
+        "|a, b, x, flag| a / b + x,",
+        "|a, b, x, flag| x * 2 >= a / b,",
+        "|a, b, x, flag| x == 0.1 * (a + 1) or x <> a - 1.5,",
+        "|a, b, x, flag| -a < -x and not flag,",
+        "|a, b, x, flag| flag == (a > 100) and True,",
+        "|a, b, x, flag| 7,",
+        "|a, b, x, flag| -(a / b),",
+        NULL
+    };
+    const char* const* source;
+    CbIntegerDataType a[ROW_COUNT];
+    CbIntegerDataType b[ROW_COUNT];
+    CbFloatDataType x[ROW_COUNT];
+    CbBooleanDataType flag[ROW_COUNT];
+    CbColumn columns[4];
+    size_t i;
+    
+    for (i = 0; i < ROW_COUNT; i++)
+    {
+        a[i]    = (CbIntegerDataType) i;
+        b[i]    = (CbIntegerDataType) (i % 9) + 1;
+        x[i]    = (CbFloatDataType) (i + 1) / 10.0;
+        flag[i] = (i % 3) == 0;
+    }
+    
+    columns[0] = cb_integer_column(a);
+    columns[1] = cb_integer_column(b);
+    columns[2] = cb_float_column(x);
+    columns[3] = cb_boolean_column(flag);
+    
+    for (source = SOURCES; *source != NULL; source++)
+        assert_columnar_equal(*source, columns, ROW_COUNT);
+}
+
+/*
+ * Test CbColumnarProgram directly and its error handling
+ */
+void columnar_program_test(void** state)
+{
+    CbIntegerDataType a[] = { 4, 6, 8 };
+    CbIntegerDataType b[] = { 2, 0, 4 };
+    CbBooleanDataType flag[] = { true, true, true };
+    CbColumn columns[2];
+    CbVariant results[3];
+    size_t slots[2];
+    CbProgram* program;
+    CbColumnarProgram* columnar;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    columns[0] = cb_integer_column(a);
+    columns[1] = cb_integer_column(b);
+    
+    assert_true(cb_codeblock_parse_string(cb, "|a, b| a / b,"));
+    program = cb_codeblock_compile(cb);
+    assert_non_null(program);
+    assert_true(cb_program_lookup_variable(program, "a", &slots[0]));
+    assert_true(cb_program_lookup_variable(program, "b", &slots[1]));
+    
+    columnar = cb_columnar_program_create(program);
+    assert_non_null(columnar);
+    
+    /* exact division */
+    assert_true(cb_columnar_program_execute(columnar, slots, columns, 2, 1,
+                                            results));
+    assert_cb_integer_equal(2, &results[0]);
+    
+    /* division by zero: all results are undefined */
+    assert_false(cb_columnar_program_execute(columnar, slots, columns, 2, 3,
+                                             results));
+    assert_true(cb_variant_is_undefined(&results[0]));
+    assert_true(cb_variant_is_undefined(&results[2]));
+    
+    /* unbound input variable */
+    assert_false(cb_columnar_program_execute(columnar, slots, columns, 1, 1,
+                                             results));
+    
+    cb_columnar_program_destroy(columnar);
+    cb_program_destroy(program);
+    
+    /* no pure expression */
+    assert_true(cb_codeblock_parse_string(cb, "|a, b| a := a + b, a,"));
+    program = cb_codeblock_compile(cb);
+    assert_non_null(program);
+    assert_null(cb_columnar_program_create(program));
+    cb_program_destroy(program);
+    
+    /* ... is evaluated row by row */
+    assert_true(cb_codeblock_parse_string(cb, "|a, b| a := a + b, a,"));
+    assert_true(cb_codeblock_execute_columns(cb, INPUT_NAMES, columns, 2, 3,
+                                             results));
+    assert_cb_integer_equal(6, &results[0]);
+    assert_cb_integer_equal(6, &results[1]);
+    assert_cb_integer_equal(12, &results[2]);
+    
+    /* a guarded division must be short-circuited -> row by row as well */
+    assert_true(cb_codeblock_parse_string(cb, "|a, b| b <> 0 and a / b > 1,"));
+    program = cb_codeblock_compile(cb);
+    assert_non_null(program);
+    assert_null(cb_columnar_program_create(program));
+    cb_program_destroy(program);
+    
+    assert_true(cb_codeblock_parse_string(cb, "|a, b| b <> 0 and a / b > 1,"));
+    assert_true(cb_codeblock_execute_columns(cb, INPUT_NAMES, columns, 2, 3,
+                                             results));
+    assert_cb_boolean_equal(true, &results[0]);
+    assert_cb_boolean_equal(false, &results[1]);
+    assert_cb_boolean_equal(true, &results[2]);
+    
+    /* a guarded type error must be short-circuited as well */
+    columns[0] = cb_boolean_column(flag);
+    assert_true(cb_codeblock_parse_string(cb, "|a, b| a or (b > a),"));
+    program = cb_codeblock_compile(cb);
+    assert_non_null(program);
+    assert_null(cb_columnar_program_create(program));
+    cb_program_destroy(program);
+    
+    assert_true(cb_codeblock_parse_string(cb, "|a, b| a or (b > a),"));
+    assert_true(cb_codeblock_execute_columns(cb, INPUT_NAMES, columns, 2, 3,
+                                             results));
+    assert_cb_boolean_equal(true, &results[0]);
+    assert_cb_boolean_equal(true, &results[1]);
+    assert_cb_boolean_equal(true, &results[2]);
+    
+    cb_codeblock_destroy(cb);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static void assert_columnar_equal(const char* source,
+                                  const CbColumn* columns,
+                                  size_t row_count)
+{
+    size_t i;
+    size_t k;
+    CbVariant* expected = memalloc(row_count * sizeof(CbVariant));
+    CbVariant* actual   = memalloc(row_count * sizeof(CbVariant));
+    CbVariant* inputs   = memalloc(4 * row_count * sizeof(CbVariant));
+    CbCodeblock* cb     = cb_codeblock_create();
+    
+    for (i = 0; i < row_count; i++)
+    {
+        for (k = 0; k < 4; k++)
+            inputs[i * 4 + k] = cb_column_get_value(&columns[k], i);
+    }
+    
+    assert_true(cb_codeblock_parse_string(cb, source));
+    assert_true(cb_codeblock_execute_batch(cb, INPUT_NAMES, 4, inputs,
+                                           row_count, expected));
+    
+    assert_true(cb_codeblock_parse_string(cb, source));
+    assert_true(cb_codeblock_execute_columns(cb, INPUT_NAMES, columns, 4,
+                                             row_count, actual));
+    
+    for (i = 0; i < row_count; i++)
+    {
+        assert_cb_variant_equal(&expected[i], &actual[i]);
+        cb_variant_release(&expected[i]);
+        cb_variant_release(&actual[i]);
+    }
+    
+    memfree(expected);
+    memfree(actual);
+    memfree(inputs);
+    cb_codeblock_destroy(cb);
+}
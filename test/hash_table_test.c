@@ -68,3 +68,82 @@ void hashtable_insert_remove_test(void** state)
         assert_int_equal(true, cb_hash_table_remove(ht, key));
     }
 }
+
+void hash_table_replace_test(void** state)
+{
+    CbHashTable* ht  = *state;
+    TestDummy* dummy = NULL;
+    
+    cb_hash_table_insert(ht, "test", dummy_create(1));
+    cb_hash_table_insert(ht, "test", dummy_create(2));
+    assert_int_equal(1, cb_hash_table_get_count(ht));
+    
+    dummy = cb_hash_table_get(ht, "test");
+    assert_non_null(dummy);
+    assert_int_equal(2, dummy->id);
+    
+    assert_int_equal(true, cb_hash_table_remove(ht, "test"));
+    assert_null(cb_hash_table_get(ht, "test"));
+    assert_int_equal(0, cb_hash_table_get_count(ht));
+}
+
+/*
+ * Test a hash table, where all keys collide (internal)
+ */
+static CbHashSize test_hash_table_collide(const char* key)
+{
+    return 42;
+}
+
+void hash_table_collision_test(void** state)
+{
+    CbHashTable* ht  = cb_hash_table_create(4, test_hash_table_collide, free);
+    TestDummy* dummy = NULL;
+    int i;
+    
+    for (i = 0; i < 100; i++)
+    {
+        char key[16];
+        sprintf(key, "test_%d", i);
+        cb_hash_table_insert(ht, key, dummy_create(i));
+    }
+    assert_int_equal(100, cb_hash_table_get_count(ht));
+    
+    /* remove every second item from the middle of the cluster */
+    for (i = 0; i < 100; i += 2)
+    {
+        char key[16];
+        sprintf(key, "test_%d", i);
+        assert_int_equal(true, cb_hash_table_remove(ht, key));
+    }
+    assert_int_equal(50, cb_hash_table_get_count(ht));
+    
+    for (i = 0; i < 100; i++)
+    {
+        char key[16];
+        sprintf(key, "test_%d", i);
+        dummy = cb_hash_table_get(ht, key);
+        
+        if (i % 2 == 0)
+            assert_null(dummy);
+        else
+        {
+            assert_non_null(dummy);
+            assert_int_equal(i, dummy->id);
+        }
+    }
+    
+    /* anagrams with the default hash function */
+    cb_hash_table_destroy(ht);
+    ht = cb_hash_table_create(4, NULL, free);
+    cb_hash_table_insert(ht, "abc", dummy_create(1));
+    cb_hash_table_insert(ht, "cba", dummy_create(2));
+    cb_hash_table_insert(ht, "bca", dummy_create(3));
+    assert_int_equal(3, cb_hash_table_get_count(ht));
+    assert_int_equal(1, ((TestDummy*) cb_hash_table_get(ht, "abc"))->id);
+    assert_int_equal(2, ((TestDummy*) cb_hash_table_get(ht, "cba"))->id);
+    assert_int_equal(3, ((TestDummy*) cb_hash_table_get(ht, "bca"))->id);
+    assert_null(cb_hash_table_get(ht, "bac"));
+    
+    cb_hash_table_destroy(ht);
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Tests for the identifier intern pool
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/intern.h"
+#include "../src/hash_table.h"
+#include "test.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+void intern_common_test(void** state)
+{
+    char buffer[32];
+    const char* identifier;
+    CbHashTable* ht;
+    int i;
+    
+    assert_null(cb_intern_find("intern_test_unknown"));
+    
+    /* equal strings are interned once */
+    identifier = cb_intern("intern_test");
+    sprintf(buffer, "intern_%s", "test");
+    assert_ptr_equal(identifier, cb_intern(buffer));
+    assert_ptr_equal(identifier, cb_intern_find(buffer));
+    assert_true(identifier != cb_intern("intern_tset"));
+    assert_string_equal("intern_test", identifier);
+    assert_int_equal(cb_hash_table_hash_string("intern_test"),
+                     cb_intern_hash(identifier));
+    
+    /* interned identifiers stay valid, while the pool grows */
+    for (i = 0; i < 1000; i++)
+    {
+        sprintf(buffer, "intern_test_%d", i);
+        cb_intern(buffer);
+    }
+    assert_ptr_equal(identifier, cb_intern("intern_test"));
+    
+    /* hash table with interned keys */
+    ht = cb_hash_table_create_interned(4, free);
+    for (i = 0; i < 100; i++)
+    {
+        sprintf(buffer, "intern_test_%d", i);
+        cb_hash_table_insert(ht, cb_intern(buffer), dummy_create(i));
+    }
+    for (i = 0; i < 100; i++)
+    {
+        TestDummy* dummy;
+        
+        sprintf(buffer, "intern_test_%d", i);
+        dummy = cb_hash_table_get(ht, cb_intern_find(buffer));
+        assert_non_null(dummy);
+        assert_int_equal(i, dummy->id);
+    }
+    assert_true(cb_hash_table_remove(ht, cb_intern("intern_test_50")));
+    assert_null(cb_hash_table_get(ht, cb_intern("intern_test_50")));
+    cb_hash_table_destroy(ht);
+}
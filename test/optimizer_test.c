@@ -0,0 +1,324 @@
+/*******************************************************************************
+ * Tests for the AST optimizer (constant folding and type specialization)
+ ******************************************************************************/
+
+#include "../src/utils.h"
+#include "../src/error_handling.h"
+#include "../src/arena.h"
+#include "../src/intern.h"
+#include "../src/symbol_table.h"
+#include "../src/ast.h"
+#include "../src/ast_value.h"
+#include "../src/ast_binary.h"
+#include "../src/ast_logical.h"
+#include "../src/ast_unary.h"
+#include "../src/ast_variable.h"
+#include "../src/ast_assignment.h"
+#include "../src/ast_declaration.h"
+#include "../src/ast_statement_list.h"
+#include "../src/ast_control_flow.h"
+#include "../src/optimizer.h"
+#include "../src/codeblock.h"
+#include "test.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+/*
+ * Create a value node (takes ownership of value)
+ */
+static CbAstNode* test_create_value_node(CbArena* arena, CbVariant* value);
+
+/*
+ * Fold a binary operation with constant operands and compare the folded value
+ * with the result of the evaluation of the original operation.
+ */
+static void assert_binary_folded(CbBinaryOperatorType operator_type,
+                                 CbVariant* left,
+                                 CbVariant* right);
+
+/*
+ * Optimize "|a| [a := <value>,] a * 2," and return the type, the operation was
+ * specialized for (value might be NULL).
+ */
+static CbVariantType test_specialize_operation(CbVariant* value);
+
+
+/* -------------------------------------------------------------------------- */
+
+void optimizer_fold_test(void** state)
+{
+    CbArena* arena = cb_arena_create();
+    CbAstNode* node;
+    CbVariant* value;
+    
+    /* folded values equal the evaluated values */
+    assert_binary_folded(CB_BINARY_OPERATOR_TYPE_MUL, cb_integer_create(60),       cb_integer_create(24));
+    assert_binary_folded(CB_BINARY_OPERATOR_TYPE_DIV, cb_integer_create(8),        cb_integer_create(2));
+    assert_binary_folded(CB_BINARY_OPERATOR_TYPE_DIV, cb_integer_create(7),        cb_integer_create(2));
+    assert_binary_folded(CB_BINARY_OPERATOR_TYPE_DIV, cb_float_create(7.5),        cb_integer_create(3));
+    assert_binary_folded(CB_BINARY_OPERATOR_TYPE_SUB, cb_integer_create(1),        cb_float_create(0.25));
+    assert_binary_folded(CB_BINARY_OPERATOR_TYPE_ADD, cb_string_create("prefix"),  cb_string_create("suffix"));
+    assert_binary_folded(CB_BINARY_OPERATOR_TYPE_COMPARISON_EQ, cb_integer_create(1), cb_float_create(1));
+    assert_binary_folded(CB_BINARY_OPERATOR_TYPE_COMPARISON_LE, cb_float_create(0.1), cb_float_create(0.1));
+    
+    /* nested operations: 60 * 60 * 24 */
+    node = (CbAstNode*) cb_ast_binary_node_create(
+        arena, CB_BINARY_OPERATOR_TYPE_MUL,
+        (CbAstNode*) cb_ast_binary_node_create(
+            arena, CB_BINARY_OPERATOR_TYPE_MUL,
+            test_create_value_node(arena, cb_integer_create(60)),
+            test_create_value_node(arena, cb_integer_create(60))
+        ),
+        test_create_value_node(arena, cb_integer_create(24))
+    );
+    assert_true(cb_optimizer_optimize(arena, &node));
+    assert_int_equal(CB_AST_TYPE_VALUE, cb_ast_node_get_type(node));
+    assert_cb_integer_equal(
+        86400, cb_ast_value_node_get_value((const CbAstValueNode*) node)
+    );
+    
+    /* unary operation: not False */
+    node = (CbAstNode*) cb_ast_unary_node_create(
+        arena, CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT,
+        test_create_value_node(arena, cb_boolean_create(false))
+    );
+    assert_true(cb_optimizer_optimize(arena, &node));
+    assert_int_equal(CB_AST_TYPE_VALUE, cb_ast_node_get_type(node));
+    assert_cb_boolean_equal(
+        true, cb_ast_value_node_get_value((const CbAstValueNode*) node)
+    );
+    
+    /* logical operation, that is decided by its left operand */
+    node = (CbAstNode*) cb_ast_logical_node_create(
+        arena, CB_BINARY_OPERATOR_TYPE_LOGICAL_AND,
+        test_create_value_node(arena, cb_boolean_create(false)),
+        (CbAstNode*) cb_ast_unary_node_create(
+            arena, CB_UNARY_OPERATOR_TYPE_LOGICAL_NOT,
+            (CbAstNode*) cb_ast_variable_node_create(arena, cb_intern("flag"))
+        )
+    );
+    assert_true(cb_optimizer_optimize(arena, &node));
+    assert_int_equal(CB_AST_TYPE_VALUE, cb_ast_node_get_type(node));
+    assert_cb_boolean_equal(
+        false, cb_ast_value_node_get_value((const CbAstValueNode*) node)
+    );
+    
+    /* ... unless a variable of unknown type is evaluated anyway */
+    node = (CbAstNode*) cb_ast_logical_node_create(
+        arena, CB_BINARY_OPERATOR_TYPE_LOGICAL_AND,
+        test_create_value_node(arena, cb_boolean_create(false)),
+        (CbAstNode*) cb_ast_variable_node_create(arena, cb_intern("flag"))
+    );
+    assert_true(cb_optimizer_optimize(arena, &node));
+    assert_int_equal(CB_AST_TYPE_LOGICAL, cb_ast_node_get_type(node));
+    
+    /* ... otherwise the type of the right operand must still be checked */
+    node = (CbAstNode*) cb_ast_logical_node_create(
+        arena, CB_BINARY_OPERATOR_TYPE_LOGICAL_AND,
+        test_create_value_node(arena, cb_boolean_create(true)),
+        (CbAstNode*) cb_ast_variable_node_create(arena, cb_intern("flag"))
+    );
+    assert_true(cb_optimizer_optimize(arena, &node));
+    assert_int_equal(CB_AST_TYPE_LOGICAL, cb_ast_node_get_type(node));
+    
+    /* if-statement with a constant condition */
+    node = (CbAstNode*) cb_ast_if_node_create(
+        arena,
+        (CbAstNode*) cb_ast_binary_node_create(
+            arena, CB_BINARY_OPERATOR_TYPE_COMPARISON_GT,
+            test_create_value_node(arena, cb_integer_create(2)),
+            test_create_value_node(arena, cb_integer_create(1))
+        ),
+        test_create_value_node(arena, cb_string_create("then")),
+        test_create_value_node(arena, cb_string_create("else"))
+    );
+    assert_true(cb_optimizer_optimize(arena, &node));
+    assert_int_equal(CB_AST_TYPE_VALUE, cb_ast_node_get_type(node));
+    value = cb_string_create("then");
+    assert_cb_variant_equal(
+        value, cb_ast_value_node_get_value((const CbAstValueNode*) node)
+    );
+    cb_variant_destroy(value);
+    
+    /* ... without the taken branch */
+    node = (CbAstNode*) cb_ast_if_node_create(
+        arena,
+        test_create_value_node(arena, cb_boolean_create(false)),
+        test_create_value_node(arena, cb_integer_create(1)),
+        NULL
+    );
+    assert_true(cb_optimizer_optimize(arena, &node));
+    assert_int_equal(CB_AST_TYPE_VALUE, cb_ast_node_get_type(node));
+    assert_true(cb_variant_is_undefined(
+        cb_ast_value_node_get_value((const CbAstValueNode*) node)
+    ));
+    
+    cb_arena_destroy(arena);
+}
+
+void optimizer_error_test(void** state)
+{
+    const char* const SOURCES[] = {
+        "if 1 > 2 then 7 / 0, else 5, endif,",
+        "|a| a := 5, False and a / 0 > 1 or a = 5,",
+        "while False do 1 / 0, end, 5 = 5.0,",
+        NULL
+    };
+    const CbCodeblockEngine ENGINES[] = {
+        CB_CODEBLOCK_ENGINE_AST, CB_CODEBLOCK_ENGINE_VM
+    };
+    const char* const* source;
+    char buffer[128];
+    size_t i;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    for (i = 0; i < sizeof(ENGINES) / sizeof(ENGINES[0]); i++)
+    {
+        cb_codeblock_set_engine(cb, ENGINES[i]);
+        
+        /* constant division by zero */
+        assert_true(cb_codeblock_parse_string(cb, "|a| a := 1, a + 7 / 0,"));
+        assert_false(cb_codeblock_execute(cb));
+        stream_to_string(*state, buffer, true);
+        assert_string_equal("semantic error: line 1: Division by zero is not "\
+                            "allowed", buffer);
+        resetup_error_handling(state);
+        
+        assert_true(cb_codeblock_parse_string(cb, "|a| a := 1, a + 7 / 0,"));
+        assert_null(cb_codeblock_compile(cb));
+        resetup_error_handling(state);
+        
+        /* ... is no error in a statement, that is never executed */
+        for (source = SOURCES; *source != NULL; source++)
+        {
+            assert_true(cb_codeblock_parse_string(cb, *source));
+            assert_true(cb_codeblock_execute(cb));
+        }
+    }
+    
+    cb_codeblock_destroy(cb);
+}
+
+void optimizer_specialize_test(void** state)
+{
+    const char* const TEST_STRINGS[][2] = {
+        { "|a| a := 1, while a < 10 do a := a * 1.5, end, a,", "11.390625" },
+        { "|a, s| s := 'x', a := 0, "\
+          "while a < 3 do s := s + 'y', a := a + 1, end, s,", "xyyy" },
+        { "|a, b| a := 2, if a > 1 then b := 0.5, else b := 1, endif, "\
+          "b * 4 + a,", "4.000000" },
+        { "|a| a := 3, a := a + (a := 0.5), a * 2,", "7.000000" },
+        { "|a| a := 7, a / 2 * 2,", "7.000000" },
+        { "|a, b| a := 1.0, b := 3, "\
+          "while b > 0 do a := a * 2 + b, b := b - 1, end, a,", "25.000000" },
+        { "|s| s := 'ab', s := s + 'c' + s, s,", "abcab" },
+        { NULL, NULL }
+    };
+    size_t i;
+    char* actual;
+    
+    /* operands of a known type */
+    assert_int_equal(CB_VARIANT_TYPE_INTEGER,
+                     test_specialize_operation(cb_integer_create(3)));
+    /* ... the integer constant is converted to float */
+    assert_int_equal(CB_VARIANT_TYPE_FLOAT,
+                     test_specialize_operation(cb_float_create(1.5)));
+    /* ... no specialization for an unknown type */
+    assert_int_equal(CB_VARIANT_TYPE_UNDEFINED,
+                     test_specialize_operation(cb_string_create("a")));
+    assert_int_equal(CB_VARIANT_TYPE_UNDEFINED,
+                     test_specialize_operation(NULL));
+    
+    /* specialized operations yield the same results as generic operations */
+    for (i = 0; TEST_STRINGS[i][0] != NULL; i++)
+    {
+        actual = execute_with_engine(TEST_STRINGS[i][0],
+                                     CB_CODEBLOCK_ENGINE_AST);
+        assert_non_null(actual);
+        assert_string_equal(TEST_STRINGS[i][1], actual);
+        memfree(actual);
+        
+        actual = execute_with_engine(TEST_STRINGS[i][0],
+                                     CB_CODEBLOCK_ENGINE_VM);
+        assert_non_null(actual);
+        assert_string_equal(TEST_STRINGS[i][1], actual);
+        memfree(actual);
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+static CbAstNode* test_create_value_node(CbArena* arena, CbVariant* value)
+{
+    CbAstNode* node = (CbAstNode*) cb_ast_value_node_create(arena, value);
+    cb_variant_destroy(value);
+    
+    return node;
+}
+
+static void assert_binary_folded(CbBinaryOperatorType operator_type,
+                                 CbVariant* left,
+                                 CbVariant* right)
+{
+    CbArena* arena = cb_arena_create();
+    CbVariant* expected;
+    CbAstNode* node = (CbAstNode*) cb_ast_binary_node_create(
+        arena, operator_type,
+        test_create_value_node(arena, left),
+        test_create_value_node(arena, right)
+    );
+    
+    expected = cb_ast_node_eval(node, NULL);
+    assert_non_null(expected);
+    
+    assert_true(cb_optimizer_optimize(arena, &node));
+    assert_int_equal(CB_AST_TYPE_VALUE, cb_ast_node_get_type(node));
+    assert_cb_variant_equal(
+        expected, cb_ast_value_node_get_value((const CbAstValueNode*) node)
+    );
+    
+    cb_variant_destroy(expected);
+    cb_arena_destroy(arena);
+}
+
+static CbVariantType test_specialize_operation(CbVariant* value)
+{
+    CbVariantType result;
+    CbAstNode* statement;
+    CbArena* arena               = cb_arena_create();
+    CbSymbolTable* symbols       = cb_symbol_table_create();
+    const char* identifier       = cb_intern("a");
+    CbAstStatementListNode* list = cb_ast_statement_list_node_create(arena);
+    CbAstNode* node              = (CbAstNode*) list;
+    CbAstBinaryNode* operation   = cb_ast_binary_node_create(
+        arena, CB_BINARY_OPERATOR_TYPE_MUL,
+        (CbAstNode*) cb_ast_variable_node_create(arena, identifier),
+        test_create_value_node(arena, cb_integer_create(2))
+    );
+    
+    statement = (CbAstNode*) cb_ast_declaration_node_create(
+        arena, CB_AST_DECLARATION_TYPE_VARIABLE, identifier
+    );
+    cb_ast_statement_list_node_add(list, statement);
+    if (value != NULL)
+    {
+        statement = (CbAstNode*) cb_ast_assignment_node_create(
+            arena,
+            (CbAstNode*) cb_ast_variable_node_create(arena, identifier),
+            test_create_value_node(arena, value)
+        );
+        cb_ast_statement_list_node_add(list, statement);
+    }
+    cb_ast_statement_list_node_add(list, (CbAstNode*) operation);
+    
+    assert_true(cb_ast_node_check_semantic(node, symbols));
+    assert_true(cb_optimizer_optimize(arena, &node));
+    result = cb_ast_binary_node_get_operand_type(operation);
+    
+    cb_symbol_table_destroy(symbols);
+    cb_arena_destroy(arena);
+    
+    return result;
+}
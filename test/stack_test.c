@@ -52,7 +52,7 @@ void stack_push_pop_test(void** state)
     assert_true(cb_stack_is_empty(stack));
     assert_null(cb_stack_get_top_item(stack));
     
-    /* push 100 items onto the stack */
+    /* push 100 items onto the stack (the stack grows several times) */
     for (; i < 100; i++)
     {
         TestDummy* dummy = dummy_create(i);
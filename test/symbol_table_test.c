@@ -2,6 +2,9 @@
  * Tests for CbSymbolTable
  ******************************************************************************/
 
+#include <stdio.h>
+
+#include "../src/intern.h"
 #include "../src/symbol_table.h"
 #include "../src/symbol_variable.h"
 #include "test.h"
@@ -25,9 +28,9 @@ void teardown_symbol_table(void** state)
 void symbol_table_common_test(void** state)
 {
     const CbSymbol* symbol;
-    CbSymbol* test1   = (CbSymbol*) cb_symbol_variable_create("test_var");
-    CbSymbol* test2   = (CbSymbol*) cb_symbol_variable_create("test_var2");
-    CbSymbol* test3   = (CbSymbol*) cb_symbol_variable_create("test_var3");
+    CbSymbol* test1   = (CbSymbol*) cb_symbol_variable_create(cb_intern("test_var"));
+    CbSymbol* test2   = (CbSymbol*) cb_symbol_variable_create(cb_intern("test_var2"));
+    CbSymbol* test3   = (CbSymbol*) cb_symbol_variable_create(cb_intern("test_var3"));
     CbSymbolTable* st = cb_symbol_table_create();
     
     assert_null(cb_symbol_table_insert(st, test1));
@@ -43,6 +46,11 @@ void symbol_table_common_test(void** state)
     assert_non_null(symbol);
     assert_true(cb_symbol_is_variable(symbol));
     
+    /* symbols are assigned a slot in the frame of the declaring scope */
+    assert_int_equal(0, cb_symbol_get_scope_depth(test1));
+    assert_int_equal(0, cb_symbol_get_slot(test1));
+    assert_ptr_equal(test1, cb_symbol_table_get_slot(st, 0, 0));
+    
     /* enter nested scope */
     cb_symbol_table_enter_scope(st);
         assert_null(cb_symbol_table_insert(st, test2));
@@ -69,6 +77,10 @@ void symbol_table_common_test(void** state)
             /* test_var2 should not be available in this scope */
             symbol = cb_symbol_table_lookup(st, "test_var2");
             assert_null(symbol);
+            
+            assert_int_equal(1, cb_symbol_get_scope_depth(test3));
+            assert_ptr_equal(test3, cb_symbol_table_get_slot(st, 1, 0));
+            assert_ptr_equal(test1, cb_symbol_table_get_slot(st, 0, 0));
         cb_symbol_table_leave_scope(st);
     cb_symbol_table_leave_scope(st);
     
@@ -77,3 +89,89 @@ void symbol_table_common_test(void** state)
     
     cb_symbol_table_destroy(st);
 }
+
+void symbol_table_frame_test(void** state)
+{
+    int i;
+    int round;
+    char identifier[16];
+    CbSymbol* symbol;
+    CbScope* scopes[40];
+    CbScopeFrames* frames;
+    CbSymbolTable* st = cb_symbol_table_create();
+    
+    assert_null(cb_symbol_table_insert(
+        st, (CbSymbol*) cb_symbol_variable_create(cb_intern("var_0"))
+    ));
+    
+    /* the frames of left scopes are reused by the next scope */
+    for (round = 0; round < 2; round++)
+    {
+        cb_symbol_table_enter_scope(st);
+        
+        /* large scopes are indexed, small ones are searched linearly */
+        for (i = 1; i <= 20; i++)
+        {
+            sprintf(identifier, "var_%d", i);
+            symbol = (CbSymbol*) cb_symbol_variable_create(cb_intern(identifier));
+            assert_null(cb_symbol_table_insert(st, symbol));
+            assert_int_equal(i - 1, cb_symbol_get_slot(symbol));
+            assert_ptr_equal(symbol, cb_symbol_table_lookup(st, identifier));
+        }
+        
+        for (i = 1; i <= 20; i++)
+        {
+            sprintf(identifier, "var_%d", i);
+            symbol = cb_symbol_table_lookup(st, identifier);
+            assert_non_null(symbol);
+            assert_int_equal(1, cb_symbol_get_scope_depth(symbol));
+            assert_ptr_equal(symbol,
+                             cb_symbol_table_get_slot(st, 1, i - 1));
+        }
+        
+        /* the global symbol is still visible */
+        symbol = cb_symbol_table_lookup(st, "var_0");
+        assert_non_null(symbol);
+        assert_int_equal(0, cb_symbol_get_scope_depth(symbol));
+        
+        cb_symbol_table_leave_scope(st);
+        assert_null(cb_symbol_table_lookup(st, "var_1"));
+    }
+    
+    /* cached lookups respect symbols, that are shadowed later on */
+    symbol = cb_symbol_table_lookup(st, "var_0");
+    assert_ptr_equal(symbol, cb_symbol_table_lookup(st, "var_0"));
+    cb_symbol_table_enter_scope(st);
+    assert_ptr_equal(symbol, cb_symbol_table_lookup(st, "var_0"));
+    assert_null(cb_symbol_table_insert(
+        st, (CbSymbol*) cb_symbol_variable_create(cb_intern("var_0"))
+    ));
+    assert_int_equal(1, cb_symbol_get_scope_depth(
+        cb_symbol_table_lookup(st, "var_0")
+    ));
+    cb_symbol_table_leave_scope(st);
+    assert_ptr_equal(symbol, cb_symbol_table_lookup(st, "var_0"));
+    
+    cb_symbol_table_destroy(st);
+    
+    /* scope records keep their address, while more scopes are nested */
+    frames    = cb_scope_frames_create();
+    scopes[0] = cb_scope_create(NULL, frames);
+    for (i = 1; i < 40; i++)
+        scopes[i] = cb_scope_create(scopes[i - 1], frames);
+    for (i = 1; i < 40; i++)
+    {
+        assert_ptr_equal(scopes[i - 1], cb_scope_get_parent(scopes[i]));
+        assert_int_equal(i, cb_scope_get_depth(scopes[i]));
+    }
+    assert_ptr_equal(scopes[39], cb_scope_frames_get_current(frames));
+    
+    /* the records of destroyed scopes are reused */
+    for (i = 39; i > 0; i--)
+        cb_scope_destroy(scopes[i]);
+    assert_ptr_equal(scopes[1], cb_scope_create(scopes[0], frames));
+    cb_scope_destroy(scopes[1]);
+    cb_scope_destroy(scopes[0]);
+    assert_null(cb_scope_frames_get_current(frames));
+    cb_scope_frames_destroy(frames);
+}
@@ -2,6 +2,7 @@
  * Tests for CbSymbolTable
  ******************************************************************************/
 
+#include "../src/intern.h"
 #include "../src/symbol_variable.h"
 #include "../src/symbol_function.h"
 #include "test.h"
@@ -11,9 +12,9 @@
 
 void symbol_variable_test(void** state)
 {
-    CbSymbol* test1   = (CbSymbol*) cb_symbol_variable_create("test_var1");
-    CbSymbol* test2   = (CbSymbol*) cb_symbol_variable_create("test_var2");
-    CbSymbol* test3   = (CbSymbol*) cb_symbol_variable_create("test_var3");
+    CbSymbol* test1   = (CbSymbol*) cb_symbol_variable_create(cb_intern("test_var1"));
+    CbSymbol* test2   = (CbSymbol*) cb_symbol_variable_create(cb_intern("test_var2"));
+    CbSymbol* test3   = (CbSymbol*) cb_symbol_variable_create(cb_intern("test_var3"));
     CbVariant* value1 = cb_integer_create(123);
     CbVariant* value2 = cb_float_create(123.000321);
     CbVariant* value3 = cb_variant_create();
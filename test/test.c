@@ -7,7 +7,9 @@ int main(int argc, char* argv[])
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(vector_common_test),
         cmocka_unit_test(vector_get_test),
+        cmocka_unit_test(vector_bulk_test),
         cmocka_unit_test(variant_alloc_test),
+        cmocka_unit_test(variant_value_test),
         cmocka_unit_test(variant_types_test),
         cmocka_unit_test(variant_to_string_test),
         cmocka_unit_test_setup_teardown(error_print_test, setup_error_handling, teardown_error_handling),
@@ -17,15 +19,51 @@ int main(int argc, char* argv[])
         cmocka_unit_test_setup_teardown(stack_push_pop_test, setup_stack, teardown_stack),
         cmocka_unit_test_setup_teardown(hash_table_common_test, setup_hash_table, teardown_hash_table),
         cmocka_unit_test_setup_teardown(hashtable_insert_remove_test, setup_hash_table, teardown_hash_table),
+        cmocka_unit_test_setup_teardown(hash_table_replace_test, setup_hash_table, teardown_hash_table),
+        cmocka_unit_test(hash_table_collision_test),
+        cmocka_unit_test(intern_common_test),
         cmocka_unit_test(symbol_table_common_test),
+        cmocka_unit_test(symbol_table_frame_test),
         cmocka_unit_test(ast_alloc_test),
         cmocka_unit_test(ast_eval_test),
         cmocka_unit_test_setup_teardown(ast_eval_error_test, setup_error_handling, teardown_error_handling),
         cmocka_unit_test(ast_check_semantic_test),
         cmocka_unit_test_setup_teardown(ast_check_semantic_error_test, setup_error_handling, teardown_error_handling),
         cmocka_unit_test(symbol_variable_test),
-        cmocka_unit_test_setup_teardown(codeblock_common_test, setup_error_handling, teardown_error_handling)
+        cmocka_unit_test_setup_teardown(codeblock_common_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test_setup_teardown(codeblock_program_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test(codeblock_thread_test),
+        cmocka_unit_test_setup_teardown(codeblock_batch_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test_setup_teardown(codeblock_batch_memory_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test_setup_teardown(codeblock_long_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test_setup_teardown(codeblock_profiler_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test_setup_teardown(vm_common_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test(optimizer_fold_test),
+        cmocka_unit_test_setup_teardown(optimizer_error_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test_setup_teardown(optimizer_specialize_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test_setup_teardown(columnar_common_test, setup_error_handling, teardown_error_handling),
+        cmocka_unit_test_setup_teardown(columnar_program_test, setup_error_handling, teardown_error_handling)
     };
     
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
+
+
+/* -------------------------------------------------------------------------- */
+
+char* execute_with_engine(const char* source, CbCodeblockEngine engine)
+{
+    char* result    = NULL;
+    CbCodeblock* cb = cb_codeblock_create();
+    
+    cb_codeblock_set_engine(cb, engine);
+    assert_int_equal(engine, cb_codeblock_get_engine(cb));
+    assert_true(cb_codeblock_parse_string(cb, source));
+    
+    if (cb_codeblock_execute(cb))
+        result = cb_variant_to_string(cb_codeblock_get_result(cb));
+    
+    cb_codeblock_destroy(cb);
+    
+    return result;
+}
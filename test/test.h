@@ -5,13 +5,16 @@
 #ifndef TEST_H
 #define TEST_H
 
+#include "../src/codeblock.h"
 #include "test_utils.h"
 
 
 void vector_common_test(void** state);
 void vector_get_test(void** state);
+void vector_bulk_test(void** state);
 
 void variant_alloc_test(void** state);
+void variant_value_test(void** state);
 void variant_types_test(void** state);
 void variant_to_string_test(void** state);
 
@@ -31,8 +34,13 @@ int setup_hash_table(void** state);
 int teardown_hash_table(void** state);
 void hash_table_common_test(void** state);
 void hashtable_insert_remove_test(void** state);
+void hash_table_replace_test(void** state);
+void hash_table_collision_test(void** state);
+
+void intern_common_test(void** state);
 
 void symbol_table_common_test(void** state);
+void symbol_table_frame_test(void** state);
 
 void ast_alloc_test(void** state);
 void ast_eval_test(void** state);
@@ -43,6 +51,28 @@ void ast_check_semantic_error_test(void** state);
 void symbol_variable_test(void** state);
 
 void codeblock_common_test(void** state);
+void codeblock_program_test(void** state);
+void codeblock_thread_test(void** state);
+void codeblock_batch_test(void** state);
+void codeblock_batch_memory_test(void** state);
+void codeblock_long_test(void** state);
+void codeblock_profiler_test(void** state);
+
+void vm_common_test(void** state);
+
+void optimizer_fold_test(void** state);
+void optimizer_error_test(void** state);
+void optimizer_specialize_test(void** state);
+
+void columnar_common_test(void** state);
+void columnar_program_test(void** state);
+
+/*
+ * Execute a codeblock with the given engine and return its result as a string.
+ * Returns NULL, if the execution failed.
+ * NOTE: The result must be freed by the caller.
+ */
+char* execute_with_engine(const char* source, CbCodeblockEngine engine);
 
 
 #endif /* TEST_H */
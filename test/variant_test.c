@@ -6,6 +6,7 @@
 
 #include "../src/variant.h"
 #include "../src/utils.h"
+#include "../src/hash_table.h"
 #include "test.h"
 
 
@@ -50,6 +51,98 @@ void variant_alloc_test(void** state)
     cb_variant_destroy(variant);
 }
 
+/*
+ * Test variant values (by value functions)
+ */
+void variant_value_test(void** state)
+{
+    CbVariant value;
+    CbVariant copy;
+    CbVariant* boxed;
+    CbConstStringDataType buffer;
+    
+    value = cb_variant_make();
+    assert_true(cb_variant_is_undefined(&value));
+    
+    value = cb_integer_make(123);
+    assert_cb_integer_equal(123, &value);
+    
+    value = cb_float_make(1.5);
+    assert_cb_float_equal(1.5, &value);
+    
+    value = cb_boolean_make(true);
+    assert_cb_boolean_equal(true, &value);
+    
+    /* long strings share their payload until it is modified */
+    value = cb_string_make(TEST_STRING2);
+    copy  = cb_variant_clone(&value);
+    assert_true(cb_string_get_value(&value) == cb_string_get_value(&copy));
+    assert_true(cb_string_equal(&value, &copy));
+    cb_string_concat(&value, &copy);
+    assert_true(cb_string_get_value(&value) != cb_string_get_value(&copy));
+    assert_string_equal(TEST_STRING2, cb_string_get_value(&copy));
+    assert_int_equal(2 * strlen(TEST_STRING2), cb_string_get_length(&value));
+    
+    cb_variant_release(&value);
+    assert_true(cb_variant_is_undefined(&value));
+    
+    /* short strings are stored inline */
+    value = cb_string_make(TEST_STRING);
+    assert_int_equal(0, cb_string_get_storage_size(strlen(TEST_STRING)));
+    assert_true((const void*) cb_string_get_value(&value) >= (void*) &value &&
+                (const void*) cb_string_get_value(&value) <
+                (void*) (&value + 1));
+    assert_int_equal(cb_hash_table_hash_string(TEST_STRING),
+                     cb_string_get_hash(&value));
+    boxed = cb_variant_box(cb_variant_clone(&value));
+    assert_true(cb_string_equal(&value, boxed));
+    cb_string_concat(&value, boxed);
+    assert_string_equal("test stringtest string", cb_string_get_value(&value));
+    assert_int_equal(cb_hash_table_hash_string("test stringtest string"),
+                     cb_string_get_hash(&value));
+    cb_variant_destroy(boxed);
+    cb_variant_release(&value);
+    
+    /* boxing takes ownership of the payload */
+    boxed = cb_variant_box(copy);
+    assert_string_equal(TEST_STRING2, cb_string_get_value(boxed));
+    
+    /* assignment in place reuses the string buffer */
+    value  = cb_string_make("a");
+    buffer = cb_string_get_value(boxed);
+    cb_variant_assign(boxed, &value);
+    assert_true(buffer == cb_string_get_value(boxed));
+    assert_string_equal("a", cb_string_get_value(boxed));
+    cb_variant_release(&value);
+    
+    value = cb_string_make(TEST_STRING);
+    cb_variant_assign(boxed, &value);
+    assert_true(cb_string_get_value(&value) != cb_string_get_value(boxed));
+    assert_string_equal(TEST_STRING, cb_string_get_value(boxed));
+    
+    /* ... or shares a long string */
+    cb_variant_release(&value);
+    value = cb_string_make(TEST_STRING2);
+    cb_variant_assign(boxed, &value);
+    assert_true(cb_string_get_value(&value) == cb_string_get_value(boxed));
+    
+    /* ... or changes the type */
+    copy = cb_integer_make(7);
+    cb_variant_assign(boxed, &copy);
+    assert_cb_integer_equal(7, boxed);
+    cb_variant_assign(boxed, boxed);
+    assert_cb_integer_equal(7, boxed);
+    
+    /* moving transfers the payload */
+    cb_variant_release(&value);
+    value  = cb_string_make(TEST_STRING2);
+    buffer = cb_string_get_value(&value);
+    cb_variant_move(boxed, &value);
+    assert_true(cb_variant_is_undefined(&value));
+    assert_true(buffer == cb_string_get_value(boxed));
+    cb_variant_destroy(boxed);
+}
+
 /*
  * Test general functionalities
  */
@@ -92,6 +185,25 @@ void variant_types_test(void** state)
     assert_true(cb_variant_is_string(variant2));
     cb_string_concat(variant, variant2);
     assert_string_equal(buffer, cb_string_get_value(variant));
+    
+    /* length and hash are kept up to date */
+    assert_int_equal(strlen(buffer), cb_string_get_length(variant));
+    assert_int_equal(cb_hash_table_hash_string(buffer),
+                     cb_string_get_hash(variant));
+    assert_int_equal(cb_hash_table_hash_string(TEST_STRING2),
+                     cb_string_get_hash(variant2));
+    
+    /* string comparisons */
+    assert_false(cb_string_equal(variant, variant2));
+    assert_true(cb_string_lhs_equal(variant2, variant2));
+    assert_false(cb_string_lhs_equal(variant, variant2));
+    cb_variant_destroy(variant2);
+    variant2 = cb_string_create(buffer);
+    assert_true(cb_string_equal(variant, variant2));
+    assert_true(cb_string_lhs_equal(variant, variant2));
+    cb_string_concat(variant2, variant);
+    assert_false(cb_string_equal(variant, variant2));
+    assert_true(cb_string_lhs_equal(variant, variant2));
     cb_variant_destroy(variant2);
     cb_variant_destroy(variant);
 }
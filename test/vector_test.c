@@ -79,3 +79,52 @@ void vector_get_test(void** state)
     
     vector_destroy(v);
 }
+
+void vector_bulk_test(void** state)
+{
+    Vector* v;
+    VectorItem items[40];
+    VectorItem item;
+    int i;
+    v = vector_create();
+    
+    for (i = 0; i < 40; i++)
+        items[i] = dummy_create(i);
+    
+    /* reserve and extend */
+    assert_true(vector_reserve(v, 30));
+    assert_true(vector_get_capacity(v) >= 30);
+    assert_true(vector_extend(v, items, 20));
+    assert_true(vector_extend(v, items + 20, 20));
+    assert_int_equal(40, vector_get_count(v));
+    for (i = 0; i < 40; i++)
+    {
+        assert_true(vector_get(v, i, &item));
+        assert_int_equal(i, ((TestDummy*) item)->id);
+    }
+    
+    /* swap-remove moves the last item into the gap */
+    assert_ptr_equal(items[5], vector_swap_remove(v, 5));
+    assert_int_equal(39, vector_get_count(v));
+    assert_true(vector_get(v, 5, &item));
+    assert_ptr_equal(items[39], item);
+    assert_null(vector_swap_remove(v, 39));
+    assert_null(vector_remove(v, -1));
+    
+    /* shrink to fit */
+    vector_shrink_to_fit(v);
+    assert_int_equal(39, vector_get_capacity(v));
+    assert_int_equal(39, vector_append(v, NULL));
+    assert_int_equal(78, vector_get_capacity(v));
+    
+    vector_clear(v);
+    assert_int_equal(0, vector_get_count(v));
+    assert_false(vector_get(v, 0, &item));
+    vector_shrink_to_fit(v);
+    assert_int_equal(1, vector_get_capacity(v));
+    
+    for (i = 0; i < 40; i++)
+        dummy_destroy(items[i]);
+    
+    vector_destroy(v);
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Tests for the bytecode compiler and the virtual machine
+ ******************************************************************************/
+
+#include <string.h>
+
+#include "../src/utils.h"
+#include "../src/codeblock.h"
+#include "test.h"
+
+
+/* -------------------------------------------------------------------------- */
+
+void vm_common_test(void** state)
+{
+    const char* const TEST_STRINGS[] = {
+        "333 + 55 * 7 - 99,",
+        "|a, b| a := 3, b := 0, while a > 0 do b := b + a, a := a - 1, end, b,",
+        "|b| b := 6, if b = 6 then 7/2, else 1, endif,",
+        "|b| b := 5, if b = 6 then 7/2, endif,",
+        "|a| a := 1, while a < 10 do a := a * 2, end,",
+        "|a| a := 4, a := a + (a := 1), a,",
+        "|a, b| b := (a := 2) * a, b - -a,",
+        "|s| s := 'ab', s := s + 'c', s = 'a',",
+        "|s| s := 'ab', s := s + 'c', s == 'abc',",
+        "|x| x := 1.5, x * 2 >= 3 and not (x <> 1.5),",
+        "|a| |b| a := 8, b := a / 4, b,",
+        "|a|",
+        /* short-circuit evaluation */
+        "|b| b := 0, b <> 0 and 10 / b > 1,",
+        "|b| b := 0, b = 0 or 10 / b > 1,",
+        "|a| a := 1, a < 0 and (a := 5) > 4, a,",
+        "|a| a := 1, a > 0 and (a := 5) > 4, a,",
+        "|a, b| a := 2, b := False, b or a > 1 and (a := a * 3) > 5, a,",
+        "|a| a := True, False and a,",
+        /* strings appended in place */
+        "|s, i| s := 'a', i := 0, while i < 4 do s := s + s, i := i + 1, end, s,",
+        "|s, t| s := 'ab', t := s, s := s + 'c', t + s,",
+        "|s| s := 'ab', s := s + (s + 'c'), s,",
+        "|s| s := 1, s := s + 2.5, s,",
+        NULL
+    };
+    const char* const FAIL_STRINGS[] = {
+        "|a, b| a := 1, b := 0, a / b,",
+        "|a, b| a := 1, b := 0, a > 0 and a / b > 1,",
+        "|a, b| a := 1, b := True, b and (a + 1),",
+        "|a| a := 1, False and a,",
+        "|s| s := 'x', True or s,",
+        "|s| s := True, s := s + 'x',",
+        NULL
+    };
+    const char* const* source;
+    char* expected;
+    char* actual;
+    
+    for (source = TEST_STRINGS; *source != NULL; source++)
+    {
+        expected = execute_with_engine(*source, CB_CODEBLOCK_ENGINE_AST);
+        actual   = execute_with_engine(*source, CB_CODEBLOCK_ENGINE_VM);
+        
+        assert_non_null(expected);
+        assert_non_null(actual);
+        assert_string_equal(expected, actual);
+        
+        memfree(expected);
+        memfree(actual);
+    }
+    
+    /* runtime errors */
+    for (source = FAIL_STRINGS; *source != NULL; source++)
+    {
+        assert_null(execute_with_engine(*source, CB_CODEBLOCK_ENGINE_AST));
+        assert_null(execute_with_engine(*source, CB_CODEBLOCK_ENGINE_VM));
+    }
+}